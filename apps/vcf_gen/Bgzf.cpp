@@ -0,0 +1,95 @@
+// Bgzf.cpp
+#include "Bgzf.h"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+
+#include <zlib.h>
+
+
+namespace vcf_tool::gen::bgzf {
+
+namespace {
+
+constexpr std::size_t kHeaderSize = 18;
+constexpr std::size_t kFooterSize = 8;
+constexpr std::size_t kMaxBlockSize = 0x10000;
+
+void put_u16(std::string& out, std::size_t pos, std::uint32_t v)
+{
+    out[pos]     = static_cast<char>(v & 0xff);
+    out[pos + 1] = static_cast<char>((v >> 8) & 0xff);
+}
+
+void put_u32(std::string& out, std::size_t pos, std::uint32_t v)
+{
+    put_u16(out, pos, v & 0xffff);
+    put_u16(out, pos + 2, v >> 16);
+}
+
+// Append one BGZF block holding `data` (at most kBlockDataSize bytes)
+void append_block(std::string& out, std::string_view data, int level)
+{
+    static constexpr std::array<unsigned char, kHeaderSize> kHeader = {
+        0x1f, 0x8b, 0x08, 0x04,  // gzip magic, deflate, FEXTRA
+        0, 0, 0, 0,              // MTIME
+        0, 0xff,                 // XFL, OS unknown
+        6, 0,                    // XLEN
+        'B', 'C', 2, 0,          // BGZF subfield, SLEN = 2
+        0, 0                     // BSIZE - 1 (patched below)
+    };
+
+    std::size_t start = out.size();
+    out.append(reinterpret_cast<const char*>(kHeader.data()), kHeader.size());
+    out.resize(start + kMaxBlockSize);
+
+    z_stream zs{};
+    // Raw deflate (negative window bits): the gzip framing is written by hand
+    if (deflateInit2(&zs, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw std::runtime_error("bgzf: deflateInit2 failed");
+    }
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    zs.avail_in = static_cast<uInt>(data.size());
+    zs.next_out = reinterpret_cast<Bytef*>(out.data() + start + kHeaderSize);
+    zs.avail_out = static_cast<uInt>(kMaxBlockSize - kHeaderSize - kFooterSize);
+
+    int rc = deflate(&zs, Z_FINISH);
+    std::size_t compressed = zs.total_out;
+    deflateEnd(&zs);
+    if (rc != Z_STREAM_END) {
+        // Incompressible input larger than a block; callers keep blocks small enough
+        throw std::runtime_error("bgzf: block does not fit in 64 KiB");
+    }
+
+    std::size_t block_size = kHeaderSize + compressed + kFooterSize;
+    out.resize(start + block_size);
+    put_u16(out, start + 16, static_cast<std::uint32_t>(block_size - 1));
+
+    auto crc = crc32(0L, reinterpret_cast<const Bytef*>(data.data()), static_cast<uInt>(data.size()));
+    put_u32(out, start + block_size - 8, static_cast<std::uint32_t>(crc));
+    put_u32(out, start + block_size - 4, static_cast<std::uint32_t>(data.size()));
+}
+
+} // namespace
+
+std::string compress(std::string_view data, int level)
+{
+    std::string out;
+    out.reserve(data.size() / 3 + kMaxBlockSize);
+
+    for (std::size_t pos = 0; pos < data.size(); pos += kBlockDataSize) {
+        append_block(out, data.substr(pos, kBlockDataSize), level);
+    }
+    return out;
+}
+
+std::string_view eof_block()
+{
+    static constexpr char kEof[] =
+        "\x1f\x8b\x08\x04\x00\x00\x00\x00\x00\xff\x06\x00\x42\x43\x02\x00"
+        "\x1b\x00\x03\x00\x00\x00\x00\x00\x00\x00\x00\x00";
+    return {kEof, sizeof(kEof) - 1};
+}
+
+} // namespace vcf_tool::gen::bgzf
@@ -0,0 +1,26 @@
+// Bgzf.h
+#pragma once
+
+#include <string>
+#include <string_view>
+
+
+namespace vcf_tool::gen::bgzf {
+
+/// Max uncompressed bytes per BGZF block (same as htslib)
+inline constexpr std::size_t kBlockDataSize = 0xff00;
+
+/**
+ * Compress `data` into a sequence of BGZF blocks (gzip members with the
+ * "BC" extra field, each at most 64 KiB compressed). Concatenated outputs
+ * of independent calls form a valid BGZF stream, which is what makes
+ * parallel compression possible.
+ *
+ * @throws std::runtime_error on zlib failure
+ */
+std::string compress(std::string_view data, int level = 6);
+
+/// The 28-byte empty block that terminates every BGZF file
+std::string_view eof_block();
+
+} // namespace vcf_tool::gen::bgzf
@@ -0,0 +1,352 @@
+// VcfGenerator.cpp
+#include "VcfGenerator.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+
+namespace vcf_tool::gen {
+
+namespace {
+
+constexpr std::array<char, 4> kBases = {'A', 'C', 'G', 'T'};
+constexpr std::array<std::string_view, VcfGenerator::kMaxFormatFields> kFormatKeys = {
+    "GT", "DP", "GQ", "AD", "PL"
+};
+constexpr std::size_t kFixedInfoFields = 4;  // DP, AF, AC, AN
+
+constexpr std::uint64_t mix(std::uint64_t x)
+{
+    // splitmix64 finalizer
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/// Small, fast RNG (splitmix64 stream); quality is plenty for test data
+class Rng {
+public:
+    explicit Rng(std::uint64_t seed) : state_(seed) {}
+
+    std::uint64_t next() { return mix(state_++); }
+
+    /// Uniform in [0, n)
+    std::uint64_t uniform(std::uint64_t n) { return n == 0 ? 0 : next() % n; }
+
+    /// Uniform in [0, 1)
+    double real() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+    bool chance(double p) { return real() < p; }
+
+    /// Standard normal (Box-Muller)
+    double normal() {
+        double u1 = std::max(real(), 1e-300);
+        double u2 = real();
+        return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+    }
+
+private:
+    std::uint64_t state_;
+};
+
+void append_uint(std::string& out, std::uint64_t v)
+{
+    std::array<char, 24> buf{};
+    auto [end, ec] = std::to_chars(buf.data(), buf.data() + buf.size(), v);
+    out.append(buf.data(), end);
+}
+
+void append_fixed(std::string& out, double v, int precision)
+{
+    std::array<char, 48> buf{};
+    auto [end, ec] = std::to_chars(buf.data(), buf.data() + buf.size(), v,
+                                   std::chars_format::fixed, precision);
+    out.append(buf.data(), end);
+}
+
+// Genotype allele: mostly reference, otherwise a random ALT
+std::uint64_t pick_allele(Rng& rng, std::uint64_t alts)
+{
+    return rng.chance(0.6) ? 0 : 1 + rng.uniform(alts);
+}
+
+} // namespace
+
+VcfGenerator::VcfGenerator(GeneratorConfig config)
+    : config_(config)
+{
+    if (config_.contigs == 0) {
+        throw std::invalid_argument("vcf_gen: contigs must be > 0");
+    }
+    if (config_.format_fields > kMaxFormatFields) {
+        throw std::invalid_argument("vcf_gen: at most 5 FORMAT fields (GT:DP:GQ:AD:PL)");
+    }
+    if (config_.multiallelic_fraction < 0.0 || config_.multiallelic_fraction > 1.0) {
+        throw std::invalid_argument("vcf_gen: multiallelic fraction must be in [0, 1]");
+    }
+    if (config_.mean_position_step == 0) {
+        throw std::invalid_argument("vcf_gen: position step must be > 0");
+    }
+}
+
+std::uint64_t VcfGenerator::shards_per_contig() const
+{
+    return (config_.records_per_contig + kShardRecords - 1) / kShardRecords;
+}
+
+std::string VcfGenerator::header() const
+{
+    std::string out;
+    out += "##fileformat=VCFv4.2\n";
+    out += "##source=vcf_gen (seed=" + std::to_string(config_.seed) + ")\n";
+
+    std::uint64_t contig_length = (config_.records_per_contig + 1) * config_.mean_position_step;
+    for (std::size_t c = 1; c <= config_.contigs; ++c) {
+        out += "##contig=<ID=chr" + std::to_string(c) + ",length=" + std::to_string(contig_length) + ">\n";
+    }
+
+    out += "##FILTER=<ID=LowQual,Description=\"Low quality\">\n";
+    static constexpr std::array<std::string_view, kFixedInfoFields> kInfoHeaders = {
+        "##INFO=<ID=DP,Number=1,Type=Integer,Description=\"Total Depth\">\n",
+        "##INFO=<ID=AF,Number=A,Type=Float,Description=\"Allele Frequency\">\n",
+        "##INFO=<ID=AC,Number=A,Type=Integer,Description=\"Allele Count\">\n",
+        "##INFO=<ID=AN,Number=1,Type=Integer,Description=\"Total Number of Alleles\">\n",
+    };
+    for (std::size_t i = 0; i < std::min(config_.info_fields, kFixedInfoFields); ++i) {
+        out += kInfoHeaders[i];
+    }
+    for (std::size_t i = kFixedInfoFields; i < config_.info_fields; ++i) {
+        out += "##INFO=<ID=X" + std::to_string(i - kFixedInfoFields + 1)
+             + ",Number=1,Type=Integer,Description=\"Synthetic field\">\n";
+    }
+    if (config_.annotation_bytes > 0) {
+        out += "##INFO=<ID=ANN,Number=.,Type=String,Description=\"Synthetic annotation\">\n";
+    }
+
+    static constexpr std::array<std::string_view, kMaxFormatFields> kFormatHeaders = {
+        "##FORMAT=<ID=GT,Number=1,Type=String,Description=\"Genotype\">\n",
+        "##FORMAT=<ID=DP,Number=1,Type=Integer,Description=\"Read Depth\">\n",
+        "##FORMAT=<ID=GQ,Number=1,Type=Integer,Description=\"Genotype Quality\">\n",
+        "##FORMAT=<ID=AD,Number=R,Type=Integer,Description=\"Allelic Depths\">\n",
+        "##FORMAT=<ID=PL,Number=G,Type=Integer,Description=\"Phred-scaled Likelihoods\">\n",
+    };
+    bool has_samples = config_.samples > 0 && config_.format_fields > 0;
+    if (has_samples) {
+        for (std::size_t i = 0; i < config_.format_fields; ++i) {
+            out += kFormatHeaders[i];
+        }
+    }
+
+    out += "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO";
+    if (has_samples) {
+        out += "\tFORMAT";
+        for (std::size_t s = 1; s <= config_.samples; ++s) {
+            out += "\tSAMPLE" + std::to_string(s);
+        }
+    }
+    out += '\n';
+    return out;
+}
+
+std::string VcfGenerator::generate_shard(std::uint64_t index) const
+{
+    const std::uint64_t contig = index / shards_per_contig() + 1;
+    const std::uint64_t first = (index % shards_per_contig()) * kShardRecords;
+    const std::uint64_t count = std::min(kShardRecords, config_.records_per_contig - first);
+    const std::uint64_t step = config_.mean_position_step;
+    const bool has_samples = config_.samples > 0 && config_.format_fields > 0;
+
+    Rng rng(mix(config_.seed ^ mix(contig ^ mix(first))));
+
+    const std::string chrom = "chr" + std::to_string(contig);
+    std::string out;
+    out.reserve(count * (64 + config_.annotation_bytes + config_.samples * 4 * config_.format_fields));
+
+    std::string ref;
+    std::string alt;
+
+    for (std::uint64_t i = 0; i < count; ++i) {
+        const std::uint64_t record = first + i;
+
+        // Strictly increasing: consecutive positions differ by at least 1
+        const std::uint64_t pos = 1 + record * step + rng.uniform(step);
+
+        const std::uint64_t alts = rng.chance(config_.multiallelic_fraction) ? 2 + rng.uniform(2) : 1;
+        const bool indel = rng.chance(0.1);
+
+        // REF: one base, or a short deletion
+        const std::uint64_t ref_base = rng.uniform(4);
+        ref.assign(1, kBases[ref_base]);
+        if (indel) {
+            for (std::uint64_t k = 0, n = 1 + rng.uniform(4); k < n; ++k) {
+                ref += kBases[rng.uniform(4)];
+            }
+        }
+
+        // ALT: distinct SNV bases (or insertions when indel)
+        alt.clear();
+        for (std::uint64_t a = 0; a < alts; ++a) {
+            if (a > 0) {
+                alt += ',';
+            }
+            if (indel) {
+                alt += ref[0];
+                for (std::uint64_t k = 0; k <= a; ++k) {
+                    alt += kBases[rng.uniform(4)];
+                }
+            } else {
+                alt += kBases[(ref_base + 1 + a) % 4];
+            }
+        }
+
+        // CHROM POS ID REF ALT QUAL FILTER
+        out += chrom;
+        out += '\t';
+        append_uint(out, pos);
+        out += '\t';
+        if (rng.chance(0.5)) {
+            out += "rs";
+            append_uint(out, contig * 1'000'000'000ULL + record);
+        } else {
+            out += '.';
+        }
+        out += '\t';
+        out += ref;
+        out += '\t';
+        out += alt;
+        out += '\t';
+        if (rng.chance(0.02)) {
+            out += '.';
+        } else {
+            append_fixed(out, rng.real() * 5000.0, 2);
+        }
+        out += '\t';
+        out += rng.chance(0.95) ? "PASS" : "LowQual";
+        out += '\t';
+
+        // INFO
+        std::size_t written = 0;
+        auto sep = [&] {
+            if (written++ > 0) {
+                out += ';';
+            }
+        };
+        const std::size_t fixed = std::min(config_.info_fields, kFixedInfoFields);
+        if (fixed > 0) {
+            sep();
+            out += "DP=";
+            append_uint(out, 10 + rng.uniform(990));
+        }
+        if (fixed > 1) {
+            sep();
+            out += "AF=";
+            for (std::uint64_t a = 0; a < alts; ++a) {
+                if (a > 0) {
+                    out += ',';
+                }
+                append_fixed(out, rng.real(), 3);
+            }
+        }
+        if (fixed > 2) {
+            sep();
+            out += "AC=";
+            for (std::uint64_t a = 0; a < alts; ++a) {
+                if (a > 0) {
+                    out += ',';
+                }
+                append_uint(out, rng.uniform(2 * std::max<std::size_t>(config_.samples, 1) + 1));
+            }
+        }
+        if (fixed > 3) {
+            sep();
+            out += "AN=";
+            append_uint(out, 2 * std::max<std::size_t>(config_.samples, 1));
+        }
+        for (std::size_t k = kFixedInfoFields; k < config_.info_fields; ++k) {
+            sep();
+            out += 'X';
+            append_uint(out, k - kFixedInfoFields + 1);
+            out += '=';
+            append_uint(out, rng.uniform(100'000));
+        }
+        if (config_.annotation_bytes > 0) {
+            double length = static_cast<double>(config_.annotation_bytes);
+            if (config_.annotation_spread > 0.0) {
+                // Lognormal with the configured mean
+                double sigma = config_.annotation_spread;
+                length *= std::exp(sigma * rng.normal() - 0.5 * sigma * sigma);
+            }
+            sep();
+            out += "ANN=";
+            auto n = static_cast<std::size_t>(std::max(1.0, std::round(length)));
+            for (std::size_t k = 0; k < n; ++k) {
+                // Mostly letters with '|' separators like real annotations
+                std::uint64_t r = rng.uniform(32);
+                out += r < 26 ? static_cast<char>('a' + r) : '|';
+            }
+        }
+        if (written == 0) {
+            out += '.';
+        }
+
+        // FORMAT + samples
+        if (has_samples) {
+            out += '\t';
+            for (std::size_t f = 0; f < config_.format_fields; ++f) {
+                if (f > 0) {
+                    out += ':';
+                }
+                out += kFormatKeys[f];
+            }
+
+            const std::uint64_t genotypes = (alts + 1) * (alts + 2) / 2;
+            for (std::size_t s = 0; s < config_.samples; ++s) {
+                out += '\t';
+                for (std::size_t f = 0; f < config_.format_fields; ++f) {
+                    if (f > 0) {
+                        out += ':';
+                    }
+                    switch (f) {
+                        case 0:
+                            append_uint(out, pick_allele(rng, alts));
+                            out += '/';
+                            append_uint(out, pick_allele(rng, alts));
+                            break;
+                        case 1:
+                        case 2:
+                            append_uint(out, rng.uniform(100));
+                            break;
+                        case 3:
+                            for (std::uint64_t a = 0; a <= alts; ++a) {
+                                if (a > 0) {
+                                    out += ',';
+                                }
+                                append_uint(out, rng.uniform(60));
+                            }
+                            break;
+                        default:
+                            for (std::uint64_t g = 0; g < genotypes; ++g) {
+                                if (g > 0) {
+                                    out += ',';
+                                }
+                                append_uint(out, g == 0 ? 0 : rng.uniform(3000));
+                            }
+                            break;
+                    }
+                }
+            }
+        }
+
+        out += '\n';
+    }
+
+    return out;
+}
+
+} // namespace vcf_tool::gen
@@ -0,0 +1,63 @@
+// VcfGenerator.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+namespace vcf_tool::gen {
+
+/**
+ * @brief Shape of the synthetic VCF to generate
+ */
+struct GeneratorConfig {
+    std::uint64_t seed{42};
+    std::size_t   contigs{1};
+    std::uint64_t records_per_contig{1000};
+    std::size_t   samples{1};
+    std::size_t   info_fields{4};           // INFO keys per record (DP, AF, AC, AN, then X1..Xn)
+    std::size_t   format_fields{3};         // FORMAT keys per sample, prefix of GT:DP:GQ:AD:PL (0 = sites-only)
+    double        multiallelic_fraction{0.05};
+    std::size_t   annotation_bytes{0};      // Mean length of the ANN INFO string (0 = none)
+    double        annotation_spread{0.0};   // Lognormal sigma of the ANN length (0 = fixed)
+    std::uint64_t mean_position_step{100};  // Mean distance between consecutive POS
+};
+
+/**
+ * @brief Deterministic synthetic VCF generator
+ *
+ * The output is split into shards of kShardRecords records. Each shard is
+ * generated from its own RNG stream seeded by (seed, contig, shard index),
+ * so shards can be generated in parallel and in any order while the
+ * concatenated output stays byte-identical for a given configuration.
+ * Positions within a contig are strictly increasing (sorted output).
+ */
+class VcfGenerator {
+public:
+    static constexpr std::uint64_t kShardRecords = 16'384;
+
+    /// Maximum value of GeneratorConfig::format_fields
+    static constexpr std::size_t kMaxFormatFields = 5;
+
+    explicit VcfGenerator(GeneratorConfig config);
+
+    /// Meta-information lines and the #CHROM header line
+    std::string header() const;
+
+    /// Number of shards per contig
+    std::uint64_t shards_per_contig() const;
+
+    /// Total number of shards (contig-major order)
+    std::uint64_t shard_count() const { return shards_per_contig() * config_.contigs; }
+
+    /// Generate the data lines of shard `index` (contig-major order)
+    std::string generate_shard(std::uint64_t index) const;
+
+    const GeneratorConfig& config() const { return config_; }
+
+private:
+    GeneratorConfig config_;
+};
+
+} // namespace vcf_tool::gen
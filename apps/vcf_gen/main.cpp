@@ -0,0 +1,156 @@
+// vcf_gen - deterministic synthetic VCF generator for scale and soak tests
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <CLI/CLI.hpp>
+#include <vcf_tool/core/ThreadPool.h>
+#include <vcf_tool/utils/Logger.h>
+
+#include "Bgzf.h"
+#include "VcfGenerator.h"
+
+using vcf_tool::utils::Logger;
+using vcf_tool::gen::GeneratorConfig;
+using vcf_tool::gen::VcfGenerator;
+
+int main(int argc, char** argv) {
+    CLI::App app{"vcf_gen - Deterministic synthetic VCF generator"};
+
+    GeneratorConfig config;
+    std::string out_path;
+    int threads = 0;
+    bool bgzip = false;
+    int compression_level = 6;
+
+    app.add_option("-o,--out", out_path, "Output file")
+       ->required();
+    app.add_option("--seed", config.seed, "Random seed (same seed + options => identical output)")
+       ->capture_default_str();
+    app.add_option("--contigs", config.contigs, "Number of contigs (chr1..chrN)")
+       ->check(CLI::PositiveNumber)
+       ->capture_default_str();
+    app.add_option("--records-per-contig", config.records_per_contig, "Data lines per contig")
+       ->capture_default_str();
+    app.add_option("--samples", config.samples, "Sample columns (0 = sites-only)")
+       ->capture_default_str();
+    app.add_option("--info-fields", config.info_fields,
+                   "INFO keys per record: DP, AF, AC, AN, then X1..Xn")
+       ->capture_default_str();
+    app.add_option("--format-fields", config.format_fields,
+                   "FORMAT keys per sample, prefix of GT:DP:GQ:AD:PL (0 = sites-only)")
+       ->check(CLI::Range(0, static_cast<int>(VcfGenerator::kMaxFormatFields)))
+       ->capture_default_str();
+    app.add_option("--multiallelic-fraction", config.multiallelic_fraction,
+                   "Fraction of records with 2-3 ALT alleles")
+       ->check(CLI::Range(0.0, 1.0))
+       ->capture_default_str();
+    app.add_option("--annotation-bytes", config.annotation_bytes,
+                   "Mean length of a synthetic ANN INFO string (controls line length; 0 = none)")
+       ->capture_default_str();
+    app.add_option("--annotation-spread", config.annotation_spread,
+                   "Lognormal sigma of the ANN length (0 = every line the same length)")
+       ->check(CLI::NonNegativeNumber)
+       ->capture_default_str();
+    app.add_option("--position-step", config.mean_position_step, "Mean distance between positions")
+       ->check(CLI::PositiveNumber)
+       ->capture_default_str();
+    app.add_option("--threads", threads, "Generator threads (default: all cores)")
+       ->check(CLI::NonNegativeNumber);
+    app.add_flag("--bgzip", bgzip, "Write BGZF-compressed output (bgzip / tabix compatible)");
+    app.add_option("--compression-level", compression_level, "BGZF deflate level")
+       ->check(CLI::Range(1, 9))
+       ->capture_default_str();
+
+    try {
+        app.parse(argc, argv);
+    } catch (const CLI::ParseError& e) {
+        std::cerr << "CLI parsing error: " << e.what() << std::endl;
+        return app.exit(e);
+    }
+
+    if (threads <= 0) {
+        unsigned int hw = std::thread::hardware_concurrency();
+        threads = hw == 0 ? 4 : static_cast<int>(hw);
+    }
+
+    Logger::initialize("", Logger::Level::Info);
+
+    try {
+        VcfGenerator generator(config);
+
+        std::ofstream out(out_path, std::ios::binary);
+        if (!out.is_open()) {
+            LOG_ERROR_F("Cannot open output file '{}'", out_path);
+            return 1;
+        }
+
+        auto started = std::chrono::steady_clock::now();
+        std::uint64_t bytes = 0;
+
+        auto header = generator.header();
+        bytes += header.size();
+        out << (bgzip ? vcf_tool::gen::bgzf::compress(header, compression_level) : header);
+
+        // Shards are generated (and compressed) in parallel and written in order.
+        // A bounded window of in-flight shards caps memory use.
+        vcf_tool::core::ThreadPool pool(static_cast<std::size_t>(threads));
+        const std::uint64_t shards = generator.shard_count();
+        const std::uint64_t window = static_cast<std::uint64_t>(threads) * 2;
+
+        std::deque<std::future<std::pair<std::string, std::size_t>>> in_flight;
+        std::uint64_t next = 0;
+
+        auto submit = [&] {
+            in_flight.push_back(pool.submit([&generator, bgzip, compression_level, index = next]() {
+                auto text = generator.generate_shard(index);
+                std::size_t raw_size = text.size();
+                if (bgzip) {
+                    text = vcf_tool::gen::bgzf::compress(text, compression_level);
+                }
+                return std::make_pair(std::move(text), raw_size);
+            }));
+            ++next;
+        };
+
+        while (next < shards && next < window) {
+            submit();
+        }
+        while (!in_flight.empty()) {
+            auto [data, raw_size] = in_flight.front().get();
+            in_flight.pop_front();
+            if (next < shards) {
+                submit();
+            }
+            out.write(data.data(), static_cast<std::streamsize>(data.size()));
+            bytes += raw_size;
+        }
+
+        if (bgzip) {
+            auto eof = vcf_tool::gen::bgzf::eof_block();
+            out.write(eof.data(), static_cast<std::streamsize>(eof.size()));
+        }
+
+        out.close();
+        if (!out) {
+            LOG_ERROR_F("Failed writing '{}'", out_path);
+            return 1;
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        double mb = static_cast<double>(bytes) / (1024.0 * 1024.0);
+        LOG_INFO_F("Wrote {} records ({:.1f} MB uncompressed) to '{}' in {:.2f}s ({:.1f} MB/s, {} threads)",
+                   config.records_per_contig * config.contigs, mb, out_path, seconds,
+                   seconds > 0 ? mb / seconds : 0.0, threads);
+        return 0;
+
+    } catch (const std::exception& e) {
+        LOG_ERROR_F("vcf_gen failed: {}", e.what());
+        return 1;
+    }
+}
@@ -4,14 +4,17 @@
 #include <filesystem>
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 
 #include <CLI/CLI.hpp>
 #include <vcf_tool/utils/Logger.h>
 #include <vcf_tool/utils/Errors.h>
 #include <vcf_tool/core/MongoDatabase.h>
 #include <vcf_tool/core/MongoConfig.h>
+#include <vcf_tool/core/Config.h>
 #include <vcf_tool/domain/VcfTool.h>
 #include <vcf_tool/domain/VcfToolBuilder.h>
+#include <vcf_tool/domain/Calibrator.h>
 
 namespace fs = std::filesystem;
 using vcf_tool::utils::Logger;
@@ -34,16 +37,183 @@ Logger::Level parse_log_level(const std::string& level_str) {
     return Logger::Level::Info;
 }
 
+// Import options collected from the command line
+struct ImportOptions {
+    int threads = 0;                  // 0 => profile value, or all cores
+    std::string profile;              // JSON profile from --calibrate (empty => defaults)
+    bool checkpoint = false;
+    std::string checkpoint_file;      // empty => "<vcf>.checkpoint"
+    int checkpoint_interval_sec = 5;
+    bool resume = false;
+    std::string metrics_file;         // empty => no Prometheus export
+    int metrics_interval_sec = 5;
+    std::string metrics_summary;      // empty => no JSON summary
+    int progress_interval_sec = 10;   // 0 => no progress lines
+    std::string trace_out;            // empty => no trace
+    std::string sink = "mongo";       // mongo | null | fake
+    int fake_latency_ms = 0;
+    int fake_jitter_ms = 0;
+    double fake_failure_rate = 0.0;
+    int write_retries = 3;
+    bool adaptive_parsers = false;
+    int min_parsers = 1;
+    std::string affinity = "none";    // none | compact | scatter | explicit
+    std::string cpus;                 // CPU list for explicit affinity
+    int wide_line_kb = 1024;          // 0 => never split wide lines
+    std::string samples;              // empty => all samples
+    std::string info_fields;          // empty => all INFO keys
+    std::string format_fields;        // empty => all FORMAT keys
+    std::string filter;               // empty => keep every record
+    int max_errors = 0;               // 0 => the first malformed line fails the import
+    std::string reject_file;          // empty => "<vcf>.rejects"
+    bool split_multiallelic = false;
+    std::string dedup = "off";        // off | unsorted | sorted
+    bool calibrate = false;
+    std::string calibrate_out;        // empty => "<vcf>.profile.json"
+    int calibrate_trials = 30;
+    int calibrate_sample = 200000;
+};
+
+vcf_tool::domain::api::SinkType sink_type(const std::string& sink) {
+    using vcf_tool::domain::api::SinkType;
+    if (sink == "null") return SinkType::Null;
+    if (sink == "fake") return SinkType::Fake;
+    return SinkType::Mongo;
+}
+
+vcf_tool::domain::api::AffinityPolicy affinity_policy(const ImportOptions& options) {
+    using vcf_tool::domain::api::AffinityPolicy;
+    if (!options.cpus.empty() || options.affinity == "explicit") return AffinityPolicy::Explicit;
+    if (options.affinity == "compact") return AffinityPolicy::Compact;
+    if (options.affinity == "scatter") return AffinityPolicy::Scatter;
+    return AffinityPolicy::None;
+}
+
+vcf_tool::domain::api::DedupMode dedup_mode(const std::string& dedup) {
+    using vcf_tool::domain::api::DedupMode;
+    if (dedup == "unsorted") return DedupMode::Unsorted;
+    if (dedup == "sorted") return DedupMode::Sorted;
+    return DedupMode::Off;
+}
+
+vcf_tool::domain::api::FakeSinkOptions fake_sink_options(const ImportOptions& options) {
+    vcf_tool::domain::api::FakeSinkOptions fake;
+    fake.latency = std::chrono::milliseconds(options.fake_latency_ms);
+    fake.latency_jitter = std::chrono::milliseconds(options.fake_jitter_ms);
+    fake.failure_rate = options.fake_failure_rate;
+    return fake;
+}
+
+// What the parsers and writer do per record: shared by imports and calibration trials
+void apply_workload(vcf_tool::domain::api::VcfToolBuilder& builder, const ImportOptions& options) {
+    builder.with_write_retries(static_cast<std::size_t>(options.write_retries));
+    if (options.adaptive_parsers) {
+        builder.with_adaptive_parsers(static_cast<std::size_t>(options.min_parsers));
+    }
+    builder.with_affinity(affinity_policy(options), options.cpus);
+    builder.with_wide_line_split(static_cast<std::size_t>(options.wide_line_kb) * 1024);
+    if (!options.samples.empty()) {
+        builder.with_samples(options.samples);
+    }
+    if (!options.info_fields.empty()) {
+        builder.with_info_fields(options.info_fields);
+    }
+    if (!options.format_fields.empty()) {
+        builder.with_format_fields(options.format_fields);
+    }
+    if (!options.filter.empty()) {
+        builder.with_filter(options.filter);
+    }
+    if (options.max_errors > 0) {
+        builder.with_max_errors(static_cast<std::size_t>(options.max_errors), options.reject_file);
+    }
+    if (options.split_multiallelic) {
+        builder.with_multiallelic_split();
+    }
+    if (options.dedup != "off") {
+        builder.with_dedup(dedup_mode(options.dedup));
+    }
+}
+
+// Calibration: time short trial imports and write the best profile
+int run_calibration(const std::string& vcf_path, const ImportOptions& options) {
+    const std::string out = options.calibrate_out.empty()
+        ? vcf_path + ".profile.json"
+        : options.calibrate_out;
+    LOG_INFO_F("Calibrating pipeline profile on '{}' against the {} sink", vcf_path, options.sink);
+
+    try {
+        vcf_tool::domain::api::CalibrationOptions calibration;
+        calibration.sample_records = static_cast<std::size_t>(options.calibrate_sample);
+        calibration.max_trials = static_cast<std::size_t>(options.calibrate_trials);
+        calibration.sink = sink_type(options.sink);
+        calibration.fake_sink = fake_sink_options(options);
+
+        // Trials run the configured workload; their rejects go next to the sample
+        ImportOptions workload = options;
+        workload.reject_file.clear();
+        apply_workload(calibration.workload, workload);
+
+        vcf_tool::domain::api::Calibrator calibrator(calibration);
+        auto result = calibrator.run(vcf_path);
+        result.save_profile(out);
+
+        LOG_INFO_F("Profile written to '{}' (use it with --profile {})", out, out);
+        return 0;
+
+    } catch (const vcf_tool::utils::errors::BaseError& e) {
+        vcf_tool::utils::errors::log_error(e);
+        return vcf_tool::utils::errors::to_exit_code(e);
+    } catch (const std::exception& e) {
+        LOG_ERROR_F("Unexpected error: {}", e.what());
+        return 1;
+    }
+}
+
 // VCF import using the new VcfTool API
-int run_vcf_import(const std::string& vcf_path, int num_threads) {
-    LOG_INFO_F("Running VCF import for file '{}' using {} threads", vcf_path, num_threads);
+int run_vcf_import(const std::string& vcf_path, const ImportOptions& options) {
+    LOG_INFO_F("Running VCF import for file '{}'", vcf_path);
 
     try {
-        // Build VcfTool with user-specified thread count
-        auto tool = vcf_tool::domain::api::VcfToolBuilder()
-            .with_parser_threads(static_cast<std::size_t>(num_threads))
-            .with_batch_size(2)
-            .build();
+        // Sizing comes from the profile (if any); --threads overrides it
+        vcf_tool::domain::api::VcfToolBuilder builder;
+        if (!options.profile.empty()) {
+            vcf_tool::core::Config profile;
+            profile.load_from_file(options.profile);
+            builder = vcf_tool::domain::api::VcfToolBuilder::from_config(profile);
+            LOG_INFO_F("Using pipeline profile '{}'", options.profile);
+        }
+        if (options.threads > 0) {
+            builder.with_parser_threads(static_cast<std::size_t>(options.threads));
+        }
+
+        if (options.checkpoint || options.resume) {
+            builder.with_checkpoint(options.checkpoint_file)
+                   .with_checkpoint_interval(std::chrono::seconds(options.checkpoint_interval_sec))
+                   .with_resume(options.resume);
+        }
+
+        if (!options.metrics_file.empty()) {
+            builder.with_metrics_file(options.metrics_file)
+                   .with_metrics_interval(std::chrono::seconds(options.metrics_interval_sec));
+        }
+        if (!options.metrics_summary.empty()) {
+            builder.with_metrics_summary(options.metrics_summary);
+        }
+
+        builder.with_progress_interval(std::chrono::seconds(options.progress_interval_sec));
+        if (!options.trace_out.empty()) {
+            builder.with_trace_output(options.trace_out);
+        }
+
+        if (options.sink == "null") {
+            builder.with_dry_run();
+        } else if (options.sink == "fake") {
+            builder.with_fake_sink(fake_sink_options(options));
+        }
+        apply_workload(builder, options);
+
+        auto tool = builder.build();
 
         // Run the import pipeline
         tool.run(vcf_path);
@@ -66,11 +236,13 @@ int main(int argc, char** argv) {
     CLI::App app{"vcf_importer - Multi-threaded VCF import CLI"};
 
     std::string vcf_path;
-    int threads = 0;
+    ImportOptions options;
+    int& threads = options.threads;
 
     // Logging-related options
     std::string log_level_str = "info";
     std::string log_file_path;  // empty => console only
+    bool log_async = false;
 
     // Required VCF argument
     app.add_option("--vcf", vcf_path, "Path to the input VCF file")
@@ -79,9 +251,134 @@ int main(int argc, char** argv) {
 
     // Optional threads argument
     app.add_option("--threads", threads,
-                   "Number of threads to use for reading/parsing")
+                   "Number of threads to use for reading/parsing (overrides --profile)")
        ->check(CLI::PositiveNumber);
 
+    app.add_flag("--adaptive-parsers", options.adaptive_parsers,
+                 "Grow / shrink the active parsers at runtime (up to --threads) from queue depths "
+                 "and stage utilization; parked parsers' cores encode batches for the writer");
+    app.add_option("--min-parsers", options.min_parsers,
+                   "Lower bound for --adaptive-parsers")
+       ->check(CLI::PositiveNumber)
+       ->capture_default_str();
+
+    app.add_option("--affinity", options.affinity,
+                   "Pin reader, writer and parser threads: compact (fill one NUMA node, physical "
+                   "cores first, then the next), scatter (round-robin over nodes), explicit (--cpus)")
+       ->check(CLI::IsMember({"none", "compact", "scatter", "explicit"}))
+       ->capture_default_str();
+    app.add_option("--cpus", options.cpus,
+                   "CPU list for explicit affinity, e.g. 0-3,8 (reader, writer, then parsers; "
+                   "implies --affinity explicit)");
+
+    app.add_option("--wide-line-kb", options.wide_line_kb,
+                   "Parse the sample columns of lines longer than this (KiB) in concurrent ranges "
+                   "(large cohorts); 0 disables")
+       ->check(CLI::NonNegativeNumber)
+       ->capture_default_str();
+    app.add_option("--samples", options.samples,
+                   "Keep only these samples: comma-separated #CHROM names or a file with one "
+                   "name per line; prefix with ^ to keep all but these");
+    app.add_option("--info-fields", options.info_fields,
+                   "Keep only these INFO keys, e.g. AF,DP; prefix with ^ to drop them instead (^CSQ)");
+    app.add_option("--format-fields", options.format_fields,
+                   "Keep only these FORMAT keys, e.g. GT,DP; prefix with ^ to drop them instead");
+    app.add_option("--filter", options.filter,
+                   "Keep only records matching an expression over CHROM, POS, REF, ALT, QUAL, FILTER "
+                   "and INFO.<key>, e.g. 'FILTER==\"PASS\" && QUAL>=30 && CHROM in (chr1,chr2)'; with "
+                   "--split-multiallelic it tests each biallelic record (its ALT, AF, ...)");
+    app.add_option("--max-errors", options.max_errors,
+                   "Skip up to N malformed lines instead of failing on the first; they are written "
+                   "with line number and reason to the reject file")
+       ->check(CLI::NonNegativeNumber)
+       ->capture_default_str();
+    app.add_option("--reject-file", options.reject_file,
+                   "Reject file for --max-errors (default: <vcf>.rejects)");
+    app.add_flag("--split-multiallelic", options.split_multiallelic,
+                 "Write one record per ALT allele: Number=A/R/G values subset, GT recoded, "
+                 "REF/ALT trimmed");
+    app.add_option("--dedup", options.dedup,
+                   "Drop records repeating an earlier CHROM/POS/REF/ALT: unsorted (any order, keeps "
+                   "every key) or sorted (input sorted by chromosome, keeps only the current ones); "
+                   "not with --resume")
+       ->check(CLI::IsMember({"off", "unsorted", "sorted"}))
+       ->capture_default_str();
+
+    // Pipeline profile / calibration
+    app.add_option("--profile", options.profile,
+                   "Load parser threads, batch size and queue capacities from a JSON profile")
+       ->check(CLI::ExistingFile);
+    app.add_flag("--calibrate", options.calibrate,
+                 "Run short trial imports on a sample of the input against the selected sink "
+                 "(mongo trials use a scratch '<collection>_calibration' collection, dropped after each), "
+                 "with the given filter, samples, fields, split, dedup and affinity, "
+                 "search for the fastest profile and write it to --calibrate-out (no import)");
+    app.add_option("--calibrate-out", options.calibrate_out,
+                   "Profile written by --calibrate (default: <vcf>.profile.json)");
+    app.add_option("--calibrate-trials", options.calibrate_trials,
+                   "Maximum number of timed trial imports")
+       ->check(CLI::PositiveNumber)
+       ->capture_default_str();
+    app.add_option("--calibrate-sample", options.calibrate_sample,
+                   "Data lines of the input used for each trial")
+       ->check(CLI::PositiveNumber)
+       ->capture_default_str();
+
+    // Checkpoint / resume options
+    app.add_flag("--checkpoint", options.checkpoint,
+                 "Periodically save the committed input position so the import can be resumed");
+    app.add_option("--checkpoint-file", options.checkpoint_file,
+                   "Checkpoint file path (default: <vcf>.checkpoint)");
+    app.add_option("--checkpoint-interval", options.checkpoint_interval_sec,
+                   "Seconds between checkpoint writes")
+       ->check(CLI::NonNegativeNumber)
+       ->capture_default_str();
+    app.add_flag("--resume", options.resume,
+                 "Resume from the checkpoint file, skipping already-imported lines (implies --checkpoint)");
+
+    // Metrics options
+    app.add_option("--metrics-file", options.metrics_file,
+                   "Periodically write pipeline metrics to this file (Prometheus text format)");
+    app.add_option("--metrics-interval", options.metrics_interval_sec,
+                   "Seconds between metrics file writes")
+       ->check(CLI::PositiveNumber)
+       ->capture_default_str();
+    app.add_option("--metrics-summary", options.metrics_summary,
+                   "Write a JSON summary of all pipeline metrics when the import finishes");
+
+    app.add_option("--progress-interval", options.progress_interval_sec,
+                   "Seconds between progress lines (throughput, queue fill, ETA); 0 disables")
+       ->check(CLI::NonNegativeNumber)
+       ->capture_default_str();
+
+    app.add_option("--trace-out", options.trace_out,
+                   "Write a Chrome/Perfetto trace-event timeline of the run to this JSON file");
+
+    // Record sink options
+    bool dry_run = false;
+    app.add_option("--sink", options.sink,
+                   "Where records are written: mongo|null|fake (null = parse only, fake = in-process fake DB)")
+       ->check(CLI::IsMember({"mongo", "null", "fake"}))
+       ->capture_default_str();
+    app.add_flag("--dry-run", dry_run,
+                 "Parse the input without writing anything (same as --sink null)");
+    app.add_option("--fake-latency-ms", options.fake_latency_ms,
+                   "Fake sink: simulated latency per batch write")
+       ->check(CLI::NonNegativeNumber)
+       ->capture_default_str();
+    app.add_option("--fake-jitter-ms", options.fake_jitter_ms,
+                   "Fake sink: extra random latency per batch write, up to this value")
+       ->check(CLI::NonNegativeNumber)
+       ->capture_default_str();
+    app.add_option("--fake-failure-rate", options.fake_failure_rate,
+                   "Fake sink: fraction of batch writes that fail (0.0 - 1.0)")
+       ->check(CLI::Range(0.0, 1.0))
+       ->capture_default_str();
+    app.add_option("--write-retries", options.write_retries,
+                   "Retries per failed batch write (exponential backoff)")
+       ->check(CLI::NonNegativeNumber)
+       ->capture_default_str();
+
     // Optional log level argument
     app.add_option("--log-level", log_level_str,
                    "Log level: trace|debug|info|warn|error|critical")
@@ -91,6 +388,9 @@ int main(int argc, char** argv) {
     app.add_option("--log-file", log_file_path,
                    "Path to log file (if omitted, logs only to console)");
 
+    app.add_flag("--log-async", log_async,
+                 "Write logs from a background thread (never blocks workers; drops oldest on overflow)");
+
     try {
         app.parse(argc, argv);
     } catch (const CLI::ParseError& e) {
@@ -99,8 +399,13 @@ int main(int argc, char** argv) {
         return app.exit(e);
     }
 
+    if (dry_run) {
+        options.sink = "null";
+    }
+
     // Determine sensible default for threads if not provided or zero
-    if (threads <= 0) {
+    // (a profile brings its own thread count)
+    if (threads <= 0 && options.profile.empty()) {
         unsigned int hw = std::thread::hardware_concurrency();
         if (hw == 0) {
             threads = 4;  // conservative fallback
@@ -126,11 +431,15 @@ int main(int argc, char** argv) {
 
     // Initialize logger with user's options
     Logger::Level level = parse_log_level(log_level_str);
-    Logger::initialize(log_file_path, level);
+    Logger::initialize(log_file_path, level, log_async);
 
     LOG_INFO_F("vcf_importer starting");
     LOG_INFO_F("Input VCF file: '{}'", vcf_path);
-    LOG_INFO_F("Threads: {}", threads);
+    if (threads > 0) {
+        LOG_INFO_F("Threads: {}", threads);
+    } else {
+        LOG_INFO("Threads: from profile");
+    }
     LOG_INFO_F("Log level: {}", log_level_str);
     if (!log_file_path.empty()) {
         LOG_INFO_F("Logging to file: '{}'", log_file_path);
@@ -138,21 +447,31 @@ int main(int argc, char** argv) {
         LOG_INFO("Logging to console only");
     }
 
-    // Initialize MongoDB connection from environment variables
-    try {
-        auto mongo_config = vcf_tool::core::MongoConfig::from_environment();
-        vcf_tool::core::MongoDatabase::initialize(mongo_config);
-        LOG_INFO("MongoDB initialized successfully");
-    } catch (const vcf_tool::utils::errors::ValidationError& e) {
-        LOG_ERROR_F("MongoDB configuration error: {}", e.what());
-        LOG_ERROR("Please set MONGODB_URI and MONGODB_DB_NAME environment variables");
-        return vcf_tool::utils::errors::to_exit_code(e);
-    } catch (const vcf_tool::utils::errors::DatabaseError& e) {
-        LOG_ERROR_F("MongoDB connection error: {}", e.what());
-        return vcf_tool::utils::errors::to_exit_code(e);
+    LOG_INFO_F("Record sink: {}", options.sink);
+
+    // Initialize MongoDB connection from environment variables (only needed for the mongo sink)
+    if (options.sink == "mongo") {
+        try {
+            auto mongo_config = vcf_tool::core::MongoConfig::from_environment();
+            vcf_tool::core::MongoDatabase::initialize(mongo_config);
+            LOG_INFO("MongoDB initialized successfully");
+        } catch (const vcf_tool::utils::errors::ValidationError& e) {
+            LOG_ERROR_F("MongoDB configuration error: {}", e.what());
+            LOG_ERROR("Please set MONGODB_URI and MONGODB_DB_NAME environment variables");
+            return vcf_tool::utils::errors::to_exit_code(e);
+        } catch (const vcf_tool::utils::errors::DatabaseError& e) {
+            LOG_ERROR_F("MongoDB connection error: {}", e.what());
+            return vcf_tool::utils::errors::to_exit_code(e);
+        }
+    }
+
+    if (options.resume) {
+        LOG_INFO("Resume requested: continuing from checkpoint if present");
     }
 
-    int rc = run_vcf_import(vcf_path, threads);
+    int rc = options.calibrate
+        ? run_calibration(vcf_path, options)
+        : run_vcf_import(vcf_path, options);
 
     if (rc != 0) {
         LOG_ERROR_F("vcf_importer finished with errors (code {})", rc);
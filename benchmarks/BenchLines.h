@@ -0,0 +1,94 @@
+// BenchLines.h
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "header/VcfHeader.h"
+
+
+namespace vcf_tool::bench {
+
+/**
+ * Representative VCF data lines for benchmarks.
+ *
+ * Shapes follow what real callsets look like: gnomAD-style sites-only
+ * records, single-sample clinical VCFs, 1000 Genomes-style cohorts and
+ * VEP/SnpEff-annotated INFO columns.
+ */
+
+// Header declaring the per-allele INFO and FORMAT keys used below (typed genotype columns)
+inline domain::header::VcfHeader format_header()
+{
+    domain::header::VcfHeader header;
+    header.parse_line("##INFO=<ID=AC,Number=A,Type=Integer,Description=\"Allele count\">");
+    header.parse_line("##INFO=<ID=AF,Number=A,Type=Float,Description=\"Allele frequency\">");
+    header.parse_line("##FORMAT=<ID=GT,Number=1,Type=String,Description=\"Genotype\">");
+    header.parse_line("##FORMAT=<ID=AD,Number=R,Type=Integer,Description=\"Allelic depths\">");
+    header.parse_line("##FORMAT=<ID=DP,Number=1,Type=Integer,Description=\"Read depth\">");
+    header.parse_line("##FORMAT=<ID=GQ,Number=1,Type=Integer,Description=\"Genotype quality\">");
+    header.parse_line("##FORMAT=<ID=PL,Number=G,Type=Integer,Description=\"Phred-scaled likelihoods\">");
+    return header;
+}
+
+// Sites-only: 8 columns, short INFO
+inline std::string sites_only_line()
+{
+    return "chr1\t10177\trs367896724\tA\tAC\t100\tPASS\tAC=2130;AF=0.425319;AN=5008;NS=2504;DP=103152";
+}
+
+// Single sample with a typical GATK FORMAT column
+inline std::string one_sample_line()
+{
+    return "chr1\t69511\trs75062661\tA\tG\t2963.77\tPASS\t"
+           "AC=2;AF=1;AN=2;DP=74;FS=0;MLEAC=2;MLEAF=1;MQ=60;QD=28.73;SOR=0.941\t"
+           "GT:AD:DP:GQ:PL\t1/1:0,74:74:99:2992,223,0";
+}
+
+// Cohort line: `samples` genotype columns (GT:DP:GQ)
+inline std::string many_samples_line(std::size_t samples)
+{
+    std::string line = "chr20\t14370\trs6054257\tG\tA\t29\tPASS\tNS=3;DP=14;AF=0.5;DB;H2\tGT:DP:GQ";
+    static constexpr const char* kGenotypes[] = {"0|0:12:48", "1|0:8:48", "1/1:5:43", "0/1:9:35"};
+    for (std::size_t i = 0; i < samples; ++i) {
+        line += '\t';
+        line += kGenotypes[i % 4];
+    }
+    return line;
+}
+
+// Multiallelic cohort line: 3 ALT alleles with Number=A INFO and Number=R/G FORMAT values
+inline std::string multiallelic_line(std::size_t samples)
+{
+    std::string line = "chr2\t48010488\trs1042821\tCTT\tC,CT,CTTT\t812.4\tPASS\t"
+                       "AC=3,2,1;AF=0.25,0.167,0.083;AN=12;DP=96\tGT:AD:DP:PL";
+    static constexpr const char* kGenotypes[] = {
+        "0/1:10,8,0,0:18:120,0,160,150,190,300,170,200,310,320",
+        "1/2:1,9,7,0:17:400,110,380,90,0,370,420,300,350,500",
+        "0/0:16,0,0,0:16:0,48,720,48,720,720,48,720,720,720",
+        "2/3:0,1,6,5:12:500,450,420,120,140,160,300,90,0,100",
+    };
+    for (std::size_t i = 0; i < samples; ++i) {
+        line += '\t';
+        line += kGenotypes[i % 4];
+    }
+    return line;
+}
+
+// INFO-heavy: VEP-style CSQ annotation plus many numeric keys
+inline std::string info_heavy_line()
+{
+    std::string csq =
+        "CSQ=G|missense_variant|MODERATE|OR4F5|ENSG00000186092|Transcript|ENST00000335137|"
+        "protein_coding|3/3||ENST00000335137.4:c.421A>G|ENSP00000334393.3:p.Thr141Ala|"
+        "511|421|141|T/A|Acc/Gcc|rs75062661||1||SNV|HGNC|HGNC:14825|YES|CCDS30547.1";
+    std::string line = "chr1\t69511\trs75062661\tA\tG\t2963.77\tPASS\t";
+    line += "AC=2;AF=1;AN=2;BaseQRankSum=0.524;ClippingRankSum=0;DP=74;ExcessHet=3.0103;"
+            "FS=0;InbreedingCoeff=-0.0123;MLEAC=2;MLEAF=1;MQ=60;MQRankSum=0;QD=28.73;"
+            "ReadPosRankSum=0.198;SOR=0.941;VQSLOD=12.47;culprit=FS;POSITIVE_TRAIN_SITE;";
+    line += csq + "," + csq + "," + csq;
+    line += "\tGT:AD:DP:GQ:PL\t1/1:0,74:74:99:2992,223,0";
+    return line;
+}
+
+} // namespace vcf_tool::bench
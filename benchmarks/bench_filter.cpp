@@ -0,0 +1,126 @@
+// bench_filter.cpp - --filter expressions and --dedup, both on fixed columns
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "BenchLines.h"
+#include "filter/DuplicateFilter.h"
+#include "filter/RecordFilter.h"
+#include "parser/VcfLineParser.h"
+#include "entity/RawLine.h"
+#include "header/VcfDictionary.h"
+#include "memory/ChunkArena.h"
+
+
+namespace {
+
+using vcf_tool::domain::VcfLineParser;
+using vcf_tool::domain::VcfRecord;
+using vcf_tool::domain::entity::RawLine;
+using vcf_tool::domain::filter::DuplicateFilter;
+using vcf_tool::domain::filter::RecordFilter;
+using vcf_tool::domain::header::VcfDictionary;
+using vcf_tool::domain::memory::ChunkArena;
+
+constexpr const char* kTypical = "FILTER==\"PASS\" && QUAL>=30 && INFO.AF>0.01 && CHROM in (chr1,chr2)";
+
+// Evaluate `expression` on the fixed columns of `text` (INFO still deferred, as in the parsers)
+void evaluate(benchmark::State& state, const std::string& text, const char* expression)
+{
+    VcfDictionary dictionary(vcf_tool::bench::format_header());
+    const auto filter = RecordFilter::compile(expression, dictionary);
+    VcfLineParser parser(dictionary);
+    const auto arena = ChunkArena::create();
+    const auto record = parser.parse_fixed(RawLine{.line_number = 1, .end_offset = 0, .text = text, .is_end = false},
+                                           arena);
+
+    bool matched = false;
+    for (auto _ : state) {
+        matched = filter.matches(record.vcf_data);
+        benchmark::DoNotOptimize(matched);
+    }
+    state.counters["matched"] = matched ? 1 : 0;
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_Filter_Compile(benchmark::State& state)
+{
+    VcfDictionary dictionary(vcf_tool::bench::format_header());
+    for (auto _ : state) {
+        auto filter = RecordFilter::compile(kTypical, dictionary);
+        benchmark::DoNotOptimize(filter);
+    }
+}
+BENCHMARK(BM_Filter_Compile);
+
+// Passes: every clause is evaluated, AF found in the deferred INFO text
+void BM_Filter_Accept(benchmark::State& state)
+{
+    evaluate(state, vcf_tool::bench::sites_only_line(), kTypical);
+}
+BENCHMARK(BM_Filter_Accept);
+
+// Fails on the first clause (ID compare): the cost of dropping a line early
+void BM_Filter_RejectFixed(benchmark::State& state)
+{
+    evaluate(state, vcf_tool::bench::sites_only_line(), "CHROM==chrX && INFO.AF>0.01");
+}
+BENCHMARK(BM_Filter_RejectFixed);
+
+// INFO lookup in a long annotated INFO column (key near the end)
+void BM_Filter_InfoHeavy(benchmark::State& state)
+{
+    evaluate(state, vcf_tool::bench::info_heavy_line(), "INFO.VQSLOD>10");
+}
+BENCHMARK(BM_Filter_InfoHeavy);
+
+// Parser threads checking records against one shared duplicate filter.
+// Positions repeat every `distinct` records per thread: 0 = all new keys.
+void first_seen(benchmark::State& state, DuplicateFilter::Order order, std::uint64_t distinct)
+{
+    static std::unique_ptr<DuplicateFilter> filter;
+    if (state.thread_index() == 0) {
+        filter = std::make_unique<DuplicateFilter>(order, static_cast<std::size_t>(state.threads()));
+    }
+    const auto worker = static_cast<std::size_t>(state.thread_index());
+    VcfRecord record{};
+    record.chromosome = 0;
+    record.ref = "A";
+    record.alt = "G";
+
+    std::uint64_t i = 0;
+    std::int64_t duplicates = 0;
+    for (auto _ : state) {
+        const std::uint64_t n = distinct == 0 ? i : i % distinct;
+        record.position = n * static_cast<std::uint64_t>(state.threads()) + worker;
+        duplicates += filter->first_seen(worker, record, ++i) ? 0 : 1;
+    }
+    state.counters["duplicates"] = static_cast<double>(duplicates);
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        filter.reset();
+    }
+}
+
+void BM_Dedup_NewKeys(benchmark::State& state)
+{
+    first_seen(state, DuplicateFilter::Order::Unsorted, 0);
+}
+BENCHMARK(BM_Dedup_NewKeys)->Threads(1)->Threads(4)->UseRealTime();
+
+void BM_Dedup_NewKeysSorted(benchmark::State& state)
+{
+    first_seen(state, DuplicateFilter::Order::Sorted, 0);
+}
+BENCHMARK(BM_Dedup_NewKeysSorted)->Threads(1)->Threads(4)->UseRealTime();
+
+// Most records repeat one of 1024 keys per thread: the lookup-hit path
+void BM_Dedup_Duplicates(benchmark::State& state)
+{
+    first_seen(state, DuplicateFilter::Order::Unsorted, 1024);
+}
+BENCHMARK(BM_Dedup_Duplicates)->Threads(1)->Threads(4)->UseRealTime();
+
+} // namespace
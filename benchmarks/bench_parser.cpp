@@ -0,0 +1,240 @@
+// bench_parser.cpp - VcfLineParser and its helpers
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <exception>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "BenchLines.h"
+#include "parser/VcfLineParser.h"
+#include "entity/RawLine.h"
+#include "header/VcfDictionary.h"
+#include "header/FieldProjection.h"
+#include "memory/ChunkArena.h"
+
+
+namespace {
+
+using vcf_tool::domain::BasicVcfLineParser;
+using vcf_tool::domain::VcfLineParser;
+using vcf_tool::domain::parser::InfoMode;
+using vcf_tool::domain::parser::ParserPolicy;
+using vcf_tool::domain::parser::SampleMode;
+using vcf_tool::domain::entity::RawLine;
+using vcf_tool::domain::header::VcfDictionary;
+using vcf_tool::domain::header::FieldProjection;
+using vcf_tool::domain::memory::ChunkArena;
+using vcf_tool::domain::parser::ParseError;
+
+// Steady state of a parser thread: one arena, reset between records, keys already interned
+template<typename Parser = VcfLineParser>
+void parse_line(benchmark::State& state, const std::string& text, std::span<const std::uint32_t> samples = {},
+                const FieldProjection& info = {}, const FieldProjection& format = {})
+{
+    VcfDictionary dictionary(vcf_tool::bench::format_header());
+    Parser parser(dictionary);
+    if (!samples.empty()) {
+        parser.select_samples(samples);
+    }
+    parser.project_fields(info, format);
+    RawLine raw{.line_number = 1, .end_offset = text.size() + 1, .text = text, .is_end = false};
+    const auto arena = ChunkArena::create();
+
+    for (auto _ : state) {
+        {
+            auto record = parser(raw, arena);
+            benchmark::DoNotOptimize(record);
+        }
+        arena->reset();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text.size()));
+}
+
+// Fixed columns only: what a record dropped before INFO / FORMAT costs
+void parse_fixed(benchmark::State& state, const std::string& text)
+{
+    VcfDictionary dictionary(vcf_tool::bench::format_header());
+    VcfLineParser parser(dictionary);
+    RawLine raw{.line_number = 1, .end_offset = text.size() + 1, .text = text, .is_end = false};
+    const auto arena = ChunkArena::create();
+
+    for (auto _ : state) {
+        {
+            auto record = parser.parse_fixed(raw, arena);
+            benchmark::DoNotOptimize(record);
+        }
+        arena->reset();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text.size()));
+}
+
+void BM_ParseLine_SitesOnly(benchmark::State& state)
+{
+    parse_line(state, vcf_tool::bench::sites_only_line());
+}
+BENCHMARK(BM_ParseLine_SitesOnly);
+
+void BM_ParseLine_OneSample(benchmark::State& state)
+{
+    parse_line(state, vcf_tool::bench::one_sample_line());
+}
+BENCHMARK(BM_ParseLine_OneSample);
+
+void BM_ParseLine_ManySamples(benchmark::State& state)
+{
+    parse_line(state, vcf_tool::bench::many_samples_line(static_cast<std::size_t>(state.range(0))));
+}
+BENCHMARK(BM_ParseLine_ManySamples)->Arg(1000);
+
+// `range(0)` of 10000 samples, evenly spread: cost should follow the selection
+void BM_ParseLine_SelectedSamples(benchmark::State& state)
+{
+    constexpr std::size_t kSamples = 10000;
+    const auto selected = static_cast<std::size_t>(state.range(0));
+    std::vector<std::uint32_t> columns;
+    for (std::size_t i = 0; i < selected; ++i) {
+        columns.push_back(static_cast<std::uint32_t>(i * kSamples / selected));
+    }
+    parse_line(state, vcf_tool::bench::many_samples_line(kSamples), columns);
+}
+BENCHMARK(BM_ParseLine_SelectedSamples)->Arg(10)->Arg(300)->Arg(10000);
+
+void BM_ParseLine_InfoHeavy(benchmark::State& state)
+{
+    parse_line(state, vcf_tool::bench::info_heavy_line());
+}
+BENCHMARK(BM_ParseLine_InfoHeavy);
+
+// Same line keeping 3 of its 21 INFO keys and 2 of its 5 FORMAT keys
+void BM_ParseLine_InfoHeavyProjected(benchmark::State& state)
+{
+    parse_line(state, vcf_tool::bench::info_heavy_line(), {},
+               FieldProjection::parse("AF,DP,QD"), FieldProjection::parse("GT,DP"));
+}
+BENCHMARK(BM_ParseLine_InfoHeavyProjected);
+
+// Variants the pipeline selects at startup, against the generic parser above
+void BM_ParseLineSpecialized_SitesOnly(benchmark::State& state)
+{
+    parse_line<BasicVcfLineParser<ParserPolicy<SampleMode::SitesOnly, InfoMode::All>>>(
+        state, vcf_tool::bench::sites_only_line());
+}
+BENCHMARK(BM_ParseLineSpecialized_SitesOnly);
+
+void BM_ParseLineSpecialized_ManySamples(benchmark::State& state)
+{
+    parse_line<BasicVcfLineParser<ParserPolicy<SampleMode::All, InfoMode::All>>>(
+        state, vcf_tool::bench::many_samples_line(static_cast<std::size_t>(state.range(0))));
+}
+BENCHMARK(BM_ParseLineSpecialized_ManySamples)->Arg(1000);
+
+void BM_ParseLineSpecialized_InfoHeavyProjected(benchmark::State& state)
+{
+    parse_line<BasicVcfLineParser<ParserPolicy<SampleMode::All, InfoMode::Projected>>>(
+        state, vcf_tool::bench::info_heavy_line(), {},
+        FieldProjection::parse("AF,DP,QD"), FieldProjection::parse("GT,DP"));
+}
+BENCHMARK(BM_ParseLineSpecialized_InfoHeavyProjected);
+
+void BM_ParseFixed_ManySamples(benchmark::State& state)
+{
+    parse_fixed(state, vcf_tool::bench::many_samples_line(static_cast<std::size_t>(state.range(0))));
+}
+BENCHMARK(BM_ParseFixed_ManySamples)->Arg(1000);
+
+void BM_ParseFixed_InfoHeavy(benchmark::State& state)
+{
+    parse_fixed(state, vcf_tool::bench::info_heavy_line());
+}
+BENCHMARK(BM_ParseFixed_InfoHeavy);
+
+// A line with a bad POS: error result (--max-errors) vs. thrown ParsingError (strict)
+constexpr const char* kMalformedLine = "chr1\t12x45\t.\tA\tG\t50\tPASS\tDP=10";
+
+void BM_ParseFixed_MalformedResult(benchmark::State& state)
+{
+    VcfDictionary dictionary(vcf_tool::bench::format_header());
+    VcfLineParser parser(dictionary);
+    const std::string text = kMalformedLine;
+    RawLine raw{.line_number = 1, .end_offset = text.size() + 1, .text = text, .is_end = false};
+    const auto arena = ChunkArena::create();
+
+    for (auto _ : state) {
+        ParseError error;
+        auto record = parser.parse_fixed(raw, arena, error);
+        benchmark::DoNotOptimize(record);
+        benchmark::DoNotOptimize(error);
+        arena->reset();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParseFixed_MalformedResult);
+
+void BM_ParseFixed_MalformedThrow(benchmark::State& state)
+{
+    VcfDictionary dictionary(vcf_tool::bench::format_header());
+    VcfLineParser parser(dictionary);
+    const std::string text = kMalformedLine;
+    RawLine raw{.line_number = 1, .end_offset = text.size() + 1, .text = text, .is_end = false};
+    const auto arena = ChunkArena::create();
+
+    for (auto _ : state) {
+        try {
+            auto record = parser.parse_fixed(raw, arena);
+            benchmark::DoNotOptimize(record);
+        } catch (const std::exception& e) {
+            benchmark::DoNotOptimize(e.what());
+        }
+        arena->reset();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParseFixed_MalformedThrow);
+
+void BM_SplitTabs(benchmark::State& state)
+{
+    auto line = vcf_tool::bench::many_samples_line(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        auto fields = VcfLineParser::split_tabs(line);
+        benchmark::DoNotOptimize(fields);
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(line.size()));
+}
+BENCHMARK(BM_SplitTabs)->Arg(0)->Arg(1000);
+
+void BM_TryParseDouble_Number(benchmark::State& state)
+{
+    const std::string value = "0.425319";
+
+    for (auto _ : state) {
+        auto parsed = VcfLineParser::try_parse_double(value);
+        benchmark::DoNotOptimize(parsed);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TryParseDouble_Number);
+
+// Non-numeric values are rejected by from_chars (no exception path)
+void BM_TryParseDouble_NotNumber(benchmark::State& state)
+{
+    const std::string value = "missense_variant";
+
+    for (auto _ : state) {
+        auto parsed = VcfLineParser::try_parse_double(value);
+        benchmark::DoNotOptimize(parsed);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TryParseDouble_NotNumber);
+
+} // namespace
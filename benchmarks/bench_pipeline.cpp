@@ -0,0 +1,79 @@
+// bench_pipeline.cpp - queue hand-off and thread pool overhead
+#include <benchmark/benchmark.h>
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <vcf_tool/core/ThreadPool.h>
+
+#include "BenchLines.h"
+#include "Queues.h"
+
+
+namespace {
+
+using vcf_tool::domain::LineQueue;
+using vcf_tool::domain::RawLine;
+using vcf_tool::domain::kLineChunkSize;
+
+// One enqueue + one dequeue per line (single thread: pure queue overhead)
+void BM_LineQueue_RoundTrip(benchmark::State& state)
+{
+    LineQueue queue(1024);
+    const auto text = vcf_tool::bench::one_sample_line();
+    RawLine out;
+
+    for (auto _ : state) {
+        queue.enqueue(RawLine{.line_number = 1, .end_offset = 0, .text = text, .is_end = false});
+        queue.wait_dequeue(out);
+        benchmark::DoNotOptimize(out);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LineQueue_RoundTrip);
+
+// Chunked hand-off as done by the reader and parsers
+void BM_LineQueue_BulkRoundTrip(benchmark::State& state)
+{
+    LineQueue queue(kLineChunkSize * 4);
+    const auto text = vcf_tool::bench::one_sample_line();
+    std::vector<RawLine> in(kLineChunkSize);
+    std::vector<RawLine> out(kLineChunkSize);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (auto& line : in) {
+            line = RawLine{.line_number = 1, .end_offset = 0, .text = text, .is_end = false};
+        }
+        state.ResumeTiming();
+
+        queue.enqueue_bulk(std::make_move_iterator(in.begin()), in.size());
+        std::size_t got = 0;
+        while (got < kLineChunkSize) {
+            got += queue.wait_dequeue_bulk(out.begin() + static_cast<std::ptrdiff_t>(got),
+                                           kLineChunkSize - got);
+        }
+        benchmark::DoNotOptimize(out);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kLineChunkSize));
+}
+BENCHMARK(BM_LineQueue_BulkRoundTrip);
+
+// submit() + future.get() latency for an empty task
+void BM_ThreadPool_Submit(benchmark::State& state)
+{
+    vcf_tool::core::ThreadPool pool(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        auto future = pool.submit([] { return 1; });
+        benchmark::DoNotOptimize(future.get());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ThreadPool_Submit)->Arg(1)->Arg(4);
+
+} // namespace
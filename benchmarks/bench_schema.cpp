@@ -0,0 +1,75 @@
+// bench_schema.cpp - BSON encoding of parsed records
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "BenchLines.h"
+#include "parser/VcfLineParser.h"
+#include "dao/VcfSchema.h"
+#include "dao/VcfDao.h"
+#include "header/VcfDictionary.h"
+
+
+namespace {
+
+using vcf_tool::domain::VcfLineParser;
+using vcf_tool::domain::dao::VcfDao;
+using vcf_tool::domain::dao::VcfSchema;
+using vcf_tool::domain::entity::ParsedRecord;
+using vcf_tool::domain::entity::RawLine;
+using vcf_tool::domain::header::VcfDictionary;
+
+VcfDictionary dictionary(vcf_tool::bench::format_header());
+
+ParsedRecord parsed(const std::string& text)
+{
+    return VcfLineParser{dictionary}(RawLine{.line_number = 1, .end_offset = 0, .text = text, .is_end = false});
+}
+
+void to_bson(benchmark::State& state, const std::string& text)
+{
+    auto record = parsed(text);
+
+    for (auto _ : state) {
+        auto doc = VcfSchema::to_bson(record.vcf_data, dictionary);
+        benchmark::DoNotOptimize(doc);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_ToBson_SitesOnly(benchmark::State& state)
+{
+    to_bson(state, vcf_tool::bench::sites_only_line());
+}
+BENCHMARK(BM_ToBson_SitesOnly);
+
+void BM_ToBson_InfoHeavy(benchmark::State& state)
+{
+    to_bson(state, vcf_tool::bench::info_heavy_line());
+}
+BENCHMARK(BM_ToBson_InfoHeavy);
+
+void BM_ToBson_ManySamples(benchmark::State& state)
+{
+    to_bson(state, vcf_tool::bench::many_samples_line(static_cast<std::size_t>(state.range(0))));
+}
+BENCHMARK(BM_ToBson_ManySamples)->Arg(1000);
+
+// Writer-side encode of a whole batch (VcfDao::encode)
+void BM_EncodeBatch(benchmark::State& state)
+{
+    std::vector<ParsedRecord> batch(static_cast<std::size_t>(state.range(0)),
+                                    parsed(vcf_tool::bench::one_sample_line()));
+
+    for (auto _ : state) {
+        auto docs = VcfDao::encode(batch, dictionary);
+        benchmark::DoNotOptimize(docs);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EncodeBatch)->Arg(1000);
+
+} // namespace
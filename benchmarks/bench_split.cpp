@@ -0,0 +1,73 @@
+// bench_split.cpp - --split-multiallelic: splitting and trimming decoded records
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "BenchLines.h"
+#include "transform/AlleleSplitter.h"
+#include "parser/VcfLineParser.h"
+#include "entity/ParsedRecord.h"
+#include "entity/RawLine.h"
+#include "header/VcfDictionary.h"
+#include "memory/ChunkArena.h"
+
+
+namespace {
+
+using vcf_tool::domain::VcfLineParser;
+using vcf_tool::domain::entity::ParsedRecord;
+using vcf_tool::domain::entity::RawLine;
+using vcf_tool::domain::header::VcfDictionary;
+using vcf_tool::domain::memory::ChunkArena;
+using vcf_tool::domain::transform::AlleleSplitter;
+
+// Parse `text` and (with `split`) split it, as a parser thread does; the arena is reset per line
+void parse_and_split(benchmark::State& state, const std::string& text, bool split)
+{
+    VcfDictionary dictionary(vcf_tool::bench::format_header());
+    VcfLineParser parser(dictionary);
+    const AlleleSplitter splitter(dictionary);
+    RawLine raw{.line_number = 1, .end_offset = text.size() + 1, .text = text, .is_end = false};
+    const auto arena = ChunkArena::create();
+    std::vector<ParsedRecord> records;
+
+    for (auto _ : state) {
+        auto record = parser(raw, arena);
+        if (split) {
+            splitter.split(std::move(record), records);
+        } else {
+            records.push_back(std::move(record));
+        }
+        benchmark::DoNotOptimize(records.data());
+        records.clear();
+        arena->reset();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text.size()));
+}
+
+// Baseline: the same multiallelic cohort line parsed but not split
+void BM_Split_ParseOnly(benchmark::State& state)
+{
+    parse_and_split(state, vcf_tool::bench::multiallelic_line(static_cast<std::size_t>(state.range(0))), false);
+}
+BENCHMARK(BM_Split_ParseOnly)->Arg(100);
+
+// 3 ALT alleles: INFO AC/AF, FORMAT AD/PL subset and GT recoded per part
+void BM_Split_Multiallelic(benchmark::State& state)
+{
+    parse_and_split(state, vcf_tool::bench::multiallelic_line(static_cast<std::size_t>(state.range(0))), true);
+}
+BENCHMARK(BM_Split_Multiallelic)->Arg(100);
+
+// Biallelic line: only the trim check runs
+void BM_Split_Biallelic(benchmark::State& state)
+{
+    parse_and_split(state, vcf_tool::bench::one_sample_line(), true);
+}
+BENCHMARK(BM_Split_Biallelic);
+
+} // namespace
@@ -0,0 +1,90 @@
+// bench_writer.cpp - writer throughput against the in-process fake sink
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <vcf_tool/core/Metrics.h>
+
+#include "BenchLines.h"
+#include "Queues.h"
+#include "parser/VcfLineParser.h"
+#include "header/VcfDictionary.h"
+#include "sink/FakeSink.h"
+#include "writer/DbWriterWorker.h"
+
+
+namespace {
+
+using vcf_tool::core::metrics::MetricsRegistry;
+using vcf_tool::domain::RecordQueue;
+using vcf_tool::domain::VcfLineParser;
+using vcf_tool::domain::api::FakeSinkOptions;
+using vcf_tool::domain::entity::ParsedRecord;
+using vcf_tool::domain::entity::RawLine;
+using vcf_tool::domain::header::VcfDictionary;
+using vcf_tool::domain::metrics::PipelineMetrics;
+using vcf_tool::domain::sink::FakeSink;
+using vcf_tool::domain::writer::DbWriterWorker;
+using vcf_tool::domain::writer::RetryPolicy;
+
+constexpr std::size_t kRecords = 20'000;
+
+// Push kRecords through a DbWriterWorker writing to a FakeSink
+void run_writer(benchmark::State& state, std::size_t batch_size, FakeSinkOptions options)
+{
+    const std::string text = vcf_tool::bench::one_sample_line();
+    VcfDictionary dictionary(vcf_tool::bench::format_header());
+    const ParsedRecord record =
+        VcfLineParser{dictionary}(RawLine{.line_number = 1, .end_offset = 0, .text = text, .is_end = false});
+
+    for (auto _ : state) {
+        MetricsRegistry registry;
+        PipelineMetrics metrics(registry);
+        RecordQueue queue(kRecords + 1);
+        {
+            DbWriterWorker writer(queue, batch_size, 1,
+                                  std::make_unique<FakeSink>(dictionary, options), metrics,
+                                  RetryPolicy{.max_retries = 5, .backoff = std::chrono::milliseconds(0)},
+                                  nullptr);
+            for (std::size_t i = 0; i < kRecords; ++i) {
+                queue.enqueue(record);
+            }
+            ParsedRecord sentinel;
+            sentinel.is_end = true;
+            queue.enqueue(std::move(sentinel));
+        }  // Joins the writer after the final flush
+
+        state.counters["retries"] = static_cast<double>(metrics.retries.value());
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kRecords));
+}
+
+// range(0) = batch size, range(1) = simulated write latency in microseconds
+void BM_Writer_FakeSink(benchmark::State& state)
+{
+    FakeSinkOptions options;
+    options.latency = std::chrono::microseconds(state.range(1));
+    run_writer(state, static_cast<std::size_t>(state.range(0)), options);
+}
+BENCHMARK(BM_Writer_FakeSink)
+    ->Args({100, 0})->Args({1000, 0})->Args({5000, 0})
+    ->Args({100, 500})->Args({1000, 500})->Args({5000, 500})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// range(0) = percentage of batch writes that fail and are retried
+void BM_Writer_FakeSinkFailures(benchmark::State& state)
+{
+    FakeSinkOptions options;
+    options.failure_rate = static_cast<double>(state.range(0)) / 100.0;
+    run_writer(state, 1000, options);
+}
+BENCHMARK(BM_Writer_FakeSinkFailures)
+    ->Arg(0)->Arg(10)->Arg(30)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // namespace
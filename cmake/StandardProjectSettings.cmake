@@ -32,3 +32,10 @@ if(DEBUG OR CMAKE_BUILD_TYPE STREQUAL "Debug")
   add_compile_definitions(
     VCF_DEBUG VCF_ENABLE_ASSERTS VCF_PROFILE)
 endif()
+
+# Lowest log level compiled into the binaries (0=trace ... 5=critical).
+# Empty = Logger.h default: everything in debug builds, info and above otherwise.
+set(VCF_LOG_ACTIVE_LEVEL "" CACHE STRING "Compile-time log level floor (0-5)")
+if(NOT VCF_LOG_ACTIVE_LEVEL STREQUAL "")
+  add_compile_definitions(VCF_LOG_ACTIVE_LEVEL=${VCF_LOG_ACTIVE_LEVEL})
+endif()
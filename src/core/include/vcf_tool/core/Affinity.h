@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+
+namespace vcf_tool::core::affinity {
+
+/**
+ * @brief One logical CPU and where it sits in the machine
+ */
+struct Cpu {
+    int id{0};
+    int core_id{0};     // Physical core within the package
+    int package_id{0};  // Socket
+    int numa_node{0};
+};
+
+/**
+ * @brief Logical CPUs this process may run on, read from sysfs
+ *
+ * Only CPUs in the process affinity mask are listed (containers and
+ * taskset restrict it). Falls back to hardware_concurrency() CPUs on a
+ * single node when sysfs is unavailable.
+ */
+struct CpuTopology {
+    std::vector<Cpu> cpus;
+
+    static CpuTopology detect();
+
+    /// NUMA node of `cpu` (0 if unknown)
+    int numa_node_of(int cpu) const;
+
+    std::size_t numa_node_count() const;
+};
+
+/**
+ * @brief How pipeline threads are mapped to CPUs
+ */
+enum class Policy {
+    None,     // Leave placement to the OS scheduler
+    Compact,  // Fill one NUMA node (one thread per physical core first) before the next
+    Scatter,  // Round-robin across NUMA nodes
+    Explicit  // User-provided CPU list, in order
+};
+
+/**
+ * Parse a Linux-style CPU list ("0-3,8,10-11").
+ *
+ * @throws ValidationError on malformed input
+ */
+std::vector<int> parse_cpu_list(std::string_view list);
+
+/**
+ * @brief Assigns pipeline thread slots to CPUs
+ *
+ * Each thread that wants to be pinned asks for a slot number (e.g. reader
+ * = 0, writer = 1, parsers = 2..). Slot k maps to the k-th CPU of the
+ * policy's ordering, wrapping around when there are more slots than CPUs.
+ *
+ * Pinning is best effort: a failure is logged once per thread and the
+ * thread keeps running unpinned.
+ *
+ * Usage:
+ *   CpuPlacement placement(Policy::Compact, CpuTopology::detect());
+ *   placement.pin_current_thread(0);
+ */
+class CpuPlacement {
+public:
+    /// No pinning
+    CpuPlacement() = default;
+
+    /**
+     * @param policy         Placement policy
+     * @param topology       CPUs available to the process
+     * @param explicit_cpus  CPU order for Policy::Explicit (must be available CPUs)
+     * @throws ValidationError if an explicit CPU is not available
+     */
+    CpuPlacement(Policy policy, const CpuTopology& topology, std::vector<int> explicit_cpus = {});
+
+    bool enabled() const { return !order_.empty(); }
+
+    /// CPU for thread slot `slot` (std::nullopt = not pinned)
+    std::optional<int> cpu_for(std::size_t slot) const;
+
+    /// NUMA node of the CPU for `slot` (std::nullopt = not pinned)
+    std::optional<int> numa_node_for(std::size_t slot) const;
+
+    /// Pin the calling thread to the CPU of `slot`; false if not pinned
+    bool pin_current_thread(std::size_t slot) const;
+
+    /// Pin another thread to the CPU of `slot`; false if not pinned
+    bool pin_thread(std::thread::native_handle_type handle, std::size_t slot) const;
+
+    /// CPU order, e.g. "compact: 0,2,4,6 (node 0), 1,3,5,7 (node 1)"
+    std::string describe() const;
+
+private:
+    Policy policy_{Policy::None};
+    std::vector<int> order_;
+    std::vector<int> nodes_;  // NUMA node of order_[i]
+};
+
+} // namespace vcf_tool::core::affinity
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <stop_token>
+#include <condition_variable>
+#include <vector>
+
+
+namespace vcf_tool::core::metrics {
+
+/// Number of per-thread shards per metric (threads are assigned round-robin)
+inline constexpr std::size_t kShards = 16;
+
+/// Shard index of the calling thread (assigned once per thread)
+std::size_t shard_index() noexcept;
+
+/**
+ * @brief Monotonic counter sharded across threads
+ *
+ * Each thread increments its own cache-line-sized shard with a relaxed
+ * atomic add, so hot paths never contend on a shared line. Reading sums
+ * all shards (cheap, done only by exporters).
+ */
+class Counter {
+public:
+    void add(std::uint64_t n = 1) noexcept {
+        shards_[shard_index()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    std::uint64_t value() const noexcept;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<std::uint64_t> value{0};
+    };
+    std::array<Shard, kShards> shards_{};
+};
+
+/**
+ * @brief Point-in-time value (queue depth, active workers, ...)
+ */
+class Gauge {
+public:
+    void set(std::int64_t v) noexcept { value_.store(v, std::memory_order_relaxed); }
+    void add(std::int64_t v) noexcept { value_.fetch_add(v, std::memory_order_relaxed); }
+    std::int64_t value() const noexcept { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::int64_t> value_{0};
+};
+
+/**
+ * @brief Log2-bucketed histogram sharded across threads
+ *
+ * Bucket i counts observations v with bit_width(v) == i, i.e. values in
+ * [2^(i-1), 2^i). Observations are raw integers (typically nanoseconds);
+ * `unit_scale` converts them for export (1e-9 => seconds).
+ */
+class Histogram {
+public:
+    static constexpr std::size_t kBuckets = 64;
+
+    struct Snapshot {
+        std::array<std::uint64_t, kBuckets> buckets{};
+        std::uint64_t count{0};
+        std::uint64_t sum{0};
+        std::uint64_t max{0};
+
+        /// Upper bound of the bucket containing quantile q (raw units)
+        std::uint64_t quantile(double q) const noexcept;
+        double mean() const noexcept {
+            return count == 0 ? 0.0 : static_cast<double>(sum) / static_cast<double>(count);
+        }
+    };
+
+    explicit Histogram(double unit_scale = 1.0) : unit_scale_(unit_scale) {}
+
+    void observe(std::uint64_t v) noexcept {
+        auto& shard = shards_[shard_index()];
+        std::size_t bucket = std::min<std::size_t>(std::bit_width(v), kBuckets - 1);
+        shard.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        shard.sum.fetch_add(v, std::memory_order_relaxed);
+        std::uint64_t prev = shard.max.load(std::memory_order_relaxed);
+        while (v > prev && !shard.max.compare_exchange_weak(prev, v, std::memory_order_relaxed)) {
+        }
+    }
+
+    Snapshot snapshot() const noexcept;
+    double unit_scale() const noexcept { return unit_scale_; }
+
+private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<std::uint64_t>, kBuckets> buckets{};
+        std::atomic<std::uint64_t> sum{0};
+        std::atomic<std::uint64_t> max{0};
+    };
+
+    double unit_scale_;
+    std::array<Shard, kShards> shards_{};
+};
+
+/**
+ * @brief Steady-clock stopwatch for latency observations
+ */
+class Stopwatch {
+public:
+    Stopwatch() : start_(std::chrono::steady_clock::now()) {}
+
+    std::uint64_t elapsed_ns() const noexcept {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_).count());
+    }
+
+    void reset() noexcept { start_ = std::chrono::steady_clock::now(); }
+
+private:
+    std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief Named collection of counters, gauges and histograms
+ *
+ * Registration takes a lock (cold path, done once at pipeline setup) and
+ * returns a stable reference; updating a metric through that reference is
+ * lock-free. Registering an existing name returns the existing metric (a
+ * callback gauge gets the new callback); registering it as a different kind
+ * throws std::logic_error.
+ *
+ * Exports:
+ *   - Prometheus text exposition format (for the node_exporter textfile collector)
+ *   - JSON summary (counters, gauges, histogram count/mean/p50/p90/p99/max)
+ */
+class MetricsRegistry {
+public:
+    MetricsRegistry() = default;
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    Counter& counter(const std::string& name, const std::string& help);
+    Gauge& gauge(const std::string& name, const std::string& help);
+    Histogram& histogram(const std::string& name, const std::string& help,
+                         double unit_scale = 1.0);
+
+    /// Gauge whose value is sampled from `fn` at export time (e.g. queue depth)
+    void gauge_callback(const std::string& name, const std::string& help,
+                        std::function<double()> fn);
+
+    std::string to_prometheus() const;
+    std::string to_json() const;
+
+    /// Atomically replace `path` with the Prometheus exposition (write + rename)
+    void write_prometheus_file(const std::string& path) const;
+
+private:
+    enum class Kind { Counter, Gauge, GaugeCallback, Histogram };
+
+    struct Entry {
+        std::string name;
+        std::string help;
+        Kind kind;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+        std::function<double()> callback;
+    };
+
+    /// Entry named `name`, nullptr if none; throws if it is not of `kind`
+    Entry* find(const std::string& name, Kind kind);
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Entry>> entries_;
+};
+
+/**
+ * @brief Background thread that periodically writes a Prometheus text file
+ *
+ * Writes every `interval` and once more on destruction, so the file always
+ * ends with the final values of the run.
+ */
+class MetricsExporter {
+public:
+    MetricsExporter(const MetricsRegistry& registry,
+                    std::string path,
+                    std::chrono::milliseconds interval);
+
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+private:
+    void run(std::stop_token st);
+    void write() const;
+
+    const MetricsRegistry& registry_;
+    std::string path_;
+    std::chrono::milliseconds interval_;
+
+    std::mutex mutex_;
+    std::condition_variable_any cv_;
+    std::jthread thread_;
+};
+
+} // namespace vcf_tool::core::metrics
@@ -69,6 +69,17 @@ public:
      */
     mongocxx::collection get_collection();
 
+    /**
+     * Get a handle to another collection of the configured database
+     */
+    mongocxx::collection get_collection(const std::string& name);
+
+    /**
+     * Drop a collection of the configured database (no-op if it doesn't exist)
+     * @throws DatabaseError if the drop fails
+     */
+    void drop_collection(const std::string& name);
+
     /**
      * Get current configuration
      */
@@ -20,6 +20,12 @@ public:
     explicit ThreadPool(std::size_t thread_count =
         std::thread::hardware_concurrency());
 
+    /**
+     * Same as above, but each worker calls on_thread_start(worker_index)
+     * before taking its first task (e.g. to pin itself to a CPU).
+     */
+    ThreadPool(std::size_t thread_count, std::function<void(std::size_t)> on_thread_start);
+
     ~ThreadPool();
 
     // Non-copyable, non-movable (can be added later if needed)
@@ -38,10 +44,15 @@ public:
     auto submit(F&& f, Args&&... args)
         -> std::future<std::invoke_result_t<F, Args...>>;
 
+    // Number of worker threads
+    std::size_t size() const { return workers_.size(); }
+
 private:
     // Worker function entry point
     void worker_loop(std::stop_token st);
 
+    void start_workers(std::size_t thread_count, std::function<void(std::size_t)> on_thread_start);
+
     // Task type erased as void()
     using Task = std::function<void()>;
 
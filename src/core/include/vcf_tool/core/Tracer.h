@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+namespace vcf_tool::core::trace {
+
+/**
+ * @brief One completed span ("X" event in the Chrome trace-event format)
+ *
+ * `name` and `category` must be string literals (only the pointer is kept).
+ */
+struct Event {
+    const char*   name{nullptr};
+    const char*   category{nullptr};
+    std::uint64_t start_ns{0};   // Relative to Tracer::start()
+    std::uint64_t dur_ns{0};
+    std::uint64_t arg{0};        // Optional payload (e.g. lines in a chunk)
+};
+
+/**
+ * @brief Process-wide span recorder with per-thread ring buffers
+ *
+ * Each thread records into its own fixed-size ring buffer (no locks, no
+ * allocation after the first event); when a ring is full the oldest events
+ * are overwritten. Buffers are registered under a mutex once per thread
+ * and outlive their thread, so the trace can be dumped after all workers
+ * have exited.
+ *
+ * When tracing is off, instrumentation costs a single relaxed load and a
+ * branch (see Span).
+ *
+ * Usage:
+ *   Tracer::instance().start();
+ *   { Span span("parse_chunk", "parser"); ... }
+ *   Tracer::instance().stop();
+ *   Tracer::instance().write_chrome_trace("trace.json");
+ *
+ * Thread Safety:
+ *   - record() / set_thread_name(): any thread, lock-free after first use
+ *   - start() / stop() / write_chrome_trace(): call from one control thread,
+ *     write only after the recording threads have been joined
+ */
+class Tracer {
+public:
+    static constexpr std::size_t kDefaultEventsPerThread = 1 << 16;
+
+    static Tracer& instance();
+
+    /// True while recording (the only check on the hot path)
+    static bool enabled() noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+    /// Nanoseconds since start()
+    static std::uint64_t now_ns() noexcept;
+
+    /// Discard previous events and start recording
+    void start(std::size_t events_per_thread = kDefaultEventsPerThread);
+
+    /// Stop recording (events are kept until the next start())
+    void stop();
+
+    /// Name the calling thread in the trace (e.g. "reader", "parser")
+    void set_thread_name(std::string name);
+
+    /// Record a completed span for the calling thread
+    void record(const Event& event) noexcept;
+
+    /**
+     * Write all recorded events as Chrome trace-event JSON
+     * (loadable in chrome://tracing and ui.perfetto.dev).
+     *
+     * @throws IOError if the file cannot be written
+     */
+    void write_chrome_trace(const std::string& path) const;
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+private:
+    struct ThreadBuffer;
+
+    Tracer() = default;
+    ~Tracer();
+
+    ThreadBuffer& local_buffer();
+
+    static inline std::atomic<bool> enabled_{false};
+    static inline std::atomic<std::int64_t> epoch_ns_{0};
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+    std::size_t capacity_{kDefaultEventsPerThread};
+    std::uint32_t next_tid_{1};
+};
+
+/**
+ * @brief RAII span: records [construction, destruction) when tracing is on
+ *
+ * Spans shorter than `min_ns` are dropped, which keeps frequent but usually
+ * instant operations (e.g. a non-blocking queue wait) out of the trace.
+ */
+class Span {
+public:
+    Span(const char* name, const char* category, std::uint64_t min_ns = 0) noexcept
+        : name_(name)
+        , category_(category)
+        , min_ns_(min_ns)
+    {
+        if (Tracer::enabled()) {
+            active_ = true;
+            start_ns_ = Tracer::now_ns();
+        }
+    }
+
+    ~Span() { end(); }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+    void set_arg(std::uint64_t arg) noexcept { arg_ = arg; }
+
+    /// Record the span now (no-op if already ended or tracing is off)
+    void end() noexcept {
+        if (active_) {
+            active_ = false;
+            std::uint64_t dur = Tracer::now_ns() - start_ns_;
+            if (dur >= min_ns_) {
+                Tracer::instance().record(Event{name_, category_, start_ns_, dur, arg_});
+            }
+        }
+    }
+
+    /// End this span with `arg` and immediately start the next one
+    void next(std::uint64_t arg) noexcept {
+        arg_ = arg;
+        end();
+        arg_ = 0;
+        if (Tracer::enabled()) {
+            active_ = true;
+            start_ns_ = Tracer::now_ns();
+        }
+    }
+
+private:
+    const char* name_;
+    const char* category_;
+    std::uint64_t min_ns_;
+    std::uint64_t start_ns_{0};
+    std::uint64_t arg_{0};
+    bool active_{false};
+};
+
+} // namespace vcf_tool::core::trace
@@ -0,0 +1,318 @@
+#include <vcf_tool/core/Affinity.h>
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <vcf_tool/utils/Logger.h>
+#include <vcf_tool/utils/Errors.h>
+#include <vcf_tool/utils/Format.h>
+
+
+namespace vcf_tool::core::affinity {
+
+namespace fs = std::filesystem;
+using utils::errors::ValidationError;
+
+namespace {
+
+const fs::path kCpuRoot{"/sys/devices/system/cpu"};
+const fs::path kNodeRoot{"/sys/devices/system/node"};
+
+std::optional<std::string> read_line(const fs::path& path)
+{
+    std::ifstream in(path);
+    std::string line;
+    if (!in.is_open() || !std::getline(in, line)) {
+        return std::nullopt;
+    }
+    return line;
+}
+
+int read_int(const fs::path& path, int fallback)
+{
+    auto line = read_line(path);
+    if (!line) {
+        return fallback;
+    }
+    int value = fallback;
+    std::from_chars(line->data(), line->data() + line->size(), value);
+    return value;
+}
+
+bool allowed(const cpu_set_t& mask, int cpu)
+{
+    return cpu >= 0 && cpu < CPU_SETSIZE && CPU_ISSET(static_cast<std::size_t>(cpu), &mask);
+}
+
+bool set_affinity(pthread_t thread, int cpu)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<std::size_t>(cpu), &set);
+    return pthread_setaffinity_np(thread, sizeof(set), &set) == 0;
+}
+
+// Per node: one CPU per physical core first, then the SMT siblings
+std::map<int, std::vector<int>> compact_by_node(const CpuTopology& topology)
+{
+    std::map<std::pair<int, int>, int> siblings_seen;  // (package, core) -> count
+    std::map<int, std::vector<std::pair<int, const Cpu*>>> ranked;  // node -> (smt rank, cpu)
+
+    std::vector<const Cpu*> cpus;
+    for (const auto& cpu : topology.cpus) {
+        cpus.push_back(&cpu);
+    }
+    std::sort(cpus.begin(), cpus.end(), [](const Cpu* a, const Cpu* b) { return a->id < b->id; });
+
+    for (const Cpu* cpu : cpus) {
+        int rank = siblings_seen[{cpu->package_id, cpu->core_id}]++;
+        ranked[cpu->numa_node].emplace_back(rank, cpu);
+    }
+
+    std::map<int, std::vector<int>> by_node;
+    for (auto& [node, entries] : ranked) {
+        std::stable_sort(entries.begin(), entries.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (const auto& entry : entries) {
+            by_node[node].push_back(entry.second->id);
+        }
+    }
+    return by_node;
+}
+
+} // namespace
+
+std::vector<int> parse_cpu_list(std::string_view list)
+{
+    auto parse_int = [&](std::string_view token) {
+        int value = -1;
+        auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+        if (ec != std::errc{} || ptr != token.data() + token.size() || value < 0) {
+            throw ValidationError(utils::format("Invalid CPU list '{}'", list));
+        }
+        return value;
+    };
+
+    std::vector<int> cpus;
+    while (!list.empty() && list.back() == '\n') {
+        list.remove_suffix(1);
+    }
+
+    std::size_t start = 0;
+    while (start <= list.size() && !list.empty()) {
+        std::size_t comma = list.find(',', start);
+        std::string_view token = list.substr(start, comma == std::string_view::npos ? std::string_view::npos : comma - start);
+
+        std::size_t dash = token.find('-');
+        if (dash == std::string_view::npos) {
+            cpus.push_back(parse_int(token));
+        } else {
+            int first = parse_int(token.substr(0, dash));
+            int last = parse_int(token.substr(dash + 1));
+            if (last < first) {
+                throw ValidationError(utils::format("Invalid CPU range '{}' in '{}'", token, list));
+            }
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        }
+
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        start = comma + 1;
+    }
+    return cpus;
+}
+
+CpuTopology CpuTopology::detect()
+{
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    const bool have_mask = sched_getaffinity(0, sizeof(mask), &mask) == 0;
+
+    std::vector<int> online;
+    try {
+        if (auto line = read_line(kCpuRoot / "online")) {
+            online = parse_cpu_list(*line);
+        }
+    } catch (const ValidationError&) {
+        online.clear();
+    }
+    if (online.empty()) {
+        unsigned int n = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned int i = 0; i < n; ++i) {
+            online.push_back(static_cast<int>(i));
+        }
+    }
+
+    // cpu -> node from /sys/devices/system/node/nodeN/cpulist
+    std::map<int, int> node_of;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(kNodeRoot, ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0 || name.size() <= 4) {
+            continue;
+        }
+        int node = -1;
+        auto [ptr, err] = std::from_chars(name.data() + 4, name.data() + name.size(), node);
+        if (err != std::errc{} || ptr != name.data() + name.size()) {
+            continue;
+        }
+        try {
+            if (auto line = read_line(entry.path() / "cpulist")) {
+                for (int cpu : parse_cpu_list(*line)) {
+                    node_of[cpu] = node;
+                }
+            }
+        } catch (const ValidationError&) {
+            // Unreadable node: its CPUs default to node 0
+        }
+    }
+
+    CpuTopology topology;
+    for (int id : online) {
+        if (have_mask && !allowed(mask, id)) {
+            continue;
+        }
+        const fs::path topo = kCpuRoot / utils::format("cpu{}", id) / "topology";
+        Cpu cpu;
+        cpu.id = id;
+        cpu.core_id = read_int(topo / "core_id", id);
+        cpu.package_id = read_int(topo / "physical_package_id", 0);
+        auto it = node_of.find(id);
+        cpu.numa_node = it != node_of.end() ? it->second : 0;
+        topology.cpus.push_back(cpu);
+    }
+    return topology;
+}
+
+int CpuTopology::numa_node_of(int cpu) const
+{
+    auto it = std::find_if(cpus.begin(), cpus.end(), [cpu](const Cpu& c) { return c.id == cpu; });
+    return it != cpus.end() ? it->numa_node : 0;
+}
+
+std::size_t CpuTopology::numa_node_count() const
+{
+    std::set<int> nodes;
+    for (const auto& cpu : cpus) {
+        nodes.insert(cpu.numa_node);
+    }
+    return nodes.size();
+}
+
+CpuPlacement::CpuPlacement(Policy policy, const CpuTopology& topology, std::vector<int> explicit_cpus)
+    : policy_(policy)
+{
+    switch (policy) {
+        case Policy::None:
+            return;
+
+        case Policy::Compact:
+            for (const auto& [node, cpus] : compact_by_node(topology)) {
+                order_.insert(order_.end(), cpus.begin(), cpus.end());
+            }
+            break;
+
+        case Policy::Scatter: {
+            // Take the next CPU of each node in turn
+            auto by_node = compact_by_node(topology);
+            for (std::size_t i = 0; order_.size() < topology.cpus.size(); ++i) {
+                for (const auto& [node, cpus] : by_node) {
+                    if (i < cpus.size()) {
+                        order_.push_back(cpus[i]);
+                    }
+                }
+            }
+            break;
+        }
+
+        case Policy::Explicit:
+            if (explicit_cpus.empty()) {
+                throw ValidationError("Explicit CPU affinity requires a CPU list");
+            }
+            for (int cpu : explicit_cpus) {
+                auto it = std::find_if(topology.cpus.begin(), topology.cpus.end(),
+                                       [cpu](const Cpu& c) { return c.id == cpu; });
+                if (it == topology.cpus.end()) {
+                    throw ValidationError(utils::format(
+                        "CPU {} is not online or not in this process's affinity mask", cpu));
+                }
+            }
+            order_ = std::move(explicit_cpus);
+            break;
+    }
+
+    nodes_.reserve(order_.size());
+    for (int cpu : order_) {
+        nodes_.push_back(topology.numa_node_of(cpu));
+    }
+}
+
+std::optional<int> CpuPlacement::cpu_for(std::size_t slot) const
+{
+    if (order_.empty()) {
+        return std::nullopt;
+    }
+    return order_[slot % order_.size()];
+}
+
+std::optional<int> CpuPlacement::numa_node_for(std::size_t slot) const
+{
+    if (nodes_.empty()) {
+        return std::nullopt;
+    }
+    return nodes_[slot % nodes_.size()];
+}
+
+bool CpuPlacement::pin_current_thread(std::size_t slot) const
+{
+    return pin_thread(pthread_self(), slot);
+}
+
+bool CpuPlacement::pin_thread(std::thread::native_handle_type handle, std::size_t slot) const
+{
+    auto cpu = cpu_for(slot);
+    if (!cpu) {
+        return false;
+    }
+    if (!set_affinity(handle, *cpu)) {
+        LOG_WARN_F("Affinity: could not pin thread slot {} to CPU {}", slot, *cpu);
+        return false;
+    }
+    LOG_DEBUG_F("Affinity: thread slot {} pinned to CPU {} (node {})", slot, *cpu, *numa_node_for(slot));
+    return true;
+}
+
+std::string CpuPlacement::describe() const
+{
+    static constexpr const char* kNames[] = {"none", "compact", "scatter", "explicit"};
+    std::string out = kNames[static_cast<std::size_t>(policy_)];
+    if (order_.empty()) {
+        return out;
+    }
+
+    // One group per run of CPUs on the same node
+    out += ": ";
+    for (std::size_t i = 0; i < order_.size(); ++i) {
+        const bool new_group = i == 0 || nodes_[i] != nodes_[i - 1];
+        if (new_group && i != 0) {
+            out += utils::format(" (node {}), ", nodes_[i - 1]);
+        } else if (!new_group) {
+            out += ",";
+        }
+        out += std::to_string(order_[i]);
+    }
+    out += utils::format(" (node {})", nodes_.back());
+    return out;
+}
+
+} // namespace vcf_tool::core::affinity
@@ -0,0 +1,316 @@
+#include <vcf_tool/core/Metrics.h>
+#include <vcf_tool/utils/Json.h>
+#include <vcf_tool/utils/Logger.h>
+#include <vcf_tool/utils/Format.h>
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+
+namespace vcf_tool::core::metrics {
+
+std::size_t shard_index() noexcept
+{
+    static std::atomic<std::size_t> next{0};
+    thread_local const std::size_t index =
+        next.fetch_add(1, std::memory_order_relaxed) % kShards;
+    return index;
+}
+
+// ---------- Counter / Histogram ----------
+
+std::uint64_t Counter::value() const noexcept
+{
+    std::uint64_t total = 0;
+    for (const auto& shard : shards_) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+Histogram::Snapshot Histogram::snapshot() const noexcept
+{
+    Snapshot snap;
+    for (const auto& shard : shards_) {
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            auto n = shard.buckets[i].load(std::memory_order_relaxed);
+            snap.buckets[i] += n;
+            snap.count += n;
+        }
+        snap.sum += shard.sum.load(std::memory_order_relaxed);
+        snap.max = std::max(snap.max, shard.max.load(std::memory_order_relaxed));
+    }
+    return snap;
+}
+
+std::uint64_t Histogram::Snapshot::quantile(double q) const noexcept
+{
+    if (count == 0) {
+        return 0;
+    }
+
+    auto rank = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count)));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+        seen += buckets[i];
+        if (seen >= rank && buckets[i] > 0) {
+            // Upper bound of bucket i is 2^i - 1, capped by the observed max
+            std::uint64_t upper = i == 0 ? 0 : (i >= 64 ? max : (std::uint64_t{1} << i) - 1);
+            return std::min(upper, max);
+        }
+    }
+    return max;
+}
+
+// ---------- MetricsRegistry ----------
+
+MetricsRegistry::Entry* MetricsRegistry::find(const std::string& name, Kind kind)
+{
+    for (auto& entry : entries_) {
+        if (entry->name != name) {
+            continue;
+        }
+        if (entry->kind != kind) {
+            throw std::logic_error(utils::format(
+                "Metric '{}' is already registered as a different kind", name));
+        }
+        return entry.get();
+    }
+    return nullptr;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help)
+{
+    std::scoped_lock lock(mutex_);
+    if (auto* existing = find(name, Kind::Counter)) {
+        return *existing->counter;
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->name = name;
+    entry->help = help;
+    entry->kind = Kind::Counter;
+    entry->counter = std::make_unique<Counter>();
+    auto& ref = *entry->counter;
+    entries_.push_back(std::move(entry));
+    return ref;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help)
+{
+    std::scoped_lock lock(mutex_);
+    if (auto* existing = find(name, Kind::Gauge)) {
+        return *existing->gauge;
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->name = name;
+    entry->help = help;
+    entry->kind = Kind::Gauge;
+    entry->gauge = std::make_unique<Gauge>();
+    auto& ref = *entry->gauge;
+    entries_.push_back(std::move(entry));
+    return ref;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                      double unit_scale)
+{
+    std::scoped_lock lock(mutex_);
+    if (auto* existing = find(name, Kind::Histogram)) {
+        return *existing->histogram;
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->name = name;
+    entry->help = help;
+    entry->kind = Kind::Histogram;
+    entry->histogram = std::make_unique<Histogram>(unit_scale);
+    auto& ref = *entry->histogram;
+    entries_.push_back(std::move(entry));
+    return ref;
+}
+
+void MetricsRegistry::gauge_callback(const std::string& name, const std::string& help,
+                                     std::function<double()> fn)
+{
+    std::scoped_lock lock(mutex_);
+    if (auto* existing = find(name, Kind::GaugeCallback)) {
+        existing->callback = std::move(fn);
+        return;
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->name = name;
+    entry->help = help;
+    entry->kind = Kind::GaugeCallback;
+    entry->callback = std::move(fn);
+    entries_.push_back(std::move(entry));
+}
+
+std::string MetricsRegistry::to_prometheus() const
+{
+    std::scoped_lock lock(mutex_);
+    std::string out;
+    out.reserve(entries_.size() * 256);
+
+    for (const auto& entry : entries_) {
+        out += utils::format("# HELP {} {}\n", entry->name, entry->help);
+
+        switch (entry->kind) {
+            case Kind::Counter:
+                out += utils::format("# TYPE {} counter\n{} {}\n",
+                                     entry->name, entry->name, entry->counter->value());
+                break;
+
+            case Kind::Gauge:
+                out += utils::format("# TYPE {} gauge\n{} {}\n",
+                                     entry->name, entry->name, entry->gauge->value());
+                break;
+
+            case Kind::GaugeCallback:
+                out += utils::format("# TYPE {} gauge\n{} {}\n",
+                                     entry->name, entry->name, entry->callback());
+                break;
+
+            case Kind::Histogram: {
+                auto snap = entry->histogram->snapshot();
+                double scale = entry->histogram->unit_scale();
+                out += utils::format("# TYPE {} histogram\n", entry->name);
+
+                // Cumulative buckets over the non-empty range only
+                std::size_t first = Histogram::kBuckets;
+                std::size_t last = 0;
+                for (std::size_t i = 0; i < Histogram::kBuckets; ++i) {
+                    if (snap.buckets[i] > 0) {
+                        first = std::min(first, i);
+                        last = i;
+                    }
+                }
+                std::uint64_t cumulative = 0;
+                for (std::size_t i = first; i <= last; ++i) {
+                    cumulative += snap.buckets[i];
+                    double upper = std::ldexp(1.0, static_cast<int>(i)) * scale;
+                    out += utils::format("{}_bucket{{le=\"{}\"}} {}\n", entry->name, upper, cumulative);
+                }
+                out += utils::format("{}_bucket{{le=\"+Inf\"}} {}\n", entry->name, snap.count);
+                out += utils::format("{}_sum {}\n", entry->name, static_cast<double>(snap.sum) * scale);
+                out += utils::format("{}_count {}\n", entry->name, snap.count);
+                break;
+            }
+        }
+    }
+
+    return out;
+}
+
+std::string MetricsRegistry::to_json() const
+{
+    std::scoped_lock lock(mutex_);
+
+    auto counters = utils::Json::object();
+    auto gauges = utils::Json::object();
+    auto histograms = utils::Json::object();
+
+    for (const auto& entry : entries_) {
+        switch (entry->kind) {
+            case Kind::Counter:
+                counters[entry->name] = entry->counter->value();
+                break;
+
+            case Kind::Gauge:
+                gauges[entry->name] = entry->gauge->value();
+                break;
+
+            case Kind::GaugeCallback:
+                gauges[entry->name] = entry->callback();
+                break;
+
+            case Kind::Histogram: {
+                auto snap = entry->histogram->snapshot();
+                double scale = entry->histogram->unit_scale();
+                auto h = utils::Json::object();
+                h["count"] = snap.count;
+                h["sum"]   = static_cast<double>(snap.sum) * scale;
+                h["mean"]  = snap.mean() * scale;
+                h["p50"]   = static_cast<double>(snap.quantile(0.50)) * scale;
+                h["p90"]   = static_cast<double>(snap.quantile(0.90)) * scale;
+                h["p99"]   = static_cast<double>(snap.quantile(0.99)) * scale;
+                h["max"]   = static_cast<double>(snap.max) * scale;
+                histograms[entry->name] = std::move(h);
+                break;
+            }
+        }
+    }
+
+    auto json = utils::Json::object();
+    json["counters"] = std::move(counters);
+    json["gauges"] = std::move(gauges);
+    json["histograms"] = std::move(histograms);
+    return utils::Json::to_string(json, 2);
+}
+
+void MetricsRegistry::write_prometheus_file(const std::string& path) const
+{
+    const std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path);
+        if (!out.is_open()) {
+            throw std::runtime_error("Failed to open metrics file for writing: " + tmp_path);
+        }
+        out << to_prometheus();
+    }
+    std::filesystem::rename(tmp_path, path);
+}
+
+// ---------- MetricsExporter ----------
+
+MetricsExporter::MetricsExporter(const MetricsRegistry& registry,
+                                 std::string path,
+                                 std::chrono::milliseconds interval)
+    : registry_(registry)
+    , path_(std::move(path))
+    , interval_(interval)
+    , thread_([this](std::stop_token st) {
+        run(st);
+      })
+{
+}
+
+MetricsExporter::~MetricsExporter()
+{
+    thread_.request_stop();
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    write();  // Final values
+}
+
+void MetricsExporter::run(std::stop_token st)
+{
+    while (!st.stop_requested()) {
+        {
+            std::unique_lock lock(mutex_);
+            // Returns early when stop is requested
+            cv_.wait_for(lock, st, interval_, [] { return false; });
+        }
+        if (st.stop_requested()) {
+            break;
+        }
+        write();
+    }
+}
+
+void MetricsExporter::write() const
+{
+    try {
+        registry_.write_prometheus_file(path_);
+    } catch (const std::exception& e) {
+        LOG_WARN_F("Metrics export to '{}' failed: {}", path_, e.what());
+    }
+}
+
+} // namespace vcf_tool::core::metrics
@@ -97,8 +97,26 @@ mongocxx::database MongoDatabase::get_database() {
 }
 
 mongocxx::collection MongoDatabase::get_collection() {
+    return get_collection(config_.collection_name);
+}
+
+mongocxx::collection MongoDatabase::get_collection(const std::string& name) {
     auto client = pool_->acquire();
-    return (*client)[config_.db_name][config_.collection_name];
+    return (*client)[config_.db_name][name];
+}
+
+void MongoDatabase::drop_collection(const std::string& name) {
+    try {
+        auto client = pool_->acquire();
+        (*client)[config_.db_name][name].drop();
+        LOG_DEBUG_F("Dropped collection: {}", name);
+
+    } catch (const mongocxx::exception& e) {
+        throw utils::errors::DatabaseError(
+            utils::format("Failed to drop collection '{}': {}", name, e.what()),
+            utils::errors::Component::Database
+        );
+    }
 }
 
 } // namespace vcf_tool::core
@@ -4,6 +4,16 @@
 namespace vcf_tool::core {
 
 ThreadPool::ThreadPool(std::size_t thread_count)
+{
+    start_workers(thread_count, nullptr);
+}
+
+ThreadPool::ThreadPool(std::size_t thread_count, std::function<void(std::size_t)> on_thread_start)
+{
+    start_workers(thread_count, std::move(on_thread_start));
+}
+
+void ThreadPool::start_workers(std::size_t thread_count, std::function<void(std::size_t)> on_thread_start)
 {
     if (thread_count == 0) {
         thread_count = 1;
@@ -12,7 +22,10 @@ ThreadPool::ThreadPool(std::size_t thread_count)
     workers_.reserve(thread_count);
     for (std::size_t i = 0; i < thread_count; ++i) {
         workers_.emplace_back(
-            [this](std::stop_token st) {
+            [this, i, on_thread_start](std::stop_token st) {
+                if (on_thread_start) {
+                    on_thread_start(i);
+                }
                 worker_loop(st);
             }
         );
@@ -0,0 +1,167 @@
+#include <vcf_tool/core/Tracer.h>
+#include <vcf_tool/utils/Errors.h>
+#include <vcf_tool/utils/Format.h>
+
+#include <algorithm>
+#include <fstream>
+
+
+namespace vcf_tool::core::trace {
+
+struct Tracer::ThreadBuffer {
+    std::uint32_t tid{0};
+    std::string name;
+    std::vector<Event> ring;
+    std::uint64_t written{0};          // Total events recorded (owner thread only)
+    std::atomic<bool> retired{false};  // Owner thread has exited
+};
+
+namespace {
+
+// Marks the calling thread's buffer as retired when the thread exits, so
+// the next start() can reclaim it
+struct LocalHandle {
+    std::atomic<bool>* retired{nullptr};
+    void* buffer{nullptr};
+
+    ~LocalHandle() {
+        if (retired) {
+            retired->store(true, std::memory_order_release);
+        }
+    }
+};
+
+thread_local LocalHandle local_handle;
+
+std::int64_t steady_now_ns() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+Tracer& Tracer::instance()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::~Tracer()
+{
+    enabled_.store(false, std::memory_order_relaxed);
+}
+
+std::uint64_t Tracer::now_ns() noexcept
+{
+    return static_cast<std::uint64_t>(steady_now_ns() - epoch_ns_.load(std::memory_order_relaxed));
+}
+
+void Tracer::start(std::size_t events_per_thread)
+{
+    std::scoped_lock lock(mutex_);
+    capacity_ = std::max<std::size_t>(events_per_thread, 1);
+
+    // Buffers of exited threads can go; live threads keep theirs (emptied)
+    std::erase_if(buffers_, [](const auto& buffer) {
+        return buffer->retired.load(std::memory_order_acquire);
+    });
+    for (auto& buffer : buffers_) {
+        buffer->ring.assign(capacity_, Event{});
+        buffer->written = 0;
+    }
+
+    epoch_ns_.store(steady_now_ns(), std::memory_order_relaxed);
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::stop()
+{
+    enabled_.store(false, std::memory_order_relaxed);
+}
+
+Tracer::ThreadBuffer& Tracer::local_buffer()
+{
+    if (local_handle.buffer == nullptr) {
+        auto buffer = std::make_unique<ThreadBuffer>();
+
+        std::scoped_lock lock(mutex_);
+        buffer->tid = next_tid_++;
+        buffer->ring.assign(capacity_, Event{});
+        local_handle.retired = &buffer->retired;
+        local_handle.buffer = buffer.get();
+        buffers_.push_back(std::move(buffer));
+    }
+    return *static_cast<ThreadBuffer*>(local_handle.buffer);
+}
+
+void Tracer::set_thread_name(std::string name)
+{
+    if (!enabled()) {
+        return;
+    }
+    local_buffer().name = std::move(name);
+}
+
+void Tracer::record(const Event& event) noexcept
+{
+    auto& buffer = local_buffer();
+    buffer.ring[buffer.written % buffer.ring.size()] = event;
+    ++buffer.written;
+}
+
+void Tracer::write_chrome_trace(const std::string& path) const
+{
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        throw utils::errors::IOError("Failed to open trace file for writing: " + path);
+    }
+
+    std::scoped_lock lock(mutex_);
+    std::uint64_t dropped = 0;
+    bool first = true;
+
+    auto separator = [&first]() -> const char* {
+        if (first) {
+            first = false;
+            return "\n";
+        }
+        return ",\n";
+    };
+
+    out << "{\"traceEvents\":[";
+
+    for (const auto& buffer : buffers_) {
+        if (buffer->written == 0) {
+            continue;
+        }
+
+        out << separator()
+            << utils::format(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"{}"}}}})",
+                             buffer->tid, buffer->name.empty() ? "thread" : buffer->name);
+
+        // Oldest surviving event first
+        std::size_t size = buffer->ring.size();
+        std::uint64_t count = std::min<std::uint64_t>(buffer->written, size);
+        std::uint64_t begin = buffer->written - count;
+        dropped += begin;
+
+        for (std::uint64_t i = begin; i < buffer->written; ++i) {
+            const auto& e = buffer->ring[i % size];
+            out << separator()
+                << utils::format(R"({{"name":"{}","cat":"{}","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f},"args":{{"n":{}}}}})",
+                                 e.name, e.category, buffer->tid,
+                                 static_cast<double>(e.start_ns) / 1000.0,
+                                 static_cast<double>(e.dur_ns) / 1000.0,
+                                 e.arg);
+        }
+    }
+
+    out << utils::format("\n],\"displayTimeUnit\":\"ms\",\"otherData\":{{\"dropped_events\":{}}}}}\n", dropped);
+
+    if (!out) {
+        throw utils::errors::IOError("Failed to write trace file: " + path);
+    }
+}
+
+} // namespace vcf_tool::core::trace
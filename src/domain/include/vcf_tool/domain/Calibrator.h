@@ -0,0 +1,115 @@
+// Calibrator.h
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <vcf_tool/domain/VcfTool.h>
+#include <vcf_tool/domain/VcfToolBuilder.h>
+
+
+namespace vcf_tool::domain::api {
+
+/**
+ * @brief Settings for a calibration run
+ */
+struct CalibrationOptions {
+    std::size_t sample_records{200'000};  // Data lines copied from the input for trials
+    std::size_t max_trials{30};           // Upper bound on timed trial imports
+    std::size_t repeats{1};               // Runs per trial (best one counts)
+    double min_improvement{0.03};         // Relative gain required to move (filters noise)
+    SinkType sink{SinkType::Null};        // Sink the trials write to
+    FakeSinkOptions fake_sink;            // Used when sink == Fake
+    std::string collection;               // Target MongoDB collection (empty = the configured one)
+    std::string work_dir;                 // Where the sample is written (empty = temp dir)
+
+    // Features the trials run with (samples, field projections, filter,
+    // split, dedup, max errors, affinity, ...) and the starting sizing. Each
+    // trial replaces its sizing and sink; leave checkpointing, metrics,
+    // progress and trace outputs off.
+    VcfToolBuilder workload;
+};
+
+/**
+ * @brief One timed trial import
+ */
+struct CalibrationTrial {
+    PipelineProfile profile;
+    double records_per_sec{0.0};
+};
+
+/**
+ * @brief Outcome of a calibration run
+ */
+struct CalibrationResult {
+    PipelineProfile best;
+    double records_per_sec{0.0};           // Throughput of `best`
+    double start_records_per_sec{0.0};     // Throughput of the starting (default) profile
+    std::size_t sample_records{0};
+    std::vector<CalibrationTrial> trials;  // In execution order
+
+    /**
+     * Write the best profile as a JSON config (loadable with
+     * VcfToolBuilder::from_config), plus a "calibration" section
+     * describing how it was obtained.
+     *
+     * @throws IOError if the file cannot be written
+     */
+    void save_profile(const std::string& path) const;
+};
+
+/**
+ * @brief Derives pipeline sizing parameters from short trial imports
+ *
+ * Copies the header and the first `sample_records` data lines of the input
+ * to a temporary sample, then hill-climbs over parser threads, batch size
+ * and both queue capacities: each round times the neighbours of the current
+ * profile (threads +/- a step, sizes doubled / halved) and moves to the best
+ * one if it beats the current throughput by `min_improvement`. Stops when
+ * no neighbour improves or `max_trials` is reached. Results are cached, so
+ * a profile is never timed twice.
+ *
+ * Trials run the configured `workload`, so a profile is tuned for the same
+ * per-record work as the import it is meant for, against the chosen sink.
+ * With MongoDB, they write to a scratch collection next to the target
+ * ("<collection>_calibration"), dropped after every trial import, so the
+ * target never receives the sample.
+ *
+ * Usage:
+ *   CalibrationOptions options;
+ *   options.sink = SinkType::Fake;
+ *   options.workload.with_filter("QUAL>=30").with_multiallelic_split();
+ *   Calibrator calibrator(options);
+ *   auto result = calibrator.run("input.vcf");
+ *   result.save_profile("profile.json");
+ *   auto tool = VcfToolBuilder::from_config(config_loaded_from("profile.json")).build();
+ */
+class Calibrator {
+public:
+    /**
+     * @throws ValidationError if a sample size, trial or repeat count is 0
+     * @throws DatabaseError for the MongoDB sink if MongoDatabase is not initialized
+     */
+    explicit Calibrator(CalibrationOptions options = {});
+
+    /**
+     * Calibrate on a sample of `file_path`.
+     *
+     * @throws ValidationError / FileNotFoundError if the input is unusable
+     * @throws IOError if the sample cannot be written
+     */
+    CalibrationResult run(const std::string& file_path);
+
+private:
+    // Timed import of the sample with `profile` (best of `repeats`)
+    double measure(const std::string& sample_path, std::size_t records, const PipelineProfile& profile) const;
+
+    // Remove what trials wrote to the scratch collection (MongoDB only)
+    void drop_scratch() const;
+
+    CalibrationOptions options_;
+    std::string scratch_collection_;  // MongoDB trials write here (empty for other sinks)
+};
+
+} // namespace vcf_tool::domain::api
@@ -0,0 +1,53 @@
+// Progress.h
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+
+namespace vcf_tool::domain::api {
+
+/**
+ * @brief Snapshot of a running import
+ *
+ * Produced periodically by the pipeline's progress reporter and handed to
+ * the callback passed to VcfTool::run. Rates cover the last reporting
+ * interval (the whole run in the final report); the ETA uses the average
+ * input rate since the run started.
+ */
+struct Progress {
+    std::uint64_t bytes_read{0};       // Input offset reached by the reader
+    std::uint64_t total_bytes{0};      // Input file size
+    std::uint64_t lines_read{0};
+    std::uint64_t records_written{0};
+
+    double records_per_sec{0.0};       // Records written per second (last interval)
+    double mb_per_sec{0.0};            // Input MB read per second (last interval)
+
+    std::size_t line_queue_depth{0};
+    std::size_t line_queue_capacity{0};
+    std::size_t record_queue_depth{0};
+    std::size_t record_queue_capacity{0};
+
+    std::chrono::milliseconds elapsed{0};
+    std::optional<std::chrono::seconds> eta;  // std::nullopt until it can be estimated
+    bool finished{false};                     // Final report of the run
+    bool failed{false};                       // Final report of a run that stopped on an error
+
+    /// Fraction of the input read so far, in [0, 1]
+    double fraction() const {
+        if (total_bytes == 0) {
+            return finished && !failed ? 1.0 : 0.0;
+        }
+        double f = static_cast<double>(bytes_read) / static_cast<double>(total_bytes);
+        return f > 1.0 ? 1.0 : f;
+    }
+};
+
+/// Invoked from the reporter thread; must be cheap and thread-safe
+using ProgressCallback = std::function<void(const Progress&)>;
+
+} // namespace vcf_tool::domain::api
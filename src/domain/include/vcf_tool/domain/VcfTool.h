@@ -3,7 +3,10 @@
 
 #include <string>
 #include <cstddef>
+#include <cstdint>
+#include <chrono>
 
+#include <vcf_tool/domain/Progress.h>
 
 
 namespace vcf_tool::domain::api {
@@ -11,6 +14,48 @@ namespace vcf_tool::domain::api {
 // Forward declaration
 class VcfToolBuilder;
 
+/**
+ * @brief Where parsed records are written
+ */
+enum class SinkType {
+    Mongo,  // MongoDB (requires MongoDatabase::initialize())
+    Null,   // Discard records, skip encoding (parse-only dry run)
+    Fake    // In-process fake database (latency / failure injection)
+};
+
+/**
+ * @brief Behaviour of the in-process fake database (SinkType::Fake)
+ *
+ * Each batch write sleeps `latency` plus a uniform random delay in
+ * [0, latency_jitter], then fails with probability `failure_rate`.
+ */
+struct FakeSinkOptions {
+    std::chrono::microseconds latency{0};
+    std::chrono::microseconds latency_jitter{0};
+    double failure_rate{0.0};      // 0.0 - 1.0
+    std::uint64_t seed{42};        // RNG seed for jitter and failures
+    bool keep_documents{false};    // Retain written documents (tests only)
+};
+
+/**
+ * @brief CPU pinning of the reader, writer, parser and encode threads
+ */
+enum class AffinityPolicy {
+    None,     // OS scheduler decides
+    Compact,  // Fill one NUMA node's CPUs (physical cores first) before the next
+    Scatter,  // Spread threads round-robin across NUMA nodes
+    Explicit  // Use a given CPU list in order
+};
+
+/**
+ * @brief Dropping of records repeating an earlier CHROM/POS/REF/ALT
+ */
+enum class DedupMode {
+    Off,       // Every record is written
+    Unsorted,  // Any input order; keeps every record's key for the run
+    Sorted     // Input sorted by chromosome; keeps only the current chromosomes' keys
+};
+
 /**
  * @brief Public API for VCF file processing
  *
@@ -30,6 +75,9 @@ class VcfToolBuilder;
  *   - 1 reader thread (jthread)
  *   - N parser threads (from ThreadPool)
  *   - 1 writer thread (jthread)
+ * plus N range workers that help parse very wide lines (see
+ * VcfToolBuilder::with_wide_line_split), idle otherwise. They are started
+ * by the first input with sample columns to decode.
  */
 class VcfTool {
 public:
@@ -43,6 +91,63 @@ public:
         std::size_t batch_size;
         std::size_t line_queue_capacity;
         std::size_t record_queue_capacity;
+
+        // Checkpointing (see VcfToolBuilder::with_checkpoint / with_resume)
+        bool checkpointing{false};
+        std::string checkpoint_path;  // empty = "<input>.checkpoint"
+        std::chrono::milliseconds checkpoint_interval{5000};
+        bool resume{false};
+
+        // Metrics export (see VcfToolBuilder::with_metrics_file / with_metrics_summary)
+        std::string metrics_file;     // empty = no periodic Prometheus export
+        std::chrono::milliseconds metrics_interval{5000};
+        std::string metrics_summary;  // empty = no JSON summary
+
+        // Progress logging interval (0 = no progress log lines)
+        std::chrono::milliseconds progress_interval{0};
+
+        // Chrome trace-event output (empty = tracing off)
+        std::string trace_out;
+
+        // Record sink and write retries (see VcfToolBuilder::with_dry_run / with_fake_sink /
+        // with_collection)
+        SinkType sink{SinkType::Mongo};
+        FakeSinkOptions fake_sink;
+        std::string collection;
+        std::size_t write_retries{3};
+        std::chrono::milliseconds retry_backoff{100};
+
+        // Adaptive parser concurrency (see VcfToolBuilder::with_adaptive_parsers)
+        bool adaptive_parsers{false};
+        std::size_t min_parsers{1};
+
+        // CPU pinning (see VcfToolBuilder::with_affinity)
+        AffinityPolicy affinity{AffinityPolicy::None};
+        std::string affinity_cpus;  // CPU list for AffinityPolicy::Explicit
+
+        // Sample columns of lines at least this long are parsed in concurrent
+        // ranges (see VcfToolBuilder::with_wide_line_split; 0 = never)
+        std::size_t wide_line_bytes{0};
+
+        // Sample columns to keep (see VcfToolBuilder::with_samples; empty = all)
+        std::string samples;
+
+        // INFO / FORMAT keys to keep (see VcfToolBuilder::with_info_fields; empty = all)
+        std::string info_fields;
+        std::string format_fields;
+
+        // Records to keep (see VcfToolBuilder::with_filter; empty = all)
+        std::string filter;
+
+        // Malformed lines tolerated (see VcfToolBuilder::with_max_errors; 0 = the first fails the run)
+        std::size_t max_errors{0};
+        std::string reject_file;  // empty = "<input>.rejects"
+
+        // One record per ALT allele (see VcfToolBuilder::with_multiallelic_split)
+        bool split_multiallelic{false};
+
+        // Duplicate records dropped (see VcfToolBuilder::with_dedup)
+        DedupMode dedup{DedupMode::Off};
     };
 
     /**
@@ -54,6 +159,20 @@ public:
      */
     void run(const std::string& file_path);
 
+    /**
+     * Process a VCF file, reporting progress to `on_progress`.
+     *
+     * The callback runs on a background reporter thread every progress
+     * interval (every second if no interval is configured) and once more
+     * with `finished = true` when the import ends (`failed = true` too if
+     * it ends on an error).
+     *
+     * @param file_path    Path to VCF file to process
+     * @param on_progress  Progress consumer (must be thread-safe and cheap)
+     * @throws std::exception  If file doesn't exist or processing fails
+     */
+    void run(const std::string& file_path, ProgressCallback on_progress);
+
     // Accessors for current configuration
     std::size_t parser_count() const { return config_.parser_count; }
     std::size_t batch_size() const { return config_.batch_size; }
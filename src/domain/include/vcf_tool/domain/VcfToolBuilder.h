@@ -2,12 +2,30 @@
 #pragma once
 
 #include <cstddef>
+#include <chrono>
+#include <string>
 
+#include <vcf_tool/domain/VcfTool.h>
+
+
+namespace vcf_tool::core {
+class Config;
+} // namespace vcf_tool::core
 
 namespace vcf_tool::domain::api {
 
-// Forward declaration
-class VcfTool;
+/**
+ * @brief Pipeline sizing parameters (what --calibrate tunes)
+ *
+ * Stored in profile JSON files under the keys "parser_threads",
+ * "batch_size", "line_queue_capacity" and "record_queue_capacity".
+ */
+struct PipelineProfile {
+    std::size_t parser_threads{0};  // 0 = auto-detect
+    std::size_t batch_size{1000};
+    std::size_t line_queue_capacity{20000};
+    std::size_t record_queue_capacity{10000};
+};
 
 /**
  * @brief Builder for VcfTool with fluent API and validation
@@ -34,10 +52,117 @@ public:
     VcfToolBuilder& with_line_queue_capacity(std::size_t n);
     VcfToolBuilder& with_record_queue_capacity(std::size_t n);
 
+    // Checkpointing: persist the committed input position so a crashed or
+    // interrupted import can continue where it left off.
+    // Empty path = sidecar file "<input>.checkpoint".
+    VcfToolBuilder& with_checkpoint(std::string path = {});
+    VcfToolBuilder& with_checkpoint_interval(std::chrono::milliseconds interval);
+    // Resume from the checkpoint if one exists (implies with_checkpoint)
+    VcfToolBuilder& with_resume(bool resume = true);
+
+    // Metrics: per-stage counters and latency histograms.
+    // Periodically rewrite a Prometheus text file (node_exporter textfile collector)
+    VcfToolBuilder& with_metrics_file(std::string path);
+    VcfToolBuilder& with_metrics_interval(std::chrono::milliseconds interval);
+    // Write a JSON summary of all metrics when the import finishes
+    VcfToolBuilder& with_metrics_summary(std::string path);
+
+    // Log throughput, queue fill levels and ETA every `interval` (0 = off)
+    VcfToolBuilder& with_progress_interval(std::chrono::milliseconds interval);
+
+    // Record reader / parser / writer spans and write them to `path` as a
+    // Chrome trace-event timeline at the end of each run
+    VcfToolBuilder& with_trace_output(std::string path);
+
+    // Record sink. Default: MongoDB.
+    // Dry run: parse everything but encode and store nothing
+    VcfToolBuilder& with_dry_run(bool dry_run = true);
+    // Write to an in-process fake database with injected latency / failures
+    VcfToolBuilder& with_fake_sink(FakeSinkOptions options = {});
+    // MongoDB collection the records go to. Default: the connection's
+    // (MONGODB_COLLECTION_NAME)
+    VcfToolBuilder& with_collection(std::string name);
+    // Retry a failed batch write up to `retries` times, doubling `backoff` each time
+    VcfToolBuilder& with_write_retries(std::size_t retries,
+                                       std::chrono::milliseconds backoff = std::chrono::milliseconds(100));
+
+    // Adapt the number of active parsers at runtime between `min_parsers` and
+    // the parser thread count, based on queue depths and stage utilization;
+    // cores of parked parsers encode batches for the writer
+    VcfToolBuilder& with_adaptive_parsers(std::size_t min_parsers = 1);
+
+    // Pin reader, writer, parser and encode threads to CPUs, in slot order
+    // reader, writer, parsers, encode workers. Compact takes the CPUs of one
+    // NUMA node (physical cores first) before the next; Scatter alternates
+    // nodes; Explicit takes a CPU list ("0-3,8"). Parsers on the same NUMA
+    // node then share a pool of chunk arenas allocated on that node; the
+    // queues and the line buffer pool (filled by the reader) stay shared.
+    VcfToolBuilder& with_affinity(AffinityPolicy policy, std::string cpu_list = {});
+
+    // Lines whose sample columns take at least `min_bytes` (large cohorts) are
+    // cut into ranges parsed concurrently on a helper pool, so a single wide
+    // line doesn't keep one parser busy while the others idle. 0 = never split.
+    // The pool is only started for input with sample columns to decode.
+    // Default: 1 MiB.
+    VcfToolBuilder& with_wide_line_split(std::size_t min_bytes);
+
+    // Keep only some sample columns: a comma-separated list of #CHROM names,
+    // or a file with one name per line; a leading '^' keeps all but those.
+    // Unselected columns are skipped unparsed. Default: all samples.
+    VcfToolBuilder& with_samples(std::string spec);
+
+    // Keep only some INFO / FORMAT keys: a comma-separated list ("AF,DP"), or
+    // with a leading '^' all keys but those ("^CSQ,ANN"). Dropped keys are
+    // skipped by the parsers without being converted or stored.
+    // Default: all keys.
+    VcfToolBuilder& with_info_fields(std::string spec);
+    VcfToolBuilder& with_format_fields(std::string spec);
+
+    // Keep only records matching `expression`, evaluated by the parsers on
+    // the fixed columns before INFO / FORMAT are decoded, e.g.
+    //   FILTER=="PASS" && QUAL>=30 && INFO.AF>0.01 && CHROM in (chr1,chr2)
+    // Fields: CHROM, POS, REF, ALT, QUAL, FILTER, INFO.<key>; operators
+    // == != < <= > >= in && || ! and parentheses. With multiallelic split
+    // it is evaluated on each biallelic part after decoding instead, and the
+    // INFO keys it tests must be kept by with_info_fields. Default: keep all.
+    VcfToolBuilder& with_filter(std::string expression);
+
+    // Lenient parsing: skip up to `max_errors` malformed lines instead of
+    // failing on the first. Each is written with its line number and reason
+    // to `reject_file` (empty = sidecar file "<input>.rejects") and counted
+    // per category (vcf_parser_malformed_*_total). One more fails the run.
+    // Default: 0 (strict).
+    VcfToolBuilder& with_max_errors(std::size_t max_errors, std::string reject_file = {});
+
+    // Split each multiallelic record into one record per ALT allele, with
+    // Number=A/R/G INFO / FORMAT values subset and GT recoded to match, and
+    // trim the bases REF and ALT share (POS adjusted). Done by the parsers
+    // as records are decoded. Default: off (records are written as read).
+    VcfToolBuilder& with_multiallelic_split(bool split = true);
+
+    // Drop records whose CHROM, POS, REF and ALT repeat an earlier record's
+    // (after splitting, if enabled), before they are decoded or encoded;
+    // counted in vcf_parser_duplicate_records_total. Sorted bounds memory to
+    // the chromosomes in flight but misses duplicates across the blocks of
+    // a chromosome that reappears. Not allowed with resume: the keys of the
+    // lines skipped on resume are unknown. Default: Off.
+    VcfToolBuilder& with_dedup(DedupMode mode = DedupMode::Unsorted);
+
+    // Apply all sizing parameters at once
+    VcfToolBuilder& with_profile(const PipelineProfile& profile);
+
     // Preset configurations
     static VcfToolBuilder for_large_files();
     static VcfToolBuilder for_low_memory();
 
+    // Builder from a profile (e.g. written by --calibrate). Keys missing from
+    // the config keep their defaults; values are validated in build().
+    static VcfToolBuilder from_config(const core::Config& config);
+    static PipelineProfile profile_from_config(const core::Config& config);
+
+    // Current sizing parameters
+    PipelineProfile profile() const;
+
     // Build and validate
     VcfTool build() const;
 
@@ -46,6 +171,33 @@ private:
     std::size_t batch_size_ = 1000;
     std::size_t line_queue_capacity_ = 20000;
     std::size_t record_queue_capacity_ = 10000;
+    bool checkpointing_ = false;
+    std::string checkpoint_path_;
+    std::chrono::milliseconds checkpoint_interval_{5000};
+    bool resume_ = false;
+    std::string metrics_file_;
+    std::chrono::milliseconds metrics_interval_{5000};
+    std::string metrics_summary_;
+    std::chrono::milliseconds progress_interval_{0};
+    std::string trace_out_;
+    SinkType sink_ = SinkType::Mongo;
+    FakeSinkOptions fake_sink_;
+    std::string collection_;
+    std::size_t write_retries_ = 3;
+    std::chrono::milliseconds retry_backoff_{100};
+    bool adaptive_parsers_ = false;
+    std::size_t min_parsers_ = 1;
+    AffinityPolicy affinity_ = AffinityPolicy::None;
+    std::string affinity_cpus_;
+    std::size_t wide_line_bytes_ = 1024 * 1024;
+    std::string samples_;
+    std::string info_fields_;
+    std::string format_fields_;
+    std::string filter_;
+    std::size_t max_errors_ = 0;
+    std::string reject_file_;
+    bool split_multiallelic_ = false;
+    DedupMode dedup_ = DedupMode::Off;
 
     // Validation helper
     void validate() const;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <moodycamel/blockingconcurrentqueue.h>
 #include "entity/RawLine.h"
 #include "entity/ParsedRecord.h"
@@ -14,4 +16,10 @@ using entity::ParsedRecord;
 using LineQueue   = moodycamel::BlockingConcurrentQueue<RawLine>;
 using RecordQueue = moodycamel::BlockingConcurrentQueue<ParsedRecord>;
 
+// Max lines a parser dequeues (and times) at once
+inline constexpr std::size_t kLineChunkSize = 256;
+
+// Queue waits shorter than this are not traced (most dequeues don't block)
+inline constexpr std::uint64_t kMinTracedWaitNs = 50'000;
+
 } // namespace vcf_tool::domain
@@ -0,0 +1,292 @@
+// Calibrator.cpp
+#include <vcf_tool/domain/Calibrator.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+#include <vcf_tool/core/Config.h>
+#include <vcf_tool/core/MongoDatabase.h>
+#include <vcf_tool/utils/Json.h>
+#include <vcf_tool/utils/Logger.h>
+#include <vcf_tool/utils/Errors.h>
+#include <vcf_tool/utils/Format.h>
+
+
+namespace vcf_tool::domain::api {
+
+namespace fs = std::filesystem;
+using utils::errors::IOError;
+using utils::errors::ValidationError;
+
+namespace {
+
+// Search bounds
+constexpr std::size_t kMinBatchSize = 50;
+constexpr std::size_t kMaxBatchSize = 100'000;
+constexpr std::size_t kMaxQueueCapacity = std::size_t{1} << 22;
+
+// MongoDB trials write to "<target collection><suffix>"
+constexpr std::string_view kScratchSuffix = "_calibration";
+
+using ProfileKey = std::array<std::size_t, 4>;
+
+ProfileKey key_of(const PipelineProfile& p)
+{
+    return {p.parser_threads, p.batch_size, p.line_queue_capacity, p.record_queue_capacity};
+}
+
+// Clamp a profile into the search space (queues must hold at least one batch)
+PipelineProfile normalized(PipelineProfile p, std::size_t max_threads)
+{
+    p.parser_threads = std::clamp<std::size_t>(p.parser_threads, 1, max_threads);
+    p.batch_size = std::clamp(p.batch_size, kMinBatchSize, kMaxBatchSize);
+    p.line_queue_capacity = std::clamp(p.line_queue_capacity, p.batch_size, kMaxQueueCapacity);
+    p.record_queue_capacity = std::clamp(p.record_queue_capacity, p.batch_size, kMaxQueueCapacity);
+    return p;
+}
+
+// One step along each axis: threads +/- ~25%, sizes x2 and /2
+std::vector<PipelineProfile> neighbours(const PipelineProfile& p, std::size_t max_threads)
+{
+    const std::size_t thread_step = std::max<std::size_t>(1, p.parser_threads / 4);
+
+    std::vector<PipelineProfile> out;
+    auto add = [&](PipelineProfile n) {
+        n = normalized(n, max_threads);
+        if (key_of(n) != key_of(p)) {
+            out.push_back(n);
+        }
+    };
+
+    auto n = p; n.parser_threads = p.parser_threads + thread_step; add(n);
+    n = p; n.parser_threads = p.parser_threads > thread_step ? p.parser_threads - thread_step : 1; add(n);
+    n = p; n.batch_size = p.batch_size * 2; add(n);
+    n = p; n.batch_size = p.batch_size / 2; add(n);
+    n = p; n.line_queue_capacity = p.line_queue_capacity * 2; add(n);
+    n = p; n.line_queue_capacity = p.line_queue_capacity / 2; add(n);
+    n = p; n.record_queue_capacity = p.record_queue_capacity * 2; add(n);
+    n = p; n.record_queue_capacity = p.record_queue_capacity / 2; add(n);
+    return out;
+}
+
+// Copy the header and the first `max_records` data lines; returns data lines copied
+std::size_t write_sample(const std::string& input, const std::string& sample, std::size_t max_records)
+{
+    std::ifstream in(input);
+    if (!in.is_open()) {
+        throw IOError(utils::format("Cannot open '{}' for calibration", input));
+    }
+    std::ofstream out(sample, std::ios::trunc);
+    if (!out.is_open()) {
+        throw IOError(utils::format("Cannot write calibration sample '{}'", sample));
+    }
+
+    std::size_t records = 0;
+    std::string line;
+    while (records < max_records && std::getline(in, line)) {
+        if (!line.empty() && line.front() != '#') {
+            ++records;
+        }
+        out << line << '\n';
+    }
+
+    if (!out) {
+        throw IOError(utils::format("Failed to write calibration sample '{}'", sample));
+    }
+    return records;
+}
+
+// The sample and the reject log trials with a max-errors workload write next to it
+void remove_sample(const std::string& sample)
+{
+    std::error_code ec;
+    fs::remove(sample, ec);
+    fs::remove(sample + ".rejects", ec);
+}
+
+} // namespace
+
+Calibrator::Calibrator(CalibrationOptions options)
+    : options_(std::move(options))
+{
+    if (options_.sample_records == 0 || options_.max_trials == 0 || options_.repeats == 0) {
+        throw ValidationError("Calibration sample_records, max_trials and repeats must be > 0");
+    }
+    if (options_.sink == SinkType::Mongo) {
+        const std::string target = options_.collection.empty()
+            ? core::MongoDatabase::instance().config().collection_name
+            : options_.collection;
+        scratch_collection_ = target + std::string(kScratchSuffix);
+    }
+}
+
+void Calibrator::drop_scratch() const
+{
+    if (!scratch_collection_.empty()) {
+        core::MongoDatabase::instance().drop_collection(scratch_collection_);
+    }
+}
+
+double Calibrator::measure(const std::string& sample_path, std::size_t records,
+                           const PipelineProfile& profile) const
+{
+    VcfToolBuilder builder = options_.workload;
+    builder.with_profile(profile);
+    switch (options_.sink) {
+        case SinkType::Null:
+            builder.with_dry_run();
+            break;
+        case SinkType::Fake:
+            builder.with_fake_sink(options_.fake_sink);
+            break;
+        case SinkType::Mongo:
+            builder.with_dry_run(false).with_collection(scratch_collection_);
+            break;
+    }
+    auto tool = builder.build();
+
+    double best = 0.0;
+    for (std::size_t i = 0; i < options_.repeats; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        try {
+            tool.run(sample_path);
+        } catch (...) {
+            drop_scratch();
+            throw;
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::max(best, static_cast<double>(records) / elapsed.count());
+
+        // Every trial starts from an empty collection, like the import it stands for
+        drop_scratch();
+    }
+    return best;
+}
+
+CalibrationResult Calibrator::run(const std::string& file_path)
+{
+    if (!fs::exists(file_path)) {
+        throw utils::errors::FileNotFoundError(file_path);
+    }
+
+    const fs::path dir = options_.work_dir.empty() ? fs::temp_directory_path() : fs::path(options_.work_dir);
+    const std::string sample_path =
+        (dir / (fs::path(file_path).filename().string() + ".calibration_sample.vcf")).string();
+
+    CalibrationResult result;
+    result.sample_records = write_sample(file_path, sample_path, options_.sample_records);
+    if (result.sample_records == 0) {
+        fs::remove(sample_path);
+        throw ValidationError(utils::format("'{}' contains no data lines to calibrate on", file_path),
+                              utils::errors::Component::IO);
+    }
+
+    const std::size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    LOG_INFO_F("Calibration: {} records sampled from '{}', up to {} trials, {} parser threads max",
+               result.sample_records, file_path, options_.max_trials, max_threads);
+    if (!scratch_collection_.empty()) {
+        LOG_INFO_F("Calibration: MongoDB trials write to the scratch collection '{}'", scratch_collection_);
+    }
+
+    std::map<ProfileKey, double> cache;
+    auto evaluate = [&](const PipelineProfile& profile) -> double {
+        auto key = key_of(profile);
+        if (auto it = cache.find(key); it != cache.end()) {
+            return it->second;
+        }
+        double rps = measure(sample_path, result.sample_records, profile);
+        cache.emplace(key, rps);
+        result.trials.push_back(CalibrationTrial{profile, rps});
+        LOG_INFO_F("Calibration trial {}: threads={} batch={} line_queue={} record_queue={} -> {:.0f} rec/s",
+                   result.trials.size(), profile.parser_threads, profile.batch_size,
+                   profile.line_queue_capacity, profile.record_queue_capacity, rps);
+        return rps;
+    };
+
+    try {
+        drop_scratch();  // Left over by an interrupted calibration
+
+        // Start from the workload's sizing, with its resolved thread count
+        PipelineProfile current = options_.workload.profile();
+        current.parser_threads = options_.workload.build().parser_count();
+        current = normalized(current, max_threads);
+
+        // Untimed warm-up so the first trial doesn't pay for a cold page cache
+        measure(sample_path, result.sample_records, current);
+
+        double current_rps = evaluate(current);
+        result.start_records_per_sec = current_rps;
+
+        bool improved = true;
+        while (improved && result.trials.size() < options_.max_trials) {
+            improved = false;
+            PipelineProfile best_neighbour = current;
+            double best_neighbour_rps = current_rps;
+
+            for (const auto& candidate : neighbours(current, max_threads)) {
+                if (result.trials.size() >= options_.max_trials && !cache.contains(key_of(candidate))) {
+                    break;
+                }
+                double rps = evaluate(candidate);
+                if (rps > best_neighbour_rps) {
+                    best_neighbour = candidate;
+                    best_neighbour_rps = rps;
+                }
+            }
+
+            if (best_neighbour_rps > current_rps * (1.0 + options_.min_improvement)) {
+                current = best_neighbour;
+                current_rps = best_neighbour_rps;
+                improved = true;
+            }
+        }
+
+        result.best = current;
+        result.records_per_sec = current_rps;
+
+    } catch (...) {
+        remove_sample(sample_path);
+        throw;
+    }
+    remove_sample(sample_path);
+
+    LOG_INFO_F("Calibration: best threads={} batch={} line_queue={} record_queue={} at {:.0f} rec/s "
+               "({:+.1f}% vs defaults, {} trials)",
+               result.best.parser_threads, result.best.batch_size,
+               result.best.line_queue_capacity, result.best.record_queue_capacity,
+               result.records_per_sec,
+               (result.records_per_sec / result.start_records_per_sec - 1.0) * 100.0,
+               result.trials.size());
+    return result;
+}
+
+void CalibrationResult::save_profile(const std::string& path) const
+{
+    core::Config config;
+    config.set("parser_threads", best.parser_threads);
+    config.set("batch_size", best.batch_size);
+    config.set("line_queue_capacity", best.line_queue_capacity);
+    config.set("record_queue_capacity", best.record_queue_capacity);
+
+    auto calibration = utils::Json::object();
+    calibration["records_per_sec"] = records_per_sec;
+    calibration["default_records_per_sec"] = start_records_per_sec;
+    calibration["sample_records"] = sample_records;
+    calibration["trials"] = trials.size();
+    config.set("calibration", calibration);
+
+    try {
+        config.save_to_file(path);
+    } catch (const std::exception& e) {
+        throw IOError(utils::format("Failed to write profile '{}': {}", path, e.what()));
+    }
+}
+
+} // namespace vcf_tool::domain::api
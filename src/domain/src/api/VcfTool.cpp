@@ -8,6 +8,7 @@
 #include <vcf_tool/utils/Errors.h>
 #include "../pipeline/Context.h"
 #include "../pipeline/Pipeline.h"
+#include "../checkpoint/CheckpointStore.h"
 
 
 namespace vcf_tool::domain::api {
@@ -23,6 +24,11 @@ VcfTool::VcfTool(Config config)
 }
 
 void VcfTool::run(const std::string& file_path)
+{
+    run(file_path, ProgressCallback{});
+}
+
+void VcfTool::run(const std::string& file_path, ProgressCallback on_progress)
 {
     std::cerr << "VcfTool: processing file: " << file_path << "\n";
 
@@ -78,17 +84,57 @@ void VcfTool::run(const std::string& file_path)
     // but FileLineReaderWorker will handle runtime file open failures gracefully
 
     // Create fresh context for this run (no state pollution between runs)
+    // Resolve checkpoint location (empty = checkpointing disabled)
+    std::string checkpoint_path;
+    if (config_.checkpointing) {
+        checkpoint_path = config_.checkpoint_path.empty()
+            ? checkpoint::CheckpointStore::default_path_for(file_path)
+            : config_.checkpoint_path;
+    }
+
+    // Resolve reject file location (empty = strict parsing, nothing rejected)
+    std::string reject_path;
+    if (config_.max_errors > 0) {
+        reject_path = config_.reject_file.empty() ? file_path + ".rejects" : config_.reject_file;
+    }
+
     Context::Config ctx_config{
         .parser_count = config_.parser_count,
         .batch_size = config_.batch_size,
         .line_queue_capacity = config_.line_queue_capacity,
-        .record_queue_capacity = config_.record_queue_capacity
+        .record_queue_capacity = config_.record_queue_capacity,
+        .checkpoint_path = checkpoint_path,
+        .checkpoint_interval = config_.checkpoint_interval,
+        .resume = config_.resume,
+        .metrics_file = config_.metrics_file,
+        .metrics_interval = config_.metrics_interval,
+        .metrics_summary = config_.metrics_summary,
+        .progress_interval = config_.progress_interval,
+        .trace_out = config_.trace_out,
+        .sink = config_.sink,
+        .fake_sink = config_.fake_sink,
+        .collection = config_.collection,
+        .write_retries = config_.write_retries,
+        .retry_backoff = config_.retry_backoff,
+        .adaptive_parsers = config_.adaptive_parsers,
+        .min_parsers = config_.min_parsers,
+        .affinity = config_.affinity,
+        .affinity_cpus = config_.affinity_cpus,
+        .wide_line_bytes = config_.wide_line_bytes,
+        .samples = config_.samples,
+        .info_fields = config_.info_fields,
+        .format_fields = config_.format_fields,
+        .filter = config_.filter,
+        .max_errors = config_.max_errors,
+        .reject_path = reject_path,
+        .split_multiallelic = config_.split_multiallelic,
+        .dedup = config_.dedup
     };
 
     Context ctx(ctx_config);
 
     // Create and execute pipeline
-    Pipeline pipeline(ctx, file_path);
+    Pipeline pipeline(ctx, file_path, std::move(on_progress));
     pipeline.execute();
 
     // Context destroyed here (RAII cleanup of queues, thread pool)
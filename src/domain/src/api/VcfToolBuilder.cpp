@@ -4,8 +4,16 @@
 
 #include <thread>
 #include <stdexcept>
+#include <utility>
 #include <iostream>  // TODO: Replace with Logger
 
+#include <vcf_tool/core/Affinity.h>
+#include <vcf_tool/core/Config.h>
+#include <vcf_tool/utils/Errors.h>
+
+#include "../filter/RecordFilter.h"
+#include "../header/VcfDictionary.h"
+
 
 namespace vcf_tool::domain::api {
 
@@ -38,6 +46,184 @@ VcfToolBuilder& VcfToolBuilder::with_record_queue_capacity(std::size_t n)
     return *this;
 }
 
+VcfToolBuilder& VcfToolBuilder::with_checkpoint(std::string path)
+{
+    checkpointing_ = true;
+    checkpoint_path_ = std::move(path);
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_checkpoint_interval(std::chrono::milliseconds interval)
+{
+    checkpoint_interval_ = interval;
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_resume(bool resume)
+{
+    resume_ = resume;
+    if (resume_) {
+        checkpointing_ = true;
+    }
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_metrics_file(std::string path)
+{
+    metrics_file_ = std::move(path);
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_metrics_interval(std::chrono::milliseconds interval)
+{
+    metrics_interval_ = interval;
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_metrics_summary(std::string path)
+{
+    metrics_summary_ = std::move(path);
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_progress_interval(std::chrono::milliseconds interval)
+{
+    progress_interval_ = interval;
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_trace_output(std::string path)
+{
+    trace_out_ = std::move(path);
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_dry_run(bool dry_run)
+{
+    sink_ = dry_run ? SinkType::Null : SinkType::Mongo;
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_fake_sink(FakeSinkOptions options)
+{
+    sink_ = SinkType::Fake;
+    fake_sink_ = options;
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_collection(std::string name)
+{
+    collection_ = std::move(name);
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_write_retries(std::size_t retries,
+                                                   std::chrono::milliseconds backoff)
+{
+    write_retries_ = retries;
+    retry_backoff_ = backoff;
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_adaptive_parsers(std::size_t min_parsers)
+{
+    adaptive_parsers_ = true;
+    min_parsers_ = min_parsers;
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_affinity(AffinityPolicy policy, std::string cpu_list)
+{
+    affinity_ = policy;
+    affinity_cpus_ = std::move(cpu_list);
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_wide_line_split(std::size_t min_bytes)
+{
+    wide_line_bytes_ = min_bytes;
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_samples(std::string spec)
+{
+    samples_ = std::move(spec);
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_info_fields(std::string spec)
+{
+    info_fields_ = std::move(spec);
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_format_fields(std::string spec)
+{
+    format_fields_ = std::move(spec);
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_filter(std::string expression)
+{
+    filter_ = std::move(expression);
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_max_errors(std::size_t max_errors, std::string reject_file)
+{
+    max_errors_ = max_errors;
+    reject_file_ = std::move(reject_file);
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_multiallelic_split(bool split)
+{
+    split_multiallelic_ = split;
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_dedup(DedupMode mode)
+{
+    dedup_ = mode;
+    return *this;
+}
+
+VcfToolBuilder& VcfToolBuilder::with_profile(const PipelineProfile& profile)
+{
+    parser_threads_ = profile.parser_threads;
+    batch_size_ = profile.batch_size;
+    line_queue_capacity_ = profile.line_queue_capacity;
+    record_queue_capacity_ = profile.record_queue_capacity;
+    return *this;
+}
+
+PipelineProfile VcfToolBuilder::profile() const
+{
+    return PipelineProfile{
+        .parser_threads = parser_threads_,
+        .batch_size = batch_size_,
+        .line_queue_capacity = line_queue_capacity_,
+        .record_queue_capacity = record_queue_capacity_
+    };
+}
+
+PipelineProfile VcfToolBuilder::profile_from_config(const core::Config& config)
+{
+    // Missing keys fall back to the builder defaults
+    const PipelineProfile defaults = VcfToolBuilder().profile();
+    return PipelineProfile{
+        .parser_threads = config.get_or<std::size_t>("parser_threads", defaults.parser_threads),
+        .batch_size = config.get_or<std::size_t>("batch_size", defaults.batch_size),
+        .line_queue_capacity = config.get_or<std::size_t>("line_queue_capacity", defaults.line_queue_capacity),
+        .record_queue_capacity = config.get_or<std::size_t>("record_queue_capacity", defaults.record_queue_capacity)
+    };
+}
+
+VcfToolBuilder VcfToolBuilder::from_config(const core::Config& config)
+{
+    return VcfToolBuilder().with_profile(profile_from_config(config));
+}
+
 VcfToolBuilder VcfToolBuilder::for_large_files()
 {
     return VcfToolBuilder()
@@ -76,6 +262,62 @@ void VcfToolBuilder::validate() const
         );
     }
 
+    if (checkpointing_ && checkpoint_interval_.count() < 0) {
+        throw std::invalid_argument("VcfToolBuilder: checkpoint_interval must be >= 0");
+    }
+
+    if (!metrics_file_.empty() && metrics_interval_.count() <= 0) {
+        throw std::invalid_argument("VcfToolBuilder: metrics_interval must be > 0");
+    }
+
+    if (progress_interval_.count() < 0) {
+        throw std::invalid_argument("VcfToolBuilder: progress_interval must be >= 0");
+    }
+
+    if (sink_ == SinkType::Fake) {
+        if (fake_sink_.failure_rate < 0.0 || fake_sink_.failure_rate > 1.0) {
+            throw std::invalid_argument("VcfToolBuilder: fake sink failure_rate must be in [0, 1]");
+        }
+        if (fake_sink_.latency.count() < 0 || fake_sink_.latency_jitter.count() < 0) {
+            throw std::invalid_argument("VcfToolBuilder: fake sink latency must be >= 0");
+        }
+    }
+
+    if (adaptive_parsers_ && min_parsers_ == 0) {
+        throw std::invalid_argument("VcfToolBuilder: min_parsers must be > 0");
+    }
+
+    if (affinity_ == AffinityPolicy::Explicit) {
+        if (affinity_cpus_.empty()) {
+            throw std::invalid_argument("VcfToolBuilder: explicit affinity requires a CPU list");
+        }
+        try {
+            core::affinity::parse_cpu_list(affinity_cpus_);
+        } catch (const utils::errors::ValidationError& e) {
+            throw std::invalid_argument(std::string("VcfToolBuilder: ") + e.what());
+        }
+    }
+
+    // A resumed run skips the lines already committed, so their keys are
+    // never seen and their duplicates later in the file would be written again
+    if (dedup_ != DedupMode::Off && resume_) {
+        throw std::invalid_argument("VcfToolBuilder: dedup cannot be combined with resume");
+    }
+
+    if (retry_backoff_.count() < 0) {
+        throw std::invalid_argument("VcfToolBuilder: retry_backoff must be >= 0");
+    }
+
+    // Syntax errors surface now rather than after the header is read
+    if (!filter_.empty()) {
+        try {
+            header::VcfDictionary scratch;
+            filter::RecordFilter::compile(filter_, scratch);
+        } catch (const utils::errors::ValidationError& e) {
+            throw std::invalid_argument(std::string("VcfToolBuilder: ") + e.what());
+        }
+    }
+
     // Warn if thread count is very high (more than 2x available cores)
     if (parser_threads_ > 0) {
         unsigned int hw_threads = std::thread::hardware_concurrency();
@@ -105,12 +347,43 @@ VcfTool VcfToolBuilder::build() const
         std::cerr << "VcfToolBuilder: auto-detected " << threads << " parser threads\n";
     }
 
+    if (adaptive_parsers_ && min_parsers_ > threads) {
+        throw std::invalid_argument("VcfToolBuilder: min_parsers must be <= parser_threads");
+    }
+
     // Create config
     VcfTool::Config config{
         .parser_count = threads,
         .batch_size = batch_size_,
         .line_queue_capacity = line_queue_capacity_,
-        .record_queue_capacity = record_queue_capacity_
+        .record_queue_capacity = record_queue_capacity_,
+        .checkpointing = checkpointing_,
+        .checkpoint_path = checkpoint_path_,
+        .checkpoint_interval = checkpoint_interval_,
+        .resume = resume_,
+        .metrics_file = metrics_file_,
+        .metrics_interval = metrics_interval_,
+        .metrics_summary = metrics_summary_,
+        .progress_interval = progress_interval_,
+        .trace_out = trace_out_,
+        .sink = sink_,
+        .fake_sink = fake_sink_,
+        .collection = collection_,
+        .write_retries = write_retries_,
+        .retry_backoff = retry_backoff_,
+        .adaptive_parsers = adaptive_parsers_,
+        .min_parsers = min_parsers_,
+        .affinity = affinity_,
+        .affinity_cpus = affinity_cpus_,
+        .wide_line_bytes = wide_line_bytes_,
+        .samples = samples_,
+        .info_fields = info_fields_,
+        .format_fields = format_fields_,
+        .filter = filter_,
+        .max_errors = max_errors_,
+        .reject_file = reject_file_,
+        .split_multiallelic = split_multiallelic_,
+        .dedup = dedup_
     };
 
     // Construct and return VcfTool (using friend access to private constructor)
@@ -0,0 +1,115 @@
+// CheckpointStore.cpp
+#include "CheckpointStore.h"
+
+#include <array>
+#include <filesystem>
+#include <stdexcept>
+
+#include <vcf_tool/utils/Json.h>
+#include <vcf_tool/utils/Errors.h>
+#include <vcf_tool/utils/Format.h>
+
+
+namespace vcf_tool::domain::checkpoint {
+
+using utils::Json;
+using utils::errors::IOError;
+using utils::errors::ValidationError;
+
+namespace {
+
+// A committed range is stored as [first, last, end_offset]
+using StoredRange = std::array<std::uint64_t, 3>;
+
+} // namespace
+
+CheckpointStore::CheckpointStore(std::string path)
+    : path_(std::move(path))
+{
+}
+
+std::string CheckpointStore::default_path_for(const std::string& input_path)
+{
+    return input_path + ".checkpoint";
+}
+
+std::optional<Checkpoint> CheckpointStore::load() const
+{
+    std::error_code ec;
+    if (!std::filesystem::exists(path_, ec)) {
+        return std::nullopt;
+    }
+
+    try {
+        auto json = Json::load_from_file(path_);
+
+        Checkpoint checkpoint;
+        checkpoint.source      = json.at("source").get<std::string>();
+        checkpoint.file_size   = json.at("file_size").get<std::uint64_t>();
+        checkpoint.line_number = json.at("line_number").get<std::uint64_t>();
+        checkpoint.byte_offset = json.at("byte_offset").get<std::uint64_t>();
+        if (json.contains("committed_ahead")) {
+            // Ranges must be ascending, disjoint and above the watermark
+            std::uint64_t floor = checkpoint.line_number;
+            for (const auto& [first, last, end_offset] : json["committed_ahead"].get<std::vector<StoredRange>>()) {
+                if (first <= floor || last < first) {
+                    throw std::runtime_error(utils::format(
+                        "committed range [{}, {}] does not follow line {}", first, last, floor));
+                }
+                checkpoint.committed_ahead.push_back({.first = first, .last = last, .end_offset = end_offset});
+                floor = last;
+            }
+        }
+        return checkpoint;
+
+    } catch (const std::exception& e) {
+        throw IOError(utils::format("Invalid checkpoint file '{}': {}", path_, e.what()));
+    }
+}
+
+std::optional<Checkpoint> CheckpointStore::load_for(const std::string& source, std::uint64_t file_size) const
+{
+    auto checkpoint = load();
+    if (!checkpoint) {
+        return std::nullopt;
+    }
+
+    namespace fs = std::filesystem;
+    if (fs::path(checkpoint->source).filename() != fs::path(source).filename()) {
+        throw ValidationError(utils::format(
+            "Checkpoint '{}' was written for '{}', not '{}'", path_, checkpoint->source, source));
+    }
+    if (checkpoint->file_size != file_size) {
+        throw ValidationError(utils::format(
+            "Checkpoint '{}' was written for a {}-byte input, but '{}' is {} bytes",
+            path_, checkpoint->file_size, source, file_size));
+    }
+    return checkpoint;
+}
+
+void CheckpointStore::save(const Checkpoint& checkpoint) const
+{
+    auto json = Json::object();
+    json["source"]      = checkpoint.source;
+    json["file_size"]   = checkpoint.file_size;
+    json["line_number"] = checkpoint.line_number;
+    json["byte_offset"] = checkpoint.byte_offset;
+    std::vector<StoredRange> ranges;
+    ranges.reserve(checkpoint.committed_ahead.size());
+    for (const auto& range : checkpoint.committed_ahead) {
+        ranges.push_back({range.first, range.last, range.end_offset});
+    }
+    json["committed_ahead"] = ranges;
+    json["completed"]   = checkpoint.completed();
+
+    // Write-then-rename so readers never observe a partially written file
+    const std::string tmp_path = path_ + ".tmp";
+    try {
+        Json::save_to_file(json, tmp_path);
+        std::filesystem::rename(tmp_path, path_);
+    } catch (const std::exception& e) {
+        throw IOError(utils::format("Failed to write checkpoint '{}': {}", path_, e.what()));
+    }
+}
+
+} // namespace vcf_tool::domain::checkpoint
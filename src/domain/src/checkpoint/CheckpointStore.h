@@ -0,0 +1,109 @@
+// CheckpointStore.h
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+
+namespace vcf_tool::domain::checkpoint {
+
+/**
+ * @brief Highest contiguous input position known to be committed
+ *
+ * Every line up to and including `line_number` has been written to the
+ * sink (or intentionally skipped, e.g. header lines). `byte_offset` is the
+ * position just past that line, so a resumed reader can seek straight to it.
+ *
+ * Parsers finish lines out of order, and a failed write leaves a gap for
+ * the rest of the run, so lines beyond the watermark are usually committed
+ * as well. They are kept in `committed_ahead` as merged runs of consecutive
+ * lines, so a resumed run can skip exactly those instead of writing them
+ * twice, however many there are.
+ */
+struct Checkpoint {
+    /// Run of consecutive committed lines
+    struct LineRange {
+        std::uint64_t first{};       // First line of the run
+        std::uint64_t last{};        // Last line of the run
+        std::uint64_t end_offset{};  // Offset just past `last`
+
+        bool operator==(const LineRange&) const = default;
+    };
+
+    std::string   source;          // Input file the checkpoint belongs to
+    std::uint64_t file_size{};     // Input size when the import started
+    std::uint64_t line_number{};   // Last contiguously committed line (0 = none)
+    std::uint64_t byte_offset{};   // Offset just past line_number
+    std::vector<LineRange> committed_ahead;  // Ascending, disjoint runs above line_number + 1
+
+    /// True once the whole input has been committed
+    bool completed() const { return file_size > 0 && byte_offset >= file_size; }
+
+    /// Number of lines in committed_ahead
+    std::uint64_t lines_ahead() const
+    {
+        std::uint64_t lines = 0;
+        for (const auto& range : committed_ahead) {
+            lines += range.last - range.first + 1;
+        }
+        return lines;
+    }
+};
+
+/**
+ * @brief Sidecar-file persistence for import checkpoints
+ *
+ * Stores a Checkpoint as a small JSON document next to the input (or at a
+ * user-provided path). Writes go to a temporary file which is then renamed
+ * over the previous checkpoint, so a crash mid-write never leaves a torn file.
+ *
+ * Usage:
+ *   CheckpointStore store("input.vcf.checkpoint");
+ *   if (auto cp = store.load()) { ... seek to cp->byte_offset ... }
+ *   store.save(cp);
+ */
+class CheckpointStore {
+public:
+    explicit CheckpointStore(std::string path);
+
+    /**
+     * Load the checkpoint from disk.
+     *
+     * @return Checkpoint, or std::nullopt if no checkpoint file exists
+     * @throws IOError if the file exists but cannot be read or parsed
+     */
+    std::optional<Checkpoint> load() const;
+
+    /**
+     * Load the checkpoint to resume importing `source`.
+     *
+     * Offsets are meaningless for another input, or if the input changed
+     * since the checkpoint was taken. The file name must match; the
+     * directory may differ (a relative path, a moved input).
+     *
+     * @return Checkpoint, or std::nullopt if no checkpoint file exists
+     * @throws IOError if the file exists but cannot be read or parsed
+     * @throws ValidationError if the checkpoint was written for another
+     *         file name or a different input size
+     */
+    std::optional<Checkpoint> load_for(const std::string& source, std::uint64_t file_size) const;
+
+    /**
+     * Atomically replace the checkpoint on disk.
+     *
+     * @throws IOError if the checkpoint cannot be written
+     */
+    void save(const Checkpoint& checkpoint) const;
+
+    const std::string& path() const { return path_; }
+
+    /// Default sidecar location for an input file ("<input>.checkpoint")
+    static std::string default_path_for(const std::string& input_path);
+
+private:
+    std::string path_;
+};
+
+} // namespace vcf_tool::domain::checkpoint
@@ -0,0 +1,129 @@
+// CheckpointTracker.cpp
+#include "CheckpointTracker.h"
+
+#include <iterator>
+
+#include <vcf_tool/utils/Logger.h>
+#include <vcf_tool/utils/Errors.h>
+
+
+namespace vcf_tool::domain::checkpoint {
+
+CheckpointTracker::CheckpointTracker(CheckpointStore store,
+                                     Checkpoint start,
+                                     std::chrono::milliseconds interval)
+    : store_(std::move(store))
+    , watermark_(std::move(start))
+    , interval_(interval)
+    , last_persist_(std::chrono::steady_clock::now())
+{
+    // Lines committed ahead of the watermark by the previous run are not
+    // re-read, so seed them as already committed (the store checked they
+    // are ascending and disjoint)
+    for (const auto& range : watermark_.committed_ahead) {
+        if (!ahead_.empty() && std::prev(ahead_.end())->second.last + 1 == range.first) {
+            std::prev(ahead_.end())->second = Run{range.last, range.end_offset};
+        } else {
+            ahead_.emplace(range.first, Run{range.last, range.end_offset});
+        }
+    }
+    watermark_.committed_ahead.clear();
+    absorb_next_run();
+}
+
+void CheckpointTracker::commit(std::uint64_t line_number, std::uint64_t end_offset)
+{
+    if (line_number <= watermark_.line_number || failed_.contains(line_number)) {
+        return;
+    }
+    changed_ = true;
+
+    if (line_number == watermark_.line_number + 1) {
+        watermark_.line_number = line_number;
+        watermark_.byte_offset = end_offset;
+        absorb_next_run();
+        return;
+    }
+
+    // Out of order: add it to the runs above the watermark
+    auto next = ahead_.upper_bound(line_number);
+    auto prev = next == ahead_.begin() ? ahead_.end() : std::prev(next);
+    if (prev != ahead_.end() && prev->second.last >= line_number) {
+        return;  // Already committed
+    }
+
+    const bool extends_prev = prev != ahead_.end() && prev->second.last + 1 == line_number;
+    const bool extends_next = next != ahead_.end() && next->first == line_number + 1;
+    if (extends_prev && extends_next) {
+        prev->second = next->second;  // Fills the gap between two runs
+        ahead_.erase(next);
+    } else if (extends_prev) {
+        prev->second = Run{line_number, end_offset};
+    } else if (extends_next) {
+        const Run run = next->second;
+        ahead_.erase(next);
+        ahead_.emplace(line_number, run);
+    } else {
+        ahead_.emplace(line_number, Run{line_number, end_offset});
+    }
+}
+
+void CheckpointTracker::absorb_next_run()
+{
+    // Runs are never adjacent, so at most one can join
+    auto next = ahead_.begin();
+    if (next != ahead_.end() && next->first == watermark_.line_number + 1) {
+        watermark_.line_number = next->second.last;
+        watermark_.byte_offset = next->second.end_offset;
+        ahead_.erase(next);
+    }
+}
+
+void CheckpointTracker::stall(std::uint64_t line_number)
+{
+    if (failed_.empty()) {
+        LOG_WARN_F("Checkpoint stalled at line {}: write failed for line {}; "
+                   "a resumed import will restart from there",
+                   watermark_.line_number, line_number);
+    }
+    failed_.insert(line_number);
+}
+
+void CheckpointTracker::maybe_persist()
+{
+    if (!changed_) {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_persist_ < interval_) {
+        return;
+    }
+
+    persist();
+}
+
+void CheckpointTracker::persist()
+{
+    watermark_.committed_ahead.reserve(ahead_.size());
+    for (const auto& [first, run] : ahead_) {
+        watermark_.committed_ahead.push_back({.first = first, .last = run.last, .end_offset = run.end_offset});
+    }
+
+    try {
+        store_.save(watermark_);
+        changed_ = false;
+        last_persist_ = std::chrono::steady_clock::now();
+        LOG_DEBUG_F("Checkpoint saved: line {}, offset {}, {} lines ahead in {} ranges",
+                    watermark_.line_number, watermark_.byte_offset, watermark_.lines_ahead(),
+                    watermark_.committed_ahead.size());
+
+    } catch (const utils::errors::IOError& e) {
+        // A missed checkpoint only costs extra re-work on resume - keep importing
+        LOG_WARN_F("{}", e.what());
+    }
+
+    watermark_.committed_ahead.clear();
+}
+
+} // namespace vcf_tool::domain::checkpoint
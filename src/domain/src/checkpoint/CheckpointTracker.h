@@ -0,0 +1,81 @@
+// CheckpointTracker.h
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <set>
+
+#include "CheckpointStore.h"
+
+
+namespace vcf_tool::domain::checkpoint {
+
+/**
+ * @brief Tracks the highest contiguous committed line and persists it
+ *
+ * Parsers complete lines out of order, so the writer reports each line
+ * individually once it is durable (flushed to the sink or skipped). The
+ * tracker advances the watermark across a gap-free run of line numbers and
+ * keeps the commits above it as merged [first, last] runs, persisted
+ * alongside it. Together they describe exactly which lines are committed;
+ * memory grows with the number of gaps, not the number of lines.
+ *
+ * A line with a record in a failed batch is never committed: later commits
+ * of it (the last part of a split line, in a later batch) are refused, so
+ * the watermark stays below the lowest failed line for the rest of the run
+ * and a resume re-processes it. A line's records reach the writer in order,
+ * so a failure is always reported before the commit it blocks.
+ *
+ * Thread Safety:
+ *   - Not thread-safe; owned and driven by the single DbWriterWorker thread
+ */
+class CheckpointTracker {
+public:
+    /**
+     * @param store     Where checkpoints are persisted
+     * @param start     Checkpoint the run resumed from (or an empty one)
+     * @param interval  Minimum time between two persisted checkpoints
+     */
+    CheckpointTracker(CheckpointStore store,
+                      Checkpoint start,
+                      std::chrono::milliseconds interval);
+
+    /// Mark a line as committed (written to the sink or intentionally skipped)
+    void commit(std::uint64_t line_number, std::uint64_t end_offset);
+
+    /// Record that a line failed to write (it is never committed, so the watermark can't pass it)
+    void stall(std::uint64_t line_number);
+
+    /// Persist the checkpoint if it changed and the interval has elapsed
+    void maybe_persist();
+
+    /// Persist the checkpoint unconditionally (end of run)
+    void persist();
+
+    const Checkpoint& watermark() const { return watermark_; }
+    bool stalled() const { return !failed_.empty(); }
+
+private:
+    struct Run {
+        std::uint64_t last;        // Last line of the run
+        std::uint64_t end_offset;  // Offset just past `last`
+    };
+
+    // Join the run starting right after the watermark, if any
+    void absorb_next_run();
+
+    CheckpointStore store_;
+    Checkpoint watermark_;
+    std::chrono::milliseconds interval_;
+
+    // Committed lines above the watermark: first line -> run. Runs are
+    // disjoint and never adjacent (adjacent ones are merged)
+    std::map<std::uint64_t, Run> ahead_;
+    std::set<std::uint64_t> failed_;  // Lines with a record in a failed batch
+
+    bool changed_{false};  // Committed since the last persist
+    std::chrono::steady_clock::time_point last_persist_;
+};
+
+} // namespace vcf_tool::domain::checkpoint
@@ -15,8 +15,9 @@
 
 namespace vcf_tool::domain::dao {
 
-VcfDao::VcfDao()
-    : collection_(core::MongoDatabase::instance().get_collection())
+VcfDao::VcfDao(const std::string& collection)
+    : collection_(collection.empty() ? core::MongoDatabase::instance().get_collection()
+                                     : core::MongoDatabase::instance().get_collection(collection))
 {
     ensure_indexes();
 }
@@ -45,9 +46,9 @@ void VcfDao::ensure_indexes() {
     }
 }
 
-void VcfDao::insert(const VcfRecord& record) {
+void VcfDao::insert(const VcfRecord& record, const header::VcfDictionary& dictionary) {
     try {
-        auto bson_doc = VcfSchema::to_bson(record);
+        auto bson_doc = VcfSchema::to_bson(record, dictionary);
         collection_.insert_one(bson_doc.view());
 
     } catch (const mongocxx::exception& e) {
@@ -58,30 +59,44 @@ void VcfDao::insert(const VcfRecord& record) {
     }
 }
 
-std::size_t VcfDao::bulk_insert(const std::vector<entity::ParsedRecord>& records) {
+std::size_t VcfDao::bulk_insert(const std::vector<entity::ParsedRecord>& records,
+                                const header::VcfDictionary& dictionary) {
     if (records.empty()) {
         return 0;
     }
 
-    try {
-        // Extract VcfRecords from ParsedRecords
-        std::vector<VcfRecord> vcf_records;
-        vcf_records.reserve(records.size());
-        for (const auto& parsed : records) {
-            vcf_records.push_back(parsed.vcf_data);
-        }
+    return insert_encoded(encode(records, dictionary));
+}
+
+std::vector<bsoncxx::document::value> VcfDao::encode(
+    std::span<const entity::ParsedRecord> records,
+    const header::VcfDictionary& dictionary)
+{
+    std::vector<bsoncxx::document::value> bson_docs;
+    bson_docs.reserve(records.size());
+
+    // Encode straight from ParsedRecords (no intermediate VcfRecord copies)
+    for (const auto& parsed : records) {
+        bson_docs.push_back(VcfSchema::to_bson(parsed.vcf_data, dictionary));
+    }
+
+    return bson_docs;
+}
 
-        // Convert to BSON batch
-        auto bson_docs = VcfSchema::to_bson_batch(vcf_records);
+std::size_t VcfDao::insert_encoded(const std::vector<bsoncxx::document::value>& docs) {
+    if (docs.empty()) {
+        return 0;
+    }
 
+    try {
         // Prepare bulk write operation
         mongocxx::options::insert insert_opts;
         insert_opts.ordered(false);  // Parallel writes, continue on error
 
         // Build vector of document views
         std::vector<bsoncxx::document::view> doc_views;
-        doc_views.reserve(bson_docs.size());
-        for (const auto& doc : bson_docs) {
+        doc_views.reserve(docs.size());
+        for (const auto& doc : docs) {
             doc_views.push_back(doc.view());
         }
 
@@ -98,7 +113,7 @@ std::size_t VcfDao::bulk_insert(const std::vector<entity::ParsedRecord>& records
         // Partial success case - some documents inserted, some failed
         // bulk_write_exception is thrown even on partial success
         // We'll log the error but return 0 since we can't get partial count easily
-        LOG_WARN_F("Bulk insert failed: {} Error: {}", records.size(), e.what());
+        LOG_WARN_F("Bulk insert failed: {} Error: {}", docs.size(), e.what());
         return 0;
 
     } catch (const mongocxx::exception& e) {
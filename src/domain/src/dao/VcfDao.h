@@ -1,11 +1,15 @@
 #pragma once
 
 #include <vector>
+#include <span>
+#include <string>
 #include <cstddef>
 #include <mongocxx/collection.hpp>
+#include <bsoncxx/document/value.hpp>
 
 #include "../entity/VcfRecord.h"
 #include "../entity/ParsedRecord.h"
+#include "../header/VcfDictionary.h"
 
 namespace vcf_tool::domain::dao {
 
@@ -21,22 +25,25 @@ namespace vcf_tool::domain::dao {
  *
  * Usage:
  *   VcfDao dao;
- *   dao.bulk_insert(parsed_records);
+ *   dao.bulk_insert(parsed_records, dictionary);
  */
 class VcfDao {
 public:
     /**
-     * Default constructor - uses MongoDatabase singleton and ensures indexes
+     * Uses the MongoDatabase singleton and ensures indexes
+     *
+     * @param collection  Collection to write to (empty = the configured one)
      */
-    VcfDao();
+    explicit VcfDao(const std::string& collection = {});
 
     /**
      * Insert a single VCF record
      *
-     * @param record  VcfRecord to insert
+     * @param record      VcfRecord to insert
+     * @param dictionary  Dictionary the record's string IDs belong to
      * @throws DatabaseError on failure
      */
-    void insert(const VcfRecord& record);
+    void insert(const VcfRecord& record, const header::VcfDictionary& dictionary);
 
     /**
      * Bulk insert multiple ParsedRecords (batch write)
@@ -44,11 +51,37 @@ public:
      * More efficient than individual inserts for large batches.
      * Uses MongoDB bulk_write with ordered=false for best performance.
      *
-     * @param records  Vector of ParsedRecords (extracts vcf_data)
+     * @param records     Vector of ParsedRecords (extracts vcf_data)
+     * @param dictionary  Dictionary the records' string IDs belong to
+     * @return Number of successfully inserted documents
+     * @throws DatabaseError on failure
+     */
+    std::size_t bulk_insert(const std::vector<entity::ParsedRecord>& records,
+                            const header::VcfDictionary& dictionary);
+
+    /**
+     * Encode ParsedRecords to BSON (first half of bulk_insert)
+     *
+     * Split out so callers can measure encoding and insert latency separately.
+     *
+     * Stateless, so slices of one batch may be encoded concurrently.
+     *
+     * @param records     ParsedRecords (extracts vcf_data)
+     * @param dictionary  Dictionary the records' string IDs belong to
+     * @return One BSON document per record
+     */
+    static std::vector<bsoncxx::document::value> encode(
+        std::span<const entity::ParsedRecord> records,
+        const header::VcfDictionary& dictionary);
+
+    /**
+     * Insert already encoded documents (second half of bulk_insert)
+     *
+     * @param docs  BSON documents produced by encode()
      * @return Number of successfully inserted documents
      * @throws DatabaseError on failure
      */
-    std::size_t bulk_insert(const std::vector<entity::ParsedRecord>& records);
+    std::size_t insert_encoded(const std::vector<bsoncxx::document::value>& docs);
 
 private:
     /**
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <bit>
+#include <cstdint>
 #include <vector>
-#include <bsoncxx/builder/stream/document.hpp>
-#include <bsoncxx/json.hpp>
+#include <bsoncxx/builder/core.hpp>
 #include <bsoncxx/document/value.hpp>
+#include <bsoncxx/types.hpp>
 
 #include "../entity/VcfRecord.h"
+#include "../header/VcfDictionary.h"
 
 namespace vcf_tool::domain::dao {
 
@@ -20,10 +23,15 @@ namespace vcf_tool::domain::dao {
  *   "ref": string,
  *   "alt": string,
  *   "data": {
- *     "FILTER": <json>,
- *     "QUAL": <json>,
- *     "INFO": <json>,
- *     "FORMAT": <json>
+ *     "FILTER": string,
+ *     "QUAL": double | null,
+ *     "INFO": { key: double | string | true, ... },
+ *     "FORMAT": {
+ *       "samples": int32,
+ *       "GT": { "ploidy": int32, "data": binary },
+ *       key: { "type": "int32" | "float", "width": int32, "data": binary },
+ *       key: [ string | null, ... ]
+ *     }
  *   }
  * }
  *
@@ -31,63 +39,150 @@ namespace vcf_tool::domain::dao {
  * ParsedRecord metadata (line_number, raw_text) is NOT stored.
  *
  * The "_id" field is automatically generated by MongoDB as ObjectId.
- * The "data" field contains the flexible JSON data from VcfRecord.
+ * INFO / FORMAT keys keep their order from the VCF line; keys dropped by
+ * --info-fields / --format-fields are absent.
+ *
+ * With --split-multiallelic, "alt" is a single allele: a multiallelic line
+ * becomes one document per ALT, with "position" / "ref" / "alt" trimmed.
+ *
+ * FORMAT holds every sample column (or the --samples selection, in file
+ * order), column-major (see GenotypeMatrix):
+ * GT is `ploidy` bytes per sample ((allele + 1) << 1 | phased, 0 =
+ * missing, 0x81 = padding); numeric keys are little-endian int32 / float32
+ * arrays of `width` values per sample with the BCF missing / padding
+ * sentinels; other keys are one string (or null) per sample. Sites-only
+ * records have an empty FORMAT.
+ *
+ * Interned strings (chromosome, FILTER, keys) are resolved through the
+ * dictionary; the resolved views are stable, so keys are appended without
+ * being copied or re-encoded per record.
  */
 struct VcfSchema {
     /**
      * Convert VcfRecord to BSON document
      *
-     * @param record  Source VCF record
+     * Appends straight from the record's views (no intermediate JSON).
+     *
+     * @param record      Source VCF record (decoded: see VcfRecord::decoded)
+     * @param dictionary  Dictionary the record's string IDs belong to
      * @return BSON document ready for MongoDB insertion
      */
-    static bsoncxx::document::value to_bson(const VcfRecord& record) {
-        using bsoncxx::builder::stream::document;
-        using bsoncxx::builder::stream::finalize;
-
-        // Convert nlohmann::json to BSON by serializing to string first
-        // Note: mongocxx doesn't have direct nlohmann::json support
-        std::string json_str = record.data.dump();
-
-        // Parse JSON string to BSON with error handling
-        bsoncxx::document::value json_bson = [&json_str]() {
-            try {
-                return bsoncxx::from_json(json_str);
-            } catch (...) {
-                // If JSON parsing fails, use empty object
-                document empty_obj{};
-                return empty_obj << finalize;
-            }
-        }();
-
+    static bsoncxx::document::value to_bson(const VcfRecord& record, const header::VcfDictionary& dictionary) {
         // Build BSON document (MongoDB will auto-generate _id)
-        document builder{};
-        builder << "chromosome" << record.chromosome
-                << "position" << static_cast<std::int64_t>(record.position)
-                << "ref" << record.ref
-                << "alt" << record.alt
-                << "data" << json_bson.view();
+        bsoncxx::builder::core doc(false);
+        doc.key_view("chromosome").append(dictionary.contigs.resolve(record.chromosome));
+        doc.key_view("position").append(static_cast<std::int64_t>(record.position));
+        doc.key_view("ref").append(record.ref);
+        doc.key_view("alt").append(record.alt);
+
+        doc.key_view("data").open_document();
+        doc.key_view("FILTER").append(dictionary.filters.resolve(record.filter));
+        doc.key_view("QUAL");
+        if (record.qual) {
+            doc.append(*record.qual);
+        } else {
+            doc.append(bsoncxx::types::b_null{});
+        }
+        append_fields(doc, "INFO", record.info, dictionary.info_keys);
+        append_samples(doc, record.samples, dictionary.format_keys);
+        doc.close_document();
 
-        return builder << finalize;
+        return doc.extract_document();
     }
 
     /**
      * Batch convert multiple VcfRecords to BSON documents
      *
-     * @param records  Vector of VcfRecords
+     * @param records     Vector of VcfRecords
+     * @param dictionary  Dictionary the records' string IDs belong to
      * @return Vector of BSON documents
      */
     static std::vector<bsoncxx::document::value> to_bson_batch(
-        const std::vector<VcfRecord>& records)
+        const std::vector<VcfRecord>& records,
+        const header::VcfDictionary& dictionary)
     {
         std::vector<bsoncxx::document::value> bson_docs;
         bson_docs.reserve(records.size());
 
         for (const auto& record : records) {
-            bson_docs.push_back(to_bson(record));
+            bson_docs.push_back(to_bson(record, dictionary));
         }
 
         return bson_docs;
     }
+
+private:
+    // Sub-document `name` with one element per field
+    static void append_fields(bsoncxx::builder::core& doc, std::string_view name, std::span<const Field> fields,
+                              const header::StringDictionary& keys) {
+        doc.key_view(name).open_document();
+        for (const auto& field : fields) {
+            doc.key_view(keys.resolve(field.key));
+            switch (field.value.kind) {
+                case FieldValue::Kind::Flag:    doc.append(true); break;
+                case FieldValue::Kind::Missing: doc.append(bsoncxx::types::b_null{}); break;
+                case FieldValue::Kind::Number:  doc.append(field.value.number); break;
+                case FieldValue::Kind::String:  doc.append(field.value.text); break;
+            }
+        }
+        doc.close_document();
+    }
+
+    // Raw bytes of a typed array (the BSON layout is little-endian)
+    template<typename T>
+    static bsoncxx::types::b_binary binary(std::span<const T> values) {
+        static_assert(std::endian::native == std::endian::little, "FORMAT arrays are stored in host byte order");
+        return bsoncxx::types::b_binary{
+            bsoncxx::binary_sub_type::k_binary,
+            static_cast<std::uint32_t>(values.size_bytes()),
+            reinterpret_cast<const std::uint8_t*>(values.data())
+        };
+    }
+
+    static void append_samples(bsoncxx::builder::core& doc, const GenotypeMatrix& samples,
+                               const header::StringDictionary& keys) {
+        doc.key_view("FORMAT").open_document();
+        if (samples.sample_count == 0) {
+            doc.close_document();
+            return;
+        }
+
+        doc.key_view("samples").append(static_cast<std::int32_t>(samples.sample_count));
+        if (samples.ploidy > 0) {
+            doc.key_view("GT").open_document();
+            doc.key_view("ploidy").append(static_cast<std::int32_t>(samples.ploidy));
+            doc.key_view("data").append(binary(samples.genotypes));
+            doc.close_document();
+        }
+
+        for (const auto& column : samples.columns) {
+            doc.key_view(keys.resolve(column.key));
+            switch (column.type) {
+                case FormatColumn::Type::Integer:
+                case FormatColumn::Type::Float:
+                    doc.open_document();
+                    doc.key_view("type").append(column.type == FormatColumn::Type::Integer ? "int32" : "float");
+                    doc.key_view("width").append(static_cast<std::int32_t>(column.width));
+                    doc.key_view("data").append(column.type == FormatColumn::Type::Integer
+                                                    ? binary(column.integers)
+                                                    : binary(column.floats));
+                    doc.close_document();
+                    break;
+                case FormatColumn::Type::String:
+                    doc.open_array();
+                    for (std::string_view value : column.strings) {
+                        if (value.empty()) {
+                            doc.append(bsoncxx::types::b_null{});
+                        } else {
+                            doc.append(value);
+                        }
+                    }
+                    doc.close_array();
+                    break;
+            }
+        }
+        doc.close_document();
+    }
 };
 
 } // namespace vcf_tool::domain::dao
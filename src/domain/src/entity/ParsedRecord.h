@@ -2,18 +2,21 @@
 #pragma once
 
 #include <cstdint>
-#include <string>
-#include <vector>
+#include <string_view>
 
 #include "VcfRecord.h"
+#include "../memory/ChunkArena.h"
 
 namespace vcf_tool::domain::entity {
 
 struct ParsedRecord {
     std::uint64_t            line_number{};
-    std::string              raw_text;
+    std::uint64_t            end_offset{};   // copied from RawLine, used for checkpoints
+    memory::ArenaRef         arena;          // owns raw_text and everything vcf_data views
+    std::string_view         raw_text;
     vcf_tool::domain::VcfRecord vcf_data;
     bool                     is_end{false};  // sentinel flag for downstream
+    bool                     commits_line{true};  // false on all but the last record split from a line
 };
 
-} // namespace vcf_tool::domain::entity
\ No newline at end of file
+} // namespace vcf_tool::domain::entity
@@ -8,6 +8,7 @@ namespace vcf_tool::domain::entity {
 
 struct RawLine {
     std::uint64_t line_number{};
+    std::uint64_t end_offset{};   // byte offset just past this line (incl. newline)
     std::string   text;
     bool          is_end{false};
 };
@@ -1,17 +1,130 @@
 #pragma once
 
-#include <string>
+#include <bit>
 #include <cstdint>
-#include <nlohmann/json.hpp>
+#include <optional>
+#include <span>
+#include <string_view>
 
 namespace vcf_tool::domain {
 
+/// Dense ID of a string interned in a header::StringDictionary
+using StringId = std::uint32_t;
+inline constexpr StringId kNoStringId = UINT32_MAX;
+
+/**
+ * @brief Typed value of one INFO / FORMAT entry
+ */
+struct FieldValue {
+    enum class Kind : std::uint8_t {
+        Flag,     // INFO key without a value
+        Missing,  // "."
+        Number,
+        String    // Anything else, e.g. "0/1" or "10,20,30"
+    };
+
+    Kind kind{Kind::Missing};
+    double number{0.0};     // Kind::Number
+    std::string_view text;  // Kind::String
+};
+
+/**
+ * @brief One KEY=VALUE entry of INFO
+ */
+struct Field {
+    StringId key{kNoStringId};  // In VcfDictionary::info_keys / format_keys
+    FieldValue value;
+};
+
+// Sentinels of typed FORMAT arrays (same bit patterns as BCF)
+inline constexpr std::int32_t kMissingInt = INT32_MIN;       // "."
+inline constexpr std::int32_t kEndInt = INT32_MIN + 1;       // Padding after a shorter vector
+inline constexpr std::uint32_t kMissingFloatBits = 0x7F800001;
+inline constexpr std::uint32_t kEndFloatBits = 0x7F800002;
+inline constexpr float kMissingFloat = std::bit_cast<float>(kMissingFloatBits);
+inline constexpr float kEndFloat = std::bit_cast<float>(kEndFloatBits);
+
+// GT byte per allele: ((allele + 1) << 1) | phased; 0 = missing allele ("."),
+// kGtEnd pads samples with a lower ploidy than the record's
+inline constexpr std::uint8_t kGtEnd = 0x81;
+inline constexpr std::uint32_t kMaxGtAllele = 62;  // Larger indices don't fit a byte
+inline constexpr std::uint32_t kMaxPloidy = 8;
+
+/**
+ * @brief Values of one FORMAT key across all samples of a record
+ *
+ * Column-major: sample i's values are [i * width, (i + 1) * width) of the
+ * typed array (shorter vectors padded with kEndInt / kEndFloat). Values
+ * that don't fit the declared type turn the whole column into Type::String.
+ */
+struct FormatColumn {
+    enum class Type : std::uint8_t {
+        Integer,
+        Float,
+        String   // One view per sample into the line; empty = missing
+    };
+
+    StringId key{kNoStringId};  // In VcfDictionary::format_keys
+    Type type{Type::String};
+    std::uint32_t width{1};     // Values per sample (Integer / Float)
+    std::span<const std::int32_t> integers;
+    std::span<const float> floats;
+    std::span<const std::string_view> strings;
+};
+
+/**
+ * @brief FORMAT data of all sample columns
+ *
+ * GT (if present and encodable) is stored as `ploidy` bytes per sample;
+ * every other FORMAT key is a FormatColumn, in FORMAT order.
+ */
+struct GenotypeMatrix {
+    std::uint32_t sample_count{0};
+    std::uint32_t ploidy{0};                   // 0 = no GT column
+    std::span<const std::uint8_t> genotypes;   // sample_count * ploidy
+    std::span<const FormatColumn> columns;
+};
+
+/**
+ * @brief INFO / FORMAT columns of a record that are not decoded yet
+ *
+ * Views into the record's copy of the line. VcfLineParser::parse_fixed
+ * leaves the columns here; decode_info / decode_samples fill
+ * VcfRecord::info / samples on first access and clear the views, so a
+ * record dropped after looking at its fixed columns never pays for them.
+ */
+struct DeferredColumns {
+    std::string_view info;     // INFO column (empty once decoded or if ".")
+    std::string_view format;   // FORMAT column (empty once decoded or if absent)
+    std::string_view samples;  // Tab-separated sample columns (with `format`)
+};
+
+/**
+ * @brief Decoded VCF data line
+ *
+ * All views and spans point into the ChunkArena of the ParsedRecord that
+ * holds this record (see ParsedRecord::arena); they are valid as long as
+ * that record (or a copy of it) is alive.
+ *
+ * Repeated strings (contig, FILTER, INFO / FORMAT keys) are IDs in the
+ * pipeline's header::VcfDictionary, resolved only at serialization.
+ *
+ * The fixed columns are always decoded; INFO and FORMAT may still be
+ * `deferred` (see VcfLineParser::parse_fixed). Sinks get decoded records.
+ */
 struct VcfRecord {
-    std::string chromosome;
+    StringId chromosome{kNoStringId};  // VcfDictionary::contigs
     std::uint64_t position{};
-    std::string ref;
-    std::string alt;
-    nlohmann::json data;  // JSON: {FILTER, QUAL, INFO, FORMAT}
+    std::string_view ref;
+    std::string_view alt;
+    std::optional<double> qual;     // std::nullopt for "."
+    StringId filter{kNoStringId};   // VcfDictionary::filters (whole column, e.g. "PASS", "q10;s50")
+    std::span<const Field> info;    // In file order (once decoded)
+    GenotypeMatrix samples;         // FORMAT values of every sample column (once decoded)
+    DeferredColumns deferred;       // INFO / FORMAT text not decoded yet
+
+    /// INFO / FORMAT are decoded (or absent): `info` and `samples` are final
+    bool decoded() const { return deferred.info.empty() && deferred.format.empty(); }
 };
 
 }  // namespace vcf_tool::domain
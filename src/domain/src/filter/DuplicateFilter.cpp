@@ -0,0 +1,235 @@
+// DuplicateFilter.cpp
+#include "DuplicateFilter.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <vcf_tool/utils/Logger.h>
+
+
+namespace vcf_tool::domain::filter {
+
+namespace {
+
+// Final mix of MurmurHash3: every input bit affects the shard (high) and slot (low) bits
+constexpr std::uint64_t fmix64(std::uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    return h ^ (h >> 33);
+}
+
+void atomic_min(std::atomic<std::uint64_t>& target, std::uint64_t value)
+{
+    std::uint64_t current = target.load();
+    while (value < current && !target.compare_exchange_weak(current, value)) {
+    }
+}
+
+void atomic_max(std::atomic<std::uint64_t>& target, std::uint64_t value)
+{
+    std::uint64_t current = target.load();
+    while (value > current && !target.compare_exchange_weak(current, value)) {
+    }
+}
+
+} // namespace
+
+bool KeySet::insert(std::uint64_t key)
+{
+    key = key == 0 ? 1 : key;
+    Shard& shard = shards_[key >> (64 - kShardBits)];
+    std::lock_guard lock(shard.mutex);
+    if ((shard.size + 1) * 2 > shard.slots.size()) {
+        grow(shard);
+    }
+
+    const std::size_t mask = shard.slots.size() - 1;
+    for (std::size_t i = key & mask;; i = (i + 1) & mask) {
+        if (shard.slots[i] == key) {
+            return false;
+        }
+        if (shard.slots[i] == 0) {
+            shard.slots[i] = key;
+            ++shard.size;
+            size_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+}
+
+void KeySet::grow(Shard& shard)
+{
+    std::vector<std::uint64_t> slots(std::max<std::size_t>(64, shard.slots.size() * 2), 0);
+    const std::size_t mask = slots.size() - 1;
+    for (std::uint64_t key : shard.slots) {
+        if (key == 0) {
+            continue;
+        }
+        std::size_t i = key & mask;
+        while (slots[i] != 0) {
+            i = (i + 1) & mask;
+        }
+        slots[i] = key;
+    }
+    shard.slots = std::move(slots);
+}
+
+DuplicateFilter::DuplicateFilter(Order order, std::size_t workers, core::metrics::Counter* duplicates)
+    : order_(order)
+    , duplicates_(duplicates)
+    , workers_(std::make_unique<Worker[]>(workers))
+    , worker_count_(workers)
+{
+}
+
+std::uint64_t DuplicateFilter::key(const VcfRecord& record)
+{
+    // Contig ID and POS seed FNV-1a over REF, a separator and ALT
+    std::uint64_t h = 14695981039346656037ull ^ fmix64((std::uint64_t{record.chromosome} << 40) ^ record.position);
+    const auto add = [&h](std::string_view bytes) {
+        for (char c : bytes) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 1099511628211ull;
+        }
+    };
+    add(record.ref);
+    add("\t");
+    add(record.alt);
+    return fmix64(h);
+}
+
+bool DuplicateFilter::first_seen(std::size_t worker, const VcfRecord& record, std::uint64_t line_number)
+{
+    bool fresh;
+    if (order_ == Order::Unsorted) {
+        fresh = keys_.insert(key(record));
+    } else {
+        Worker& w = workers_[worker];
+        if (!w.current || w.current->id != record.chromosome || w.current->released.load(std::memory_order_relaxed)) {
+            publish_lines(w);
+            w.current = open(record.chromosome, line_number);
+        }
+        w.first_line = std::min(w.first_line, line_number);
+        w.last_line = std::max(w.last_line, line_number);
+        fresh = w.current->keys.insert(key(record));
+    }
+
+    if (!fresh && duplicates_) {
+        duplicates_->add();
+    }
+    return fresh;
+}
+
+void DuplicateFilter::begin_chunk(std::size_t worker)
+{
+    if (order_ == Order::Sorted) {
+        // The chunk about to be taken starts at or after every line taken so far
+        workers_[worker].oldest_line.store(next_line_.load());
+    }
+}
+
+void DuplicateFilter::took_lines(std::size_t worker, std::uint64_t first, std::uint64_t last)
+{
+    if (order_ == Order::Sorted) {
+        atomic_max(next_line_, last + 1);
+        workers_[worker].oldest_line.store(first);
+    }
+}
+
+void DuplicateFilter::end_chunk(std::size_t worker)
+{
+    if (order_ == Order::Unsorted) {
+        return;
+    }
+    Worker& w = workers_[worker];
+    publish_lines(w);
+    w.oldest_line.store(kIdle);
+    release_finished();
+}
+
+std::size_t DuplicateFilter::size() const
+{
+    if (order_ == Order::Unsorted) {
+        return keys_.size();
+    }
+    std::lock_guard lock(mutex_);
+    std::size_t total = 0;
+    for (const auto& chromosome : open_) {
+        total += chromosome->keys.size();
+    }
+    return total;
+}
+
+bool DuplicateFilter::saw_unsorted() const
+{
+    std::lock_guard lock(mutex_);
+    return warned_unsorted_;
+}
+
+std::shared_ptr<DuplicateFilter::Chromosome> DuplicateFilter::open(StringId chromosome, std::uint64_t line_number)
+{
+    std::lock_guard lock(mutex_);
+    for (const auto& candidate : open_) {
+        if (candidate->id == chromosome) {
+            return candidate;
+        }
+    }
+
+    if (chromosome < released_.size() && released_[chromosome] && !warned_unsorted_) {
+        warned_unsorted_ = true;
+        LOG_WARN_F("Dedup: input is not sorted by chromosome (line {} returns to a finished one); "
+                   "duplicates across its blocks are not detected, use unsorted dedup",
+                   line_number);
+    }
+    open_.push_back(std::make_shared<Chromosome>(chromosome));
+    return open_.back();
+}
+
+void DuplicateFilter::publish_lines(Worker& worker)
+{
+    if (worker.current && worker.first_line != kIdle) {
+        atomic_min(worker.current->first_line, worker.first_line);
+        atomic_max(worker.current->last_line, worker.last_line);
+    }
+    worker.first_line = kIdle;
+    worker.last_line = 0;
+}
+
+void DuplicateFilter::release_finished()
+{
+    std::lock_guard lock(mutex_);
+    if (open_.size() < 2) {
+        return;
+    }
+
+    // Every line below `oldest` is parsed and its chromosome's lines published
+    std::uint64_t oldest = next_line_.load();
+    for (std::size_t i = 0; i < worker_count_; ++i) {
+        oldest = std::min(oldest, workers_[i].oldest_line.load());
+    }
+
+    // Sorted input: a chromosome ends before the start of any later one
+    std::uint64_t boundary = 0;
+    for (const auto& chromosome : open_) {
+        if (const std::uint64_t first = chromosome->first_line.load(); first < oldest) {
+            boundary = std::max(boundary, first);
+        }
+    }
+
+    std::erase_if(open_, [&](const std::shared_ptr<Chromosome>& chromosome) {
+        if (chromosome->first_line.load() == kIdle || chromosome->last_line.load() >= boundary) {
+            return false;
+        }
+        chromosome->released.store(true);
+        if (chromosome->id >= released_.size()) {
+            released_.resize(chromosome->id + std::size_t{1}, false);
+        }
+        released_[chromosome->id] = true;
+        return true;
+    });
+}
+
+} // namespace vcf_tool::domain::filter
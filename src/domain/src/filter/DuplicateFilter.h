@@ -0,0 +1,159 @@
+// DuplicateFilter.h
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <vcf_tool/core/Metrics.h>
+
+#include "../entity/VcfRecord.h"
+
+
+namespace vcf_tool::domain::filter {
+
+/**
+ * @brief Concurrent set of 64-bit keys, sharded by the key's high bits
+ *
+ * Each shard is an open-addressing table (linear probing, at most half
+ * full) behind its own mutex, so parser threads inserting different keys
+ * rarely meet on a lock. Key 0 marks empty slots and is stored as 1.
+ */
+class KeySet {
+public:
+    KeySet() = default;
+    KeySet(const KeySet&) = delete;
+    KeySet& operator=(const KeySet&) = delete;
+
+    /// Add `key`; false if it was already present
+    bool insert(std::uint64_t key);
+
+    /// Keys held (approximate while inserts run)
+    std::size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+    static constexpr std::size_t kShardBits = 6;
+    static constexpr std::size_t kShards = std::size_t{1} << kShardBits;
+
+private:
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::vector<std::uint64_t> slots;  // Size is 0 or a power of two
+        std::size_t size{0};
+    };
+
+    static void grow(Shard& shard);
+
+    std::array<Shard, kShards> shards_;
+    std::atomic<std::size_t> size_{0};
+};
+
+/**
+ * @brief Drops records whose (CHROM, POS, REF, ALT) was already seen (--dedup)
+ *
+ * Runs in the parser threads on the fixed columns of each record, before
+ * its INFO / FORMAT are decoded, so a duplicate costs neither decoding,
+ * encoding nor a database round trip. Each record is reduced to a 64-bit
+ * key (contig ID, POS, REF, ALT) held in a KeySet; two distinct variants
+ * share a key with probability about n^2 / 2^65 for n keys in one set.
+ * Which copy of a duplicate is kept depends on the order the parser
+ * threads reach them.
+ *
+ * Unsorted input keeps every key for the whole run (8-16 bytes each).
+ * Input sorted by chromosome keeps one set per chromosome and releases it
+ * once every parser has moved past that chromosome, so memory follows the
+ * largest chromosome rather than the file. That needs to know which lines
+ * no parser holds any more: each worker reports the chunks it takes
+ * (begin_chunk, took_lines, end_chunk), and a chromosome C is released
+ * when a later chromosome starts after C's last line and before the
+ * oldest line still held. A chromosome seen again after its release means
+ * the input was not sorted: it is logged, and its duplicates across the
+ * two blocks go undetected.
+ *
+ * Thread Safety: first_seen() and the chunk calls may run concurrently,
+ * each `worker` index from one thread at a time.
+ */
+class DuplicateFilter {
+public:
+    enum class Order : std::uint8_t {
+        Unsorted,  // Keep every key
+        Sorted,    // Input sorted by chromosome: release finished chromosomes
+    };
+
+    /**
+     * @param order       Input order the memory bound relies on
+     * @param workers     Parser threads calling first_seen (worker indices 0..workers-1)
+     * @param duplicates  Optional: counts records dropped as duplicates
+     */
+    DuplicateFilter(Order order, std::size_t workers, core::metrics::Counter* duplicates = nullptr);
+
+    DuplicateFilter(const DuplicateFilter&) = delete;
+    DuplicateFilter& operator=(const DuplicateFilter&) = delete;
+
+    /// Key of a record's fixed columns
+    static std::uint64_t key(const VcfRecord& record);
+
+    /// The record (line `line_number`) is the first with its key; false = duplicate
+    bool first_seen(std::size_t worker, const VcfRecord& record, std::uint64_t line_number);
+
+    /// `worker` is about to take a chunk of lines
+    void begin_chunk(std::size_t worker);
+
+    /// `worker` took lines [first, last] (call before first_seen on them)
+    void took_lines(std::size_t worker, std::uint64_t first, std::uint64_t last);
+
+    /// `worker` is done with its chunk; releases the chromosomes all parsers have passed
+    void end_chunk(std::size_t worker);
+
+    Order order() const { return order_; }
+
+    /// Keys currently held
+    std::size_t size() const;
+
+    /// A released chromosome came back (sorted order only; logged once)
+    bool saw_unsorted() const;
+
+private:
+    static constexpr std::uint64_t kIdle = std::numeric_limits<std::uint64_t>::max();
+
+    // Keys of one chromosome (sorted input)
+    struct Chromosome {
+        explicit Chromosome(StringId chromosome) : id(chromosome) {}
+
+        StringId id;
+        KeySet keys;
+        std::atomic<std::uint64_t> first_line{kIdle};  // Lines seen so far
+        std::atomic<std::uint64_t> last_line{0};
+        std::atomic<bool> released{false};
+    };
+
+    struct alignas(64) Worker {
+        std::atomic<std::uint64_t> oldest_line{kIdle};  // Oldest line this worker may still hold
+        std::shared_ptr<Chromosome> current;            // Chromosome of its last record
+        std::uint64_t first_line{kIdle};                // Lines of `current` in this chunk
+        std::uint64_t last_line{0};
+    };
+
+    std::shared_ptr<Chromosome> open(StringId chromosome, std::uint64_t line_number);
+    static void publish_lines(Worker& worker);
+    void release_finished();
+
+    Order order_;
+    core::metrics::Counter* duplicates_;
+
+    KeySet keys_;  // Unsorted
+
+    std::unique_ptr<Worker[]> workers_;  // Sorted
+    std::size_t worker_count_;
+    std::atomic<std::uint64_t> next_line_{0};   // Lines below were all taken by some worker
+    mutable std::mutex mutex_;                  // Guards open_, released_ and warned_unsorted_
+    std::vector<std::shared_ptr<Chromosome>> open_;
+    std::vector<bool> released_;                // By contig ID
+    bool warned_unsorted_{false};
+};
+
+} // namespace vcf_tool::domain::filter
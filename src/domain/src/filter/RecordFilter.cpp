@@ -0,0 +1,475 @@
+// RecordFilter.cpp
+#include "RecordFilter.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <optional>
+#include <vector>
+
+#include <vcf_tool/utils/Errors.h>
+#include <vcf_tool/utils/Format.h>
+
+
+namespace vcf_tool::domain::filter {
+
+using utils::errors::ValidationError;
+
+namespace {
+
+using Predicate = RecordFilter::Predicate;
+
+// ---------- Values ----------
+
+enum class Op { Eq, Ne, Lt, Le, Gt, Ge };
+
+bool compare(double a, Op op, double b)
+{
+    switch (op) {
+        case Op::Eq: return a == b;
+        case Op::Ne: return a != b;
+        case Op::Lt: return a < b;
+        case Op::Le: return a <= b;
+        case Op::Gt: return a > b;
+        case Op::Ge: return a >= b;
+    }
+    return false;
+}
+
+std::optional<double> to_number(std::string_view text)
+{
+    double value = 0.0;
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc{} || ptr != text.data() + text.size() || text.empty() || !std::isfinite(value)) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+// Any value of a comma-separated list satisfies `op number`
+bool any_number(std::string_view list, Op op, double number)
+{
+    while (true) {
+        const auto comma = list.find(',');
+        if (auto value = to_number(list.substr(0, comma)); value && compare(*value, op, number)) {
+            return true;
+        }
+        if (comma == std::string_view::npos) {
+            return false;
+        }
+        list.remove_prefix(comma + 1);
+    }
+}
+
+/// One INFO key of a record, found without decoding the column
+struct InfoValue {
+    enum class Kind { Absent, Flag, Value };
+    Kind kind{Kind::Absent};
+    std::string_view text;          // Value text (Kind::Value, from the deferred column)
+    std::optional<double> number;   // Decoded number (Kind::Value, from decoded entries)
+};
+
+InfoValue find_info(const VcfRecord& record, std::string_view key, StringId key_id)
+{
+    // Deferred: scan "K=V;K2;..." for the key
+    if (!record.deferred.info.empty()) {
+        std::string_view rest = record.deferred.info;
+        while (!rest.empty()) {
+            const auto semicolon = rest.find(';');
+            const std::string_view entry = rest.substr(0, semicolon);
+            rest = semicolon == std::string_view::npos ? std::string_view{} : rest.substr(semicolon + 1);
+
+            const auto eq = entry.find('=');
+            if (entry.substr(0, eq) != key) {
+                continue;
+            }
+            if (eq == std::string_view::npos) {
+                return InfoValue{.kind = InfoValue::Kind::Flag, .text = {}, .number = std::nullopt};
+            }
+            return InfoValue{.kind = InfoValue::Kind::Value, .text = entry.substr(eq + 1), .number = std::nullopt};
+        }
+        return {};
+    }
+
+    // Decoded entries (keys dropped by a projection are absent)
+    for (const auto& field : record.info) {
+        if (field.key != key_id) {
+            continue;
+        }
+        switch (field.value.kind) {
+            case FieldValue::Kind::Flag:
+                return InfoValue{.kind = InfoValue::Kind::Flag, .text = {}, .number = std::nullopt};
+            case FieldValue::Kind::Missing:
+                return InfoValue{.kind = InfoValue::Kind::Value, .text = ".", .number = std::nullopt};
+            case FieldValue::Kind::Number:
+                return InfoValue{.kind = InfoValue::Kind::Value, .text = {}, .number = field.value.number};
+            case FieldValue::Kind::String:
+                return InfoValue{.kind = InfoValue::Kind::Value, .text = field.value.text, .number = std::nullopt};
+        }
+    }
+    return {};
+}
+
+// ---------- Lexer ----------
+
+enum class TokenKind { Word, Number, String, Op, In, And, Or, Not, LParen, RParen, Comma, End };
+
+struct Token {
+    TokenKind kind{TokenKind::End};
+    std::string_view text;  // Source text (without quotes for strings)
+    std::size_t pos{0};
+    Op op{Op::Eq};          // TokenKind::Op
+};
+
+bool is_word_char(char c)
+{
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.' || c == '/' || c == ':' ||
+           c == '*' || c == '-' || c == '+';
+}
+
+class Lexer {
+public:
+    explicit Lexer(std::string_view source)
+        : source_(source)
+    {
+    }
+
+    Token next()
+    {
+        while (pos_ < source_.size() && std::isspace(static_cast<unsigned char>(source_[pos_]))) {
+            ++pos_;
+        }
+        const std::size_t start = pos_;
+        if (pos_ == source_.size()) {
+            return Token{.kind = TokenKind::End, .text = {}, .pos = start, .op = Op::Eq};
+        }
+
+        auto symbol = [&](TokenKind kind, std::size_t length, Op op = Op::Eq) {
+            pos_ += length;
+            return Token{.kind = kind, .text = source_.substr(start, length), .pos = start, .op = op};
+        };
+        auto starts = [&](std::string_view text) { return source_.substr(pos_).starts_with(text); };
+
+        if (starts("&&")) return symbol(TokenKind::And, 2);
+        if (starts("||")) return symbol(TokenKind::Or, 2);
+        if (starts("==")) return symbol(TokenKind::Op, 2, Op::Eq);
+        if (starts("!=")) return symbol(TokenKind::Op, 2, Op::Ne);
+        if (starts("<=")) return symbol(TokenKind::Op, 2, Op::Le);
+        if (starts(">=")) return symbol(TokenKind::Op, 2, Op::Ge);
+
+        const char c = source_[pos_];
+        switch (c) {
+            case '=': return symbol(TokenKind::Op, 1, Op::Eq);
+            case '<': return symbol(TokenKind::Op, 1, Op::Lt);
+            case '>': return symbol(TokenKind::Op, 1, Op::Gt);
+            case '!': return symbol(TokenKind::Not, 1);
+            case '(': return symbol(TokenKind::LParen, 1);
+            case ')': return symbol(TokenKind::RParen, 1);
+            case ',': return symbol(TokenKind::Comma, 1);
+            case '"':
+            case '\'': {
+                const auto close = source_.find(c, pos_ + 1);
+                if (close == std::string_view::npos) {
+                    throw error("unterminated string", start);
+                }
+                pos_ = close + 1;
+                return Token{.kind = TokenKind::String, .text = source_.substr(start + 1, close - start - 1),
+                             .pos = start, .op = Op::Eq};
+            }
+            default:
+                break;
+        }
+
+        if (!is_word_char(c)) {
+            throw error(utils::format("unexpected '{}'", c), start);
+        }
+        while (pos_ < source_.size() && is_word_char(source_[pos_])) {
+            ++pos_;
+        }
+        const std::string_view text = source_.substr(start, pos_ - start);
+        if (text == "in") {
+            return Token{.kind = TokenKind::In, .text = text, .pos = start, .op = Op::Eq};
+        }
+        const TokenKind kind = to_number(text) ? TokenKind::Number : TokenKind::Word;
+        return Token{.kind = kind, .text = text, .pos = start, .op = Op::Eq};
+    }
+
+    ValidationError error(std::string_view message, std::size_t pos) const
+    {
+        return ValidationError(utils::format("Filter: {} at position {} in '{}'", message, pos + 1, source_));
+    }
+
+private:
+    std::string_view source_;
+    std::size_t pos_{0};
+};
+
+// ---------- Compiler ----------
+
+class Compiler {
+public:
+    Compiler(std::string_view source, header::VcfDictionary& dictionary)
+        : lexer_(source)
+        , dictionary_(dictionary)
+    {
+        advance();
+    }
+
+    Predicate compile()
+    {
+        Predicate predicate = parse_or();
+        if (token_.kind != TokenKind::End) {
+            throw lexer_.error(utils::format("unexpected '{}'", token_.text), token_.pos);
+        }
+        return predicate;
+    }
+
+    std::vector<std::string> take_info_keys() { return std::move(info_keys_); }
+
+private:
+    enum class Field { Chrom, Pos, Ref, Alt, Qual, Filter, Info };
+
+    void advance() { token_ = lexer_.next(); }
+
+    Token expect(TokenKind kind, std::string_view what)
+    {
+        if (token_.kind != kind) {
+            throw lexer_.error(utils::format("expected {}", what), token_.pos);
+        }
+        Token token = token_;
+        advance();
+        return token;
+    }
+
+    Predicate parse_or()
+    {
+        Predicate left = parse_and();
+        while (token_.kind == TokenKind::Or) {
+            advance();
+            left = [a = std::move(left), b = parse_and()](const VcfRecord& r) { return a(r) || b(r); };
+        }
+        return left;
+    }
+
+    Predicate parse_and()
+    {
+        Predicate left = parse_unary();
+        while (token_.kind == TokenKind::And) {
+            advance();
+            left = [a = std::move(left), b = parse_unary()](const VcfRecord& r) { return a(r) && b(r); };
+        }
+        return left;
+    }
+
+    Predicate parse_unary()
+    {
+        if (token_.kind == TokenKind::Not) {
+            advance();
+            return [a = parse_unary()](const VcfRecord& r) { return !a(r); };
+        }
+        if (token_.kind == TokenKind::LParen) {
+            advance();
+            Predicate inner = parse_or();
+            expect(TokenKind::RParen, "')'");
+            return inner;
+        }
+        return parse_comparison();
+    }
+
+    Predicate parse_comparison()
+    {
+        const Token name = expect(TokenKind::Word, "a field (CHROM, POS, REF, ALT, QUAL, FILTER, INFO.<key>)");
+        std::string_view info_key;
+        const Field field = field_of(name, info_key);
+        if (field == Field::Info
+            && std::find(info_keys_.begin(), info_keys_.end(), info_key) == info_keys_.end()) {
+            info_keys_.emplace_back(info_key);
+        }
+
+        if (token_.kind == TokenKind::In) {
+            advance();
+            expect(TokenKind::LParen, "'(' after 'in'");
+            std::vector<Token> values{literal()};
+            while (token_.kind == TokenKind::Comma) {
+                advance();
+                values.push_back(literal());
+            }
+            expect(TokenKind::RParen, "')'");
+            return membership(field, name, info_key, values);
+        }
+
+        if (token_.kind != TokenKind::Op) {
+            if (field == Field::Info) {
+                // Bare INFO.<key>: present (flag or value)
+                return [key = std::string(info_key), id = info_id(info_key)](const VcfRecord& r) {
+                    return find_info(r, key, id).kind != InfoValue::Kind::Absent;
+                };
+            }
+            throw lexer_.error(utils::format("expected a comparison after '{}'", name.text), token_.pos);
+        }
+        const Token op = token_;
+        advance();
+        return comparison(field, name, info_key, op, literal());
+    }
+
+    Token literal()
+    {
+        if (token_.kind != TokenKind::Word && token_.kind != TokenKind::Number && token_.kind != TokenKind::String) {
+            throw lexer_.error("expected a value", token_.pos);
+        }
+        Token token = token_;
+        advance();
+        return token;
+    }
+
+    Field field_of(const Token& name, std::string_view& info_key) const
+    {
+        const std::string_view text = name.text;
+        if (text == "CHROM") return Field::Chrom;
+        if (text == "POS") return Field::Pos;
+        if (text == "REF") return Field::Ref;
+        if (text == "ALT") return Field::Alt;
+        if (text == "QUAL") return Field::Qual;
+        if (text == "FILTER") return Field::Filter;
+        if ((text.starts_with("INFO.") || text.starts_with("INFO/")) && text.size() > 5) {
+            info_key = text.substr(5);
+            return Field::Info;
+        }
+        throw lexer_.error(utils::format("unknown field '{}'", text), name.pos);
+    }
+
+    StringId info_id(std::string_view key) const
+    {
+        return dictionary_.info_keys.intern(key);
+    }
+
+    std::optional<double> number_of(const Token& value) const
+    {
+        return value.kind == TokenKind::Number ? to_number(value.text) : std::nullopt;
+    }
+
+    Predicate comparison(Field field, const Token& name, std::string_view info_key, const Token& op, const Token& value)
+    {
+        const bool equality = op.op == Op::Eq || op.op == Op::Ne;
+        const bool negate = op.op == Op::Ne;
+        auto need_number = [&] {
+            auto number = number_of(value);
+            if (!number) {
+                throw lexer_.error(utils::format("'{}' needs a number", name.text), value.pos);
+            }
+            return *number;
+        };
+        auto need_equality = [&] {
+            if (!equality) {
+                throw lexer_.error(utils::format("'{}' only supports == and !=", name.text), op.pos);
+            }
+        };
+
+        switch (field) {
+            case Field::Chrom:
+            case Field::Filter: {
+                need_equality();
+                const bool chrom = field == Field::Chrom;
+                const StringId id = chrom ? dictionary_.contigs.intern(value.text) : dictionary_.filters.intern(value.text);
+                if (chrom) {
+                    return [id, negate](const VcfRecord& r) { return (r.chromosome == id) != negate; };
+                }
+                return [id, negate](const VcfRecord& r) { return (r.filter == id) != negate; };
+            }
+            case Field::Ref:
+            case Field::Alt: {
+                need_equality();
+                const bool ref = field == Field::Ref;
+                return [text = std::string(value.text), ref, negate](const VcfRecord& r) {
+                    return ((ref ? r.ref : r.alt) == text) != negate;
+                };
+            }
+            case Field::Pos:
+                return [number = need_number(), o = op.op](const VcfRecord& r) {
+                    return compare(static_cast<double>(r.position), o, number);
+                };
+            case Field::Qual:
+                return [number = need_number(), o = op.op](const VcfRecord& r) {
+                    return r.qual && compare(*r.qual, o, number);
+                };
+            case Field::Info:
+                break;
+        }
+
+        const StringId id = info_id(info_key);
+        if (auto number = number_of(value)) {
+            return [key = std::string(info_key), id, number = *number, o = op.op](const VcfRecord& r) {
+                const InfoValue info = find_info(r, key, id);
+                if (info.kind != InfoValue::Kind::Value) {
+                    return false;
+                }
+                return info.number ? compare(*info.number, o, number) : any_number(info.text, o, number);
+            };
+        }
+        need_equality();
+        return [key = std::string(info_key), id, text = std::string(value.text), negate](const VcfRecord& r) {
+            const InfoValue info = find_info(r, key, id);
+            if (info.kind != InfoValue::Kind::Value || info.number || info.text == ".") {
+                return false;
+            }
+            return (info.text == text) != negate;
+        };
+    }
+
+    Predicate membership(Field field, const Token& name, std::string_view info_key, const std::vector<Token>& values)
+    {
+        switch (field) {
+            case Field::Chrom:
+            case Field::Filter: {
+                const bool chrom = field == Field::Chrom;
+                std::vector<StringId> ids;
+                for (const auto& value : values) {
+                    ids.push_back(chrom ? dictionary_.contigs.intern(value.text) : dictionary_.filters.intern(value.text));
+                }
+                return [ids = std::move(ids), chrom](const VcfRecord& r) {
+                    return std::find(ids.begin(), ids.end(), chrom ? r.chromosome : r.filter) != ids.end();
+                };
+            }
+            case Field::Pos:
+            case Field::Qual:
+                throw lexer_.error(utils::format("'{}' does not support 'in'", name.text), name.pos);
+            case Field::Ref:
+            case Field::Alt:
+            case Field::Info:
+                break;
+        }
+
+        std::vector<std::string> texts;
+        for (const auto& value : values) {
+            texts.emplace_back(value.text);
+        }
+        if (field == Field::Info) {
+            return [key = std::string(info_key), id = info_id(info_key), texts = std::move(texts)](const VcfRecord& r) {
+                const InfoValue info = find_info(r, key, id);
+                return info.kind == InfoValue::Kind::Value && !info.number &&
+                       std::find(texts.begin(), texts.end(), info.text) != texts.end();
+            };
+        }
+        const bool ref = field == Field::Ref;
+        return [texts = std::move(texts), ref](const VcfRecord& r) {
+            return std::find(texts.begin(), texts.end(), ref ? r.ref : r.alt) != texts.end();
+        };
+    }
+
+    Lexer lexer_;
+    header::VcfDictionary& dictionary_;
+    Token token_;
+    std::vector<std::string> info_keys_;  // INFO keys the expression tests, in order of appearance
+};
+
+} // namespace
+
+RecordFilter RecordFilter::compile(std::string_view expression, header::VcfDictionary& dictionary)
+{
+    Compiler compiler(expression, dictionary);
+    Predicate predicate = compiler.compile();
+    return RecordFilter(std::string(expression), std::move(predicate), compiler.take_info_keys());
+}
+
+} // namespace vcf_tool::domain::filter
@@ -0,0 +1,80 @@
+// RecordFilter.h
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../entity/VcfRecord.h"
+#include "../header/VcfDictionary.h"
+
+
+namespace vcf_tool::domain::filter {
+
+/**
+ * @brief Compiled --filter expression, evaluated on the fixed columns of a record
+ *
+ * Grammar (whitespace is free):
+ *
+ *   expr       := and ('||' and)*
+ *   and        := unary ('&&' unary)*
+ *   unary      := '!' unary | '(' expr ')' | comparison
+ *   comparison := field (op literal | 'in' '(' literal (',' literal)* ')')?
+ *   field      := CHROM | POS | REF | ALT | QUAL | FILTER | INFO.<key>
+ *   op         := == | != | < | <= | > | >=
+ *   literal    := number | "string" | 'string' | bare word (chr1, PASS)
+ *
+ * e.g. `FILTER=="PASS" && QUAL>=30 && INFO.AF>0.01 && CHROM in (chr1,chr2)`
+ *
+ * The expression is compiled once into a tree of typed closures. CHROM and
+ * FILTER literals are interned up front, so those tests compare IDs. INFO
+ * values are looked up in the record's deferred INFO text (or its decoded
+ * entries), without decoding the column; a bare `INFO.<key>` tests that the
+ * key is present (flags). A numeric test on a list ("AC=3,5") holds if any
+ * value satisfies it. Comparisons against a missing value (QUAL ".", an
+ * absent INFO key or ".") are false.
+ *
+ * The parsers evaluate it on the record as written. Without multiallelic
+ * splitting that is the line itself, tested before INFO / FORMAT are
+ * decoded. With splitting it is each biallelic part after the split:
+ * ALT, POS and REF are the part's trimmed alleles, and a Number=A/R/G
+ * INFO list holds only the part's values. The INFO keys it tests must then
+ * survive the INFO projection (info_keys()).
+ *
+ * Thread Safety: immutable after compile(); shared by all parser threads.
+ */
+class RecordFilter {
+public:
+    using Predicate = std::function<bool(const VcfRecord&)>;
+
+    /**
+     * Compile `expression`; CHROM / FILTER literals are interned in `dictionary`.
+     *
+     * @throws ValidationError with the offending position if the expression is invalid
+     */
+    static RecordFilter compile(std::string_view expression, header::VcfDictionary& dictionary);
+
+    /// The record passes the filter (its fixed columns are decoded)
+    bool matches(const VcfRecord& record) const { return predicate_(record); }
+
+    const std::string& expression() const { return expression_; }
+
+    /// INFO keys the expression tests
+    const std::vector<std::string>& info_keys() const { return info_keys_; }
+
+private:
+    RecordFilter(std::string expression, Predicate predicate, std::vector<std::string> info_keys)
+        : expression_(std::move(expression))
+        , predicate_(std::move(predicate))
+        , info_keys_(std::move(info_keys))
+    {
+    }
+
+    std::string expression_;
+    Predicate predicate_;
+    std::vector<std::string> info_keys_;
+};
+
+} // namespace vcf_tool::domain::filter
@@ -0,0 +1,92 @@
+// FieldProjection.cpp
+#include "FieldProjection.h"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+
+namespace vcf_tool::domain::header {
+
+namespace {
+
+// Seeds tried per table size before the table doubles
+constexpr std::uint64_t kSeedsPerSize = 64;
+
+std::string_view trim(std::string_view text)
+{
+    const auto first = text.find_first_not_of(" \t");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    return text.substr(first, text.find_last_not_of(" \t") - first + 1);
+}
+
+} // namespace
+
+std::uint64_t FieldProjection::hash(std::string_view key, std::uint64_t seed)
+{
+    // FNV-1a with a seeded basis, high bits folded into the low ones used by the mask
+    std::uint64_t h = 14695981039346656037ull ^ (seed * 0x9E3779B97F4A7C15ull);
+    for (char c : key) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ull;
+    }
+    return h ^ (h >> 29);
+}
+
+FieldProjection::FieldProjection(std::vector<std::string> names, bool exclude)
+    : names_(std::move(names))
+    , exclude_(exclude)
+{
+    std::sort(names_.begin(), names_.end());
+    names_.erase(std::unique(names_.begin(), names_.end()), names_.end());
+    if (names_.empty()) {
+        return;
+    }
+
+    // Search for a seed without collisions; a larger table makes one easier to find
+    std::size_t size = std::bit_ceil(std::max<std::size_t>(8, names_.size() * 2));
+    for (std::uint64_t seed = 0;; ++seed) {
+        if (seed != 0 && seed % kSeedsPerSize == 0) {
+            size *= 2;
+        }
+        const std::uint64_t mask = size - 1;
+        std::vector<std::uint32_t> slots(size, kEmpty);
+        bool collision = false;
+        for (std::uint32_t i = 0; i < names_.size() && !collision; ++i) {
+            auto& slot = slots[hash(names_[i], seed) & mask];
+            collision = slot != kEmpty;
+            slot = i;
+        }
+        if (!collision) {
+            slots_ = std::move(slots);
+            seed_ = seed;
+            mask_ = mask;
+            return;
+        }
+    }
+}
+
+FieldProjection FieldProjection::parse(std::string_view spec)
+{
+    const bool exclude = !spec.empty() && spec.front() == '^';
+    if (exclude) {
+        spec.remove_prefix(1);
+    }
+
+    std::vector<std::string> names;
+    while (!spec.empty()) {
+        const auto comma = spec.find(',');
+        if (auto name = trim(spec.substr(0, comma)); !name.empty()) {
+            names.emplace_back(name);
+        }
+        spec = comma == std::string_view::npos ? std::string_view{} : spec.substr(comma + 1);
+    }
+    if (names.empty()) {
+        return {};
+    }
+    return FieldProjection(std::move(names), exclude);
+}
+
+} // namespace vcf_tool::domain::header
@@ -0,0 +1,65 @@
+// FieldProjection.h
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace vcf_tool::domain::header {
+
+/**
+ * @brief INFO or FORMAT keys kept by the parsers
+ *
+ * Compiled once from an include list ("AF,DP") or an exclude list
+ * ("^CSQ,ANN") into a perfect hash over the listed names: testing a key is
+ * one hash of its bytes, one slot and at most one string compare, so the
+ * parser can drop unwanted keys before interning or converting them.
+ *
+ * A default-constructed projection keeps every key.
+ *
+ * Thread Safety: immutable after construction; shared by all parsers.
+ */
+class FieldProjection {
+public:
+    FieldProjection() = default;
+
+    /// Keep only `names` (or everything but them if `exclude`)
+    FieldProjection(std::vector<std::string> names, bool exclude);
+
+    /// Comma-separated names, with a leading '^' for an exclude list; empty keeps every key
+    static FieldProjection parse(std::string_view spec);
+
+    bool keeps(std::string_view key) const { return listed(key) != exclude_; }
+
+    /// Keeps every key (nothing to check)
+    bool keeps_all() const { return exclude_ && names_.empty(); }
+
+    bool excludes() const { return exclude_; }
+    const std::vector<std::string>& names() const { return names_; }
+
+private:
+    static constexpr std::uint32_t kEmpty = UINT32_MAX;
+
+    static std::uint64_t hash(std::string_view key, std::uint64_t seed);
+
+    bool listed(std::string_view key) const
+    {
+        if (slots_.empty()) {
+            return false;
+        }
+        const std::uint32_t index = slots_[hash(key, seed_) & mask_];
+        return index != kEmpty && names_[index] == key;
+    }
+
+    std::vector<std::string> names_;
+    bool exclude_{true};
+
+    // Perfect hash: slots_[hash(name, seed_) & mask_] is the index of `name` in names_
+    std::vector<std::uint32_t> slots_;
+    std::uint64_t seed_{0};
+    std::uint64_t mask_{0};
+};
+
+} // namespace vcf_tool::domain::header
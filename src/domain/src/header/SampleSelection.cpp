@@ -0,0 +1,99 @@
+// SampleSelection.cpp
+#include "SampleSelection.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+#include <vcf_tool/utils/Errors.h>
+#include <vcf_tool/utils/Format.h>
+
+
+namespace vcf_tool::domain::header {
+
+using utils::errors::IOError;
+using utils::errors::ValidationError;
+
+namespace {
+
+std::string_view trim(std::string_view text)
+{
+    const auto first = text.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+}
+
+std::vector<std::string> names_of(std::string_view spec)
+{
+    std::vector<std::string> names;
+    std::error_code ec;
+    if (std::filesystem::is_regular_file(std::filesystem::path(spec), ec)) {
+        std::ifstream in{std::string(spec)};
+        if (!in.is_open()) {
+            throw IOError(utils::format("Cannot open sample file '{}'", spec));
+        }
+        std::string line;
+        while (std::getline(in, line)) {
+            if (auto name = trim(line); !name.empty()) {
+                names.emplace_back(name);
+            }
+        }
+        return names;
+    }
+
+    while (!spec.empty()) {
+        const auto comma = spec.find(',');
+        if (auto name = trim(spec.substr(0, comma)); !name.empty()) {
+            names.emplace_back(name);
+        }
+        spec = comma == std::string_view::npos ? std::string_view{} : spec.substr(comma + 1);
+    }
+    return names;
+}
+
+} // namespace
+
+SampleSelection SampleSelection::resolve(std::string_view spec, const std::vector<std::string>& samples)
+{
+    SampleSelection selection;
+    selection.total = samples.size();
+
+    // Without names, "^" (exclude nothing) and "" (no filter) both keep everything
+    const bool exclude = !spec.empty() && spec.front() == '^';
+    if (exclude) {
+        spec.remove_prefix(1);
+    }
+    const auto names = spec.empty() ? std::vector<std::string>{} : names_of(spec);
+    if (names.empty()) {
+        for (std::uint32_t i = 0; i < samples.size(); ++i) {
+            selection.columns.push_back(i);
+        }
+        return selection;
+    }
+    std::unordered_map<std::string_view, std::uint32_t> index;
+    index.reserve(samples.size());
+    for (std::uint32_t i = 0; i < samples.size(); ++i) {
+        index.emplace(samples[i], i);
+    }
+
+    std::vector<bool> named(samples.size(), false);
+    for (const auto& name : names) {
+        auto it = index.find(name);
+        if (it == index.end()) {
+            throw ValidationError(utils::format("Sample '{}' is not in the #CHROM header", name));
+        }
+        named[it->second] = true;
+    }
+
+    for (std::uint32_t i = 0; i < samples.size(); ++i) {
+        if (named[i] != exclude) {
+            selection.columns.push_back(i);
+        }
+    }
+    return selection;
+}
+
+} // namespace vcf_tool::domain::header
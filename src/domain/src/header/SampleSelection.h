@@ -0,0 +1,39 @@
+// SampleSelection.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace vcf_tool::domain::header {
+
+/**
+ * @brief Sample columns kept by the parsers
+ *
+ * Indices into the #CHROM sample names, ascending: records keep the
+ * selected samples in file order whatever order the spec names them in.
+ */
+struct SampleSelection {
+    std::vector<std::uint32_t> columns;  // Selected sample columns (0 = first after FORMAT)
+    std::size_t total{0};                // Sample columns in the header
+
+    /// Every sample is selected (nothing to skip)
+    bool all() const { return columns.size() == total; }
+
+    /**
+     * Resolve `spec` against the #CHROM sample names.
+     *
+     * `spec` is a comma-separated list of names or the path of a file with
+     * one name per line; a leading '^' selects every sample except those.
+     * An empty spec selects all samples.
+     *
+     * @throws ValidationError if a name is not in `samples`
+     * @throws IOError if the name file cannot be read
+     */
+    static SampleSelection resolve(std::string_view spec, const std::vector<std::string>& samples);
+};
+
+} // namespace vcf_tool::domain::header
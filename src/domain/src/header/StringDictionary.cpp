@@ -0,0 +1,119 @@
+// StringDictionary.cpp
+#include "StringDictionary.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <functional>
+
+#include <vcf_tool/utils/Errors.h>
+#include <vcf_tool/utils/Format.h>
+
+
+namespace vcf_tool::domain::header {
+
+namespace {
+
+constexpr std::size_t kMinTableSize = 64;
+
+std::size_t hash_of(std::string_view text)
+{
+    return std::hash<std::string_view>{}(text);
+}
+
+} // namespace
+
+StringDictionary::Table::Table(std::size_t capacity)
+    : mask(capacity - 1)
+    , slots(std::make_unique<std::atomic<std::uint32_t>[]>(capacity))
+{
+}
+
+StringDictionary::StringDictionary(std::size_t expected)
+{
+    // Keep the load factor at or below 1/2
+    tables_.push_back(std::make_unique<Table>(std::bit_ceil(std::max(kMinTableSize, expected * 2))));
+    table_.store(tables_.back().get(), std::memory_order_release);
+}
+
+StringId StringDictionary::probe(const Table& table, std::string_view text, std::size_t hash) const
+{
+    for (std::size_t i = hash & table.mask;; i = (i + 1) & table.mask) {
+        std::uint32_t slot = table.slots[i].load(std::memory_order_acquire);
+        if (slot == 0) {
+            return kNoStringId;
+        }
+        if (resolve(slot - 1) == text) {
+            return slot - 1;
+        }
+    }
+}
+
+void StringDictionary::insert_slot(Table& table, StringId id, std::size_t hash)
+{
+    std::size_t i = hash & table.mask;
+    while (table.slots[i].load(std::memory_order_relaxed) != 0) {
+        i = (i + 1) & table.mask;
+    }
+    table.slots[i].store(id + 1, std::memory_order_release);
+}
+
+std::optional<StringId> StringDictionary::find(std::string_view text) const
+{
+    StringId id = probe(*table_.load(std::memory_order_acquire), text, hash_of(text));
+    if (id == kNoStringId) {
+        return std::nullopt;
+    }
+    return id;
+}
+
+StringId StringDictionary::intern(std::string_view text)
+{
+    const std::size_t hash = hash_of(text);
+    if (StringId id = probe(*table_.load(std::memory_order_acquire), text, hash); id != kNoStringId) {
+        return id;
+    }
+
+    std::scoped_lock lock(mutex_);
+    Table* table = table_.load(std::memory_order_relaxed);
+    if (StringId id = probe(*table, text, hash); id != kNoStringId) {
+        return id;  // Added by another thread meanwhile
+    }
+
+    const std::size_t count = size_.load(std::memory_order_relaxed);
+    if (count >= kMaxStrings) {
+        throw utils::errors::ValidationError(utils::format(
+            "String dictionary is full ({} distinct strings)", kMaxStrings));
+    }
+    const auto id = static_cast<StringId>(count);
+
+    // Copy the string, then publish it before its ID becomes findable
+    auto& block = blocks_[count >> kBlockBits];
+    std::string_view* entries = block.load(std::memory_order_relaxed);
+    if (!entries) {
+        entries = static_cast<std::string_view*>(
+            storage_.allocate(kBlockSize * sizeof(std::string_view), alignof(std::string_view)));
+        std::uninitialized_default_construct_n(entries, kBlockSize);
+        block.store(entries, std::memory_order_release);
+    }
+    char* bytes = static_cast<char*>(storage_.allocate(std::max<std::size_t>(text.size(), 1), 1));
+    std::memcpy(bytes, text.data(), text.size());
+    entries[count & (kBlockSize - 1)] = std::string_view(bytes, text.size());
+    size_.store(count + 1, std::memory_order_release);
+
+    if ((count + 1) * 2 > table->mask + 1) {
+        // Grow: readers keep probing the old table until the new one is published
+        auto grown = std::make_unique<Table>((table->mask + 1) * 2);
+        for (std::size_t i = 0; i < count; ++i) {
+            insert_slot(*grown, static_cast<StringId>(i), hash_of(resolve(static_cast<StringId>(i))));
+        }
+        insert_slot(*grown, id, hash);
+        table_.store(grown.get(), std::memory_order_release);
+        tables_.push_back(std::move(grown));
+    } else {
+        insert_slot(*table, id, hash);
+    }
+    return id;
+}
+
+} // namespace vcf_tool::domain::header
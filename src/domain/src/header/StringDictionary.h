@@ -0,0 +1,88 @@
+// StringDictionary.h
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "../entity/VcfRecord.h"
+
+
+namespace vcf_tool::domain::header {
+
+/**
+ * @brief Concurrent interning dictionary: string <-> small dense integer ID
+ *
+ * IDs are assigned 0, 1, 2, ... in insertion order and never change, so a
+ * dictionary seeded from the VCF header maps the i-th ##contig / ##INFO /
+ * ##FORMAT definition to ID i.
+ *
+ * Lookups of known strings are lock-free (open-addressing table of atomic
+ * slots). Adding a string takes a lock; the table grows by publishing a
+ * doubled copy, older tables stay alive for readers still probing them.
+ * Strings are copied once into dictionary-owned storage, so resolve() views
+ * stay valid for the dictionary's lifetime.
+ *
+ * Thread Safety: all methods may be called concurrently. An ID passed
+ * between threads must travel through a synchronizing channel (the
+ * pipeline queues) before being resolved.
+ */
+class StringDictionary {
+public:
+    explicit StringDictionary(std::size_t expected = 64);
+
+    StringDictionary(const StringDictionary&) = delete;
+    StringDictionary& operator=(const StringDictionary&) = delete;
+
+    /**
+     * ID of `text`, adding it if new.
+     *
+     * @throws ValidationError if the dictionary is full (kMaxStrings)
+     */
+    StringId intern(std::string_view text);
+
+    /// ID of `text` if present
+    std::optional<StringId> find(std::string_view text) const;
+
+    /// String of `id` (must be an ID returned by this dictionary)
+    std::string_view resolve(StringId id) const
+    {
+        return blocks_[id >> kBlockBits].load(std::memory_order_acquire)[id & (kBlockSize - 1)];
+    }
+
+    /// Number of distinct strings
+    std::size_t size() const { return size_.load(std::memory_order_acquire); }
+
+    static constexpr std::size_t kBlockBits = 10;
+    static constexpr std::size_t kBlockSize = std::size_t{1} << kBlockBits;
+    static constexpr std::size_t kMaxBlocks = 4096;
+    static constexpr std::size_t kMaxStrings = kBlockSize * kMaxBlocks;
+
+private:
+    // Slots hold ID + 1 (0 = empty)
+    struct Table {
+        explicit Table(std::size_t capacity);
+        std::size_t mask;
+        std::unique_ptr<std::atomic<std::uint32_t>[]> slots;
+    };
+
+    StringId probe(const Table& table, std::string_view text, std::size_t hash) const;
+    static void insert_slot(Table& table, StringId id, std::size_t hash);
+
+    std::atomic<Table*> table_;
+    std::array<std::atomic<std::string_view*>, kMaxBlocks> blocks_{};
+    std::atomic<std::size_t> size_{0};
+
+    std::mutex mutex_;  // Serializes inserts
+    std::vector<std::unique_ptr<Table>> tables_;  // Current and retired tables
+    std::pmr::monotonic_buffer_resource storage_;  // String bytes and ID blocks
+};
+
+} // namespace vcf_tool::domain::header
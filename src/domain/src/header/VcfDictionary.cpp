@@ -0,0 +1,43 @@
+// VcfDictionary.cpp
+#include "VcfDictionary.h"
+
+
+namespace vcf_tool::domain::header {
+
+namespace {
+
+void seed(StringDictionary& dictionary, const std::vector<FieldDefinition>& definitions)
+{
+    for (const auto& definition : definitions) {
+        dictionary.intern(definition.id);
+    }
+}
+
+} // namespace
+
+VcfDictionary::VcfDictionary(const VcfHeader& header)
+    : contigs(header.contigs.size())
+    , filters(header.filters.size() + 2)
+    , info_keys(header.info.size())
+    , format_keys(header.format.size())
+{
+    seed(contigs, header.contigs);
+    seed(filters, header.filters);
+    seed(info_keys, header.info);
+    seed(format_keys, header.format);
+
+    // By ID (a repeated declaration overrides the earlier one)
+    info_shapes.resize(info_keys.size());
+    for (const auto& definition : header.info) {
+        info_shapes[*info_keys.find(definition.id)] = definition.shape();
+    }
+    format_shapes.resize(format_keys.size());
+    for (const auto& definition : header.format) {
+        format_shapes[*format_keys.find(definition.id)] = definition.shape();
+    }
+
+    filters.intern("PASS");
+    filters.intern(".");
+}
+
+} // namespace vcf_tool::domain::header
@@ -0,0 +1,51 @@
+// VcfDictionary.h
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "StringDictionary.h"
+#include "VcfHeader.h"
+
+
+namespace vcf_tool::domain::header {
+
+/**
+ * @brief Interned strings of one VCF file, one namespace per column kind
+ *
+ * Seeded from the header so the i-th ##contig / ##FILTER / ##INFO /
+ * ##FORMAT definition has ID i in its namespace (look the definition up
+ * with `header.info[id]` when `id < header.info.size()`). Values the
+ * header does not declare are added on first sight by the parsers.
+ */
+struct VcfDictionary {
+    StringDictionary contigs;
+    StringDictionary filters;      // Whole FILTER column; "PASS" and "." always present
+    StringDictionary info_keys;
+    StringDictionary format_keys;
+    std::vector<ValueShape> info_shapes;    // By info key ID (declared keys only)
+    std::vector<ValueShape> format_shapes;  // By format key ID (declared keys only)
+
+    VcfDictionary() = default;
+    explicit VcfDictionary(const VcfHeader& header);
+
+    /// Declared shape of INFO key `key` (String / Variable if undeclared)
+    ValueShape info_shape(StringId key) const
+    {
+        return key < info_shapes.size() ? info_shapes[key] : ValueShape{};
+    }
+
+    /// Declared shape of FORMAT key `key` (String / Variable if undeclared)
+    ValueShape format_shape(StringId key) const
+    {
+        return key < format_shapes.size() ? format_shapes[key] : ValueShape{};
+    }
+
+    /// Distinct strings across all namespaces
+    std::size_t size() const
+    {
+        return contigs.size() + filters.size() + info_keys.size() + format_keys.size();
+    }
+};
+
+} // namespace vcf_tool::domain::header
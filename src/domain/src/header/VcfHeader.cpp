@@ -0,0 +1,189 @@
+// VcfHeader.cpp
+#include "VcfHeader.h"
+
+#include <charconv>
+#include <fstream>
+
+#include <vcf_tool/utils/Errors.h>
+#include <vcf_tool/utils/Format.h>
+
+
+namespace vcf_tool::domain::header {
+
+namespace {
+
+FieldDefinition definition_of(std::string_view body)
+{
+    auto attributes = VcfHeader::parse_attributes(body);
+    auto get = [&](std::string_view key) {
+        auto it = attributes.find(key);
+        return it != attributes.end() ? it->second : std::string{};
+    };
+    return FieldDefinition{
+        .id = get("ID"),
+        .number = get("Number"),
+        .type = get("Type"),
+        .description = get("Description"),
+    };
+}
+
+} // namespace
+
+std::uint32_t ValueShape::width(std::uint32_t alt_count, std::uint32_t ploidy) const
+{
+    switch (count) {
+        case Count::Fixed:
+            return fixed;
+        case Count::PerAlt:
+            return alt_count;
+        case Count::PerAllele:
+            return alt_count + 1;
+        case Count::PerGenotype:
+            // Haploid: one per allele; otherwise assume diploid
+            return ploidy == 1 ? alt_count + 1 : (alt_count + 1) * (alt_count + 2) / 2;
+        case Count::Variable:
+            break;
+    }
+    return 0;
+}
+
+ValueShape FieldDefinition::shape() const
+{
+    ValueShape shape;
+    if (type == "Integer") {
+        shape.type = ValueShape::Type::Integer;
+    } else if (type == "Float") {
+        shape.type = ValueShape::Type::Float;
+    } else if (type == "Flag") {
+        shape.type = ValueShape::Type::Flag;
+    } else if (type == "Character") {
+        shape.type = ValueShape::Type::Character;
+    }
+
+    if (number == "A") {
+        shape.count = ValueShape::Count::PerAlt;
+    } else if (number == "R") {
+        shape.count = ValueShape::Count::PerAllele;
+    } else if (number == "G") {
+        shape.count = ValueShape::Count::PerGenotype;
+    } else {
+        std::uint32_t n = 0;
+        auto [ptr, ec] = std::from_chars(number.data(), number.data() + number.size(), n);
+        if (ec == std::errc{} && ptr == number.data() + number.size() && n > 0) {
+            shape.count = ValueShape::Count::Fixed;
+            shape.fixed = n;
+        }
+    }
+    return shape;
+}
+
+VcfHeader VcfHeader::read(const std::string& path)
+{
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        throw utils::errors::IOError(utils::format("Cannot open '{}' to read its header", path));
+    }
+
+    VcfHeader header;
+    std::string line;
+    while (in.peek() == '#' && std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        header.parse_line(line);
+    }
+    return header;
+}
+
+void VcfHeader::parse_line(std::string_view line)
+{
+    if (line.empty() || line.front() != '#') {
+        return;
+    }
+    ++line_count;
+
+    if (line.starts_with("#CHROM")) {
+        // CHROM POS ID REF ALT QUAL FILTER INFO FORMAT SAMPLE...
+        constexpr std::size_t kFixedColumns = 9;
+        std::size_t column = 0;
+        std::size_t start = 0;
+        while (start <= line.size()) {
+            std::size_t tab = line.find('\t', start);
+            if (tab == std::string_view::npos) {
+                tab = line.size();
+            }
+            if (column++ >= kFixedColumns) {
+                samples.emplace_back(line.substr(start, tab - start));
+            }
+            start = tab + 1;
+        }
+        return;
+    }
+
+    if (!line.starts_with("##")) {
+        return;
+    }
+    line.remove_prefix(2);
+    std::size_t eq = line.find('=');
+    if (eq == std::string_view::npos) {
+        return;
+    }
+    std::string_view key = line.substr(0, eq);
+    std::string_view value = line.substr(eq + 1);
+
+    if (key == "fileformat") {
+        file_format = std::string(value);
+    } else if (key == "contig") {
+        contigs.push_back(definition_of(value));
+    } else if (key == "FILTER") {
+        filters.push_back(definition_of(value));
+    } else if (key == "INFO") {
+        info.push_back(definition_of(value));
+    } else if (key == "FORMAT") {
+        format.push_back(definition_of(value));
+    }
+}
+
+std::map<std::string, std::string, std::less<>> VcfHeader::parse_attributes(std::string_view body)
+{
+    std::map<std::string, std::string, std::less<>> attributes;
+    if (body.size() < 2 || body.front() != '<' || body.back() != '>') {
+        return attributes;
+    }
+    body = body.substr(1, body.size() - 2);
+
+    std::size_t i = 0;
+    while (i < body.size()) {
+        std::size_t eq = body.find('=', i);
+        if (eq == std::string_view::npos) {
+            break;
+        }
+        std::string key(body.substr(i, eq - i));
+        std::string value;
+        i = eq + 1;
+
+        if (i < body.size() && body[i] == '"') {
+            // Quoted: commas allowed, \" and \\ escaped
+            for (++i; i < body.size() && body[i] != '"'; ++i) {
+                if (body[i] == '\\' && i + 1 < body.size()) {
+                    ++i;
+                }
+                value += body[i];
+            }
+            i = body.find(',', i);
+        } else {
+            std::size_t comma = body.find(',', i);
+            value = std::string(body.substr(i, comma == std::string_view::npos ? std::string_view::npos : comma - i));
+            i = comma;
+        }
+
+        attributes.insert_or_assign(std::move(key), std::move(value));
+        if (i == std::string_view::npos) {
+            break;
+        }
+        ++i;
+    }
+    return attributes;
+}
+
+} // namespace vcf_tool::domain::header
@@ -0,0 +1,80 @@
+// VcfHeader.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace vcf_tool::domain::header {
+
+/**
+ * @brief Type and Number= of a declared INFO / FORMAT field
+ */
+struct ValueShape {
+    enum class Type : std::uint8_t { Integer, Float, Flag, Character, String };
+    enum class Count : std::uint8_t {
+        Fixed,        // Number=<n>
+        PerAlt,       // Number=A
+        PerAllele,    // Number=R
+        PerGenotype,  // Number=G
+        Variable      // Number=. (or undeclared)
+    };
+
+    Type type{Type::String};
+    Count count{Count::Variable};
+    std::uint32_t fixed{0};  // Count::Fixed
+
+    /// Values per sample for a record with `alt_count` ALT alleles and the given ploidy (0 = variable)
+    std::uint32_t width(std::uint32_t alt_count, std::uint32_t ploidy) const;
+};
+
+/**
+ * @brief One ##INFO / ##FORMAT / ##FILTER / ##contig definition
+ *
+ * Attributes of `##KEY=<ID=...,Number=...,Type=...,Description="...">`;
+ * attributes a line does not have are empty.
+ */
+struct FieldDefinition {
+    std::string id;
+    std::string number;       // "1", "A", "R", "G", "." ...
+    std::string type;         // "Integer", "Float", "Flag", "Character", "String"
+    std::string description;
+
+    /// Parsed Type= / Number= (String / Variable when absent or unknown)
+    ValueShape shape() const;
+};
+
+/**
+ * @brief Meta-information lines and #CHROM line of a VCF file
+ *
+ * Definitions are kept in file order; the dictionary seeded from them
+ * (VcfDictionary) gives the i-th definition ID i.
+ */
+struct VcfHeader {
+    std::string file_format;              // ##fileformat=
+    std::vector<FieldDefinition> contigs;
+    std::vector<FieldDefinition> filters;
+    std::vector<FieldDefinition> info;
+    std::vector<FieldDefinition> format;
+    std::vector<std::string> samples;     // #CHROM columns after FORMAT
+    std::size_t line_count{0};            // Header lines, including #CHROM
+
+    /**
+     * Read the header of `path` (stops at the first data line).
+     *
+     * @throws IOError if the file cannot be opened
+     */
+    static VcfHeader read(const std::string& path);
+
+    /// Add one header line ("##..." or "#CHROM..."); other lines are ignored
+    void parse_line(std::string_view line);
+
+    /// `<key=value,key="quoted, value",...>` attributes of a structured line
+    static std::map<std::string, std::string, std::less<>> parse_attributes(std::string_view body);
+};
+
+} // namespace vcf_tool::domain::header
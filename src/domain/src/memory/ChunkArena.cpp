@@ -0,0 +1,167 @@
+// ChunkArena.cpp
+#include "ChunkArena.h"
+
+#include <bit>
+#include <cstring>
+#include <utility>
+
+
+namespace vcf_tool::domain::memory {
+
+ChunkArena::ChunkArena(std::size_t initial_bytes)
+    : capacity_(initial_bytes)
+    , buffer_(std::make_unique<std::byte[]>(initial_bytes))
+{
+    resource_.emplace(buffer_.get(), capacity_, std::pmr::new_delete_resource());
+}
+
+std::string_view ChunkArena::copy(std::string_view text)
+{
+    if (text.empty()) {
+        return {};
+    }
+    auto* data = static_cast<char*>(allocate_bytes(text.size(), alignof(char)));
+    std::memcpy(data, text.data(), text.size());
+    return {data, text.size()};
+}
+
+void* ChunkArena::allocate_bytes(std::size_t bytes, std::size_t alignment)
+{
+    used_ += bytes;
+    return resource_->allocate(bytes, alignment);
+}
+
+void ChunkArena::reset()
+{
+    release();
+    regrow();
+}
+
+void ChunkArena::release()
+{
+    if (used_ > capacity_) {
+        // Overflowed into upstream blocks: grow so the next chunk fits in one
+        grow_to_ = std::bit_ceil(used_ + used_ / 4);
+    }
+    resource_->release();
+    used_ = 0;
+}
+
+void ChunkArena::regrow()
+{
+    if (grow_to_ == 0) {
+        return;
+    }
+    capacity_ = std::exchange(grow_to_, 0);
+    resource_.reset();
+    buffer_ = std::make_unique<std::byte[]>(capacity_);
+    resource_.emplace(buffer_.get(), capacity_, std::pmr::new_delete_resource());
+}
+
+ArenaRef ChunkArena::create(std::size_t initial_bytes)
+{
+    return ArenaRef(new ChunkArena(initial_bytes));
+}
+
+// ---------- ArenaRef ----------
+
+ArenaRef::ArenaRef(ChunkArena* arena)
+    : arena_(arena)
+{
+    if (arena_) {
+        arena_->refs_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+ArenaRef::ArenaRef(const ArenaRef& other)
+    : ArenaRef(other.arena_)
+{
+}
+
+ArenaRef::ArenaRef(ArenaRef&& other) noexcept
+    : arena_(other.arena_)
+{
+    other.arena_ = nullptr;
+}
+
+ArenaRef& ArenaRef::operator=(const ArenaRef& other)
+{
+    if (arena_ != other.arena_) {
+        ArenaRef copy(other);
+        std::swap(arena_, copy.arena_);
+    }
+    return *this;
+}
+
+ArenaRef& ArenaRef::operator=(ArenaRef&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        arena_ = other.arena_;
+        other.arena_ = nullptr;
+    }
+    return *this;
+}
+
+ArenaRef::~ArenaRef()
+{
+    release();
+}
+
+void ArenaRef::release()
+{
+    if (!arena_) {
+        return;
+    }
+    ChunkArena* arena = std::exchange(arena_, nullptr);
+
+    // acq_rel: every writer to the arena happens-before its reset
+    if (arena->refs_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+    if (arena->pool_) {
+        arena->pool_->recycle(arena);
+    } else {
+        delete arena;
+    }
+}
+
+// ---------- ArenaPool ----------
+
+ArenaPool::ArenaPool(std::size_t initial_bytes)
+    : initial_bytes_(initial_bytes)
+{
+}
+
+ArenaRef ArenaPool::acquire()
+{
+    ChunkArena* arena = nullptr;
+    if (free_.try_dequeue(arena)) {
+        arena->regrow();
+        return ArenaRef(arena);
+    }
+
+    auto created = std::make_unique<ChunkArena>(initial_bytes_);
+    created->pool_ = this;
+    arena = created.get();
+    {
+        std::scoped_lock lock(mutex_);
+        arenas_.push_back(std::move(created));
+    }
+    size_.fetch_add(1, std::memory_order_relaxed);
+    return ArenaRef(arena);
+}
+
+std::size_t ArenaPool::size() const
+{
+    return size_.load(std::memory_order_relaxed);
+}
+
+void ArenaPool::recycle(ChunkArena* arena)
+{
+    // One release for all records of the chunk; growing waits for acquire()
+    arena->release();
+    free_.enqueue(arena);
+}
+
+} // namespace vcf_tool::domain::memory
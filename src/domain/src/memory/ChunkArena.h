@@ -0,0 +1,173 @@
+// ChunkArena.h
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <moodycamel/concurrentqueue.h>
+
+
+namespace vcf_tool::domain::memory {
+
+// Initial buffer of a fresh arena (grows to the observed high-water mark)
+inline constexpr std::size_t kDefaultArenaBytes = 64 * 1024;
+
+class ArenaPool;
+class ArenaRef;
+
+/**
+ * @brief Monotonic arena owning all memory of the records parsed from one chunk
+ *
+ * A parser copies each line into the arena and points the record's fields
+ * (string views, spans) into it, so parsing a chunk does no per-field heap
+ * allocation. Nothing is freed individually: reset() drops everything at
+ * once when the last record referencing the arena is gone.
+ *
+ * Only trivially destructible objects may live in an arena.
+ *
+ * Thread Safety:
+ *   - Allocation: one thread at a time (the parser that acquired it)
+ *   - References (ArenaRef): may be copied and dropped from any thread
+ */
+class ChunkArena {
+public:
+    explicit ChunkArena(std::size_t initial_bytes = kDefaultArenaBytes);
+
+    ChunkArena(const ChunkArena&) = delete;
+    ChunkArena& operator=(const ChunkArena&) = delete;
+
+    /// Copy `text` into the arena
+    std::string_view copy(std::string_view text);
+
+    /// Uninitialized storage for `count` objects of T
+    template<typename T>
+    std::span<T> allocate(std::size_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "arena objects are never destroyed");
+        if (count == 0) {
+            return {};
+        }
+        return {static_cast<T*>(allocate_bytes(count * sizeof(T), alignof(T))), count};
+    }
+
+    /// Resource for pmr containers whose lifetime ends with the arena
+    std::pmr::memory_resource* resource() { return &*resource_; }
+
+    /// Bytes handed out since the last reset
+    std::size_t bytes_used() const { return used_; }
+
+    /// Size of the initial (reused) buffer
+    std::size_t capacity() const { return capacity_; }
+
+    /**
+     * Release everything at once. If the arena overflowed its initial
+     * buffer, the buffer grows to the high-water mark so the next chunk
+     * fits in one block.
+     */
+    void reset();
+
+    /// Arena not owned by a pool (deleted with its last reference)
+    static ArenaRef create(std::size_t initial_bytes = kDefaultArenaBytes);
+
+private:
+    friend class ArenaRef;
+    friend class ArenaPool;
+
+    void* allocate_bytes(std::size_t bytes, std::size_t alignment);
+
+    // reset() in two steps, so a pooled arena is regrown by the thread that
+    // next allocates from it rather than by the one dropping its records
+    void release();
+    void regrow();
+
+    std::size_t capacity_;
+    std::size_t grow_to_{0};  // Buffer size for the next regrow() (0 = keep)
+    std::unique_ptr<std::byte[]> buffer_;
+    std::optional<std::pmr::monotonic_buffer_resource> resource_;
+    std::size_t used_{0};
+
+    std::atomic<std::uint32_t> refs_{0};
+    ArenaPool* pool_{nullptr};  // Returned here on last release (nullptr = delete)
+};
+
+/**
+ * @brief Shared reference keeping a ChunkArena alive
+ *
+ * Intrusively counted (no control block allocation). Every record parsed
+ * from a chunk holds one; when the writer drops the last record of the
+ * chunk, the arena is reset and goes back to its pool.
+ */
+class ArenaRef {
+public:
+    ArenaRef() = default;
+    explicit ArenaRef(ChunkArena* arena);
+
+    ArenaRef(const ArenaRef& other);
+    ArenaRef(ArenaRef&& other) noexcept;
+    ArenaRef& operator=(const ArenaRef& other);
+    ArenaRef& operator=(ArenaRef&& other) noexcept;
+    ~ArenaRef();
+
+    ChunkArena* get() const { return arena_; }
+    ChunkArena* operator->() const { return arena_; }
+    ChunkArena& operator*() const { return *arena_; }
+    explicit operator bool() const { return arena_ != nullptr; }
+
+private:
+    void release();
+
+    ChunkArena* arena_{nullptr};
+};
+
+/**
+ * @brief Arenas of a group of parser threads, recycled once their records are written
+ *
+ * A parser acquires an arena per chunk; the writer's release of the last
+ * record puts it back. In steady state the pool holds as many arenas as
+ * there are chunks in flight and parsing allocates nothing.
+ *
+ * Arena buffers are zeroed when created or regrown, both inside acquire(),
+ * so their pages are first touched by the acquiring thread: a pool used
+ * only by threads pinned to one NUMA node keeps its memory on that node.
+ *
+ * The free list is lock-free; only creating a new arena takes a lock.
+ *
+ * Must outlive every ArenaRef it handed out.
+ */
+class ArenaPool {
+public:
+    explicit ArenaPool(std::size_t initial_bytes = kDefaultArenaBytes);
+
+    ArenaPool(const ArenaPool&) = delete;
+    ArenaPool& operator=(const ArenaPool&) = delete;
+
+    /// A reset arena (reused if one is free)
+    ArenaRef acquire();
+
+    /// Arenas created so far
+    std::size_t size() const;
+
+private:
+    friend class ArenaRef;
+
+    // Called with the last reference: reset and make available again
+    void recycle(ChunkArena* arena);
+
+    std::size_t initial_bytes_;
+    moodycamel::ConcurrentQueue<ChunkArena*> free_;
+
+    std::mutex mutex_;  // Guards arenas_ (creation only)
+    std::vector<std::unique_ptr<ChunkArena>> arenas_;
+    std::atomic<std::size_t> size_{0};
+};
+
+} // namespace vcf_tool::domain::memory
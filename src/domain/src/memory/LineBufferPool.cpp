@@ -0,0 +1,40 @@
+// LineBufferPool.cpp
+#include "LineBufferPool.h"
+
+#include <algorithm>
+#include <iterator>
+
+
+namespace vcf_tool::domain::memory {
+
+LineBufferPool::LineBufferPool(std::size_t max_buffers, std::size_t max_buffer_bytes)
+    : max_buffers_(max_buffers)
+    , max_buffer_bytes_(max_buffer_bytes)
+{
+}
+
+std::size_t LineBufferPool::acquire_bulk(std::vector<std::string>& out, std::size_t count)
+{
+    return free_.try_dequeue_bulk(std::back_inserter(out), count);
+}
+
+void LineBufferPool::release_bulk(std::vector<std::string>& buffers)
+{
+    // Oversized buffers are freed here; the rest keep their capacity
+    std::erase_if(buffers, [this](const std::string& buffer) {
+        return buffer.capacity() > max_buffer_bytes_;
+    });
+    for (auto& buffer : buffers) {
+        buffer.clear();
+    }
+
+    const std::size_t free = free_.size_approx();
+    const std::size_t room = free < max_buffers_ ? max_buffers_ - free : 0;
+    const std::size_t count = std::min(room, buffers.size());
+    if (count > 0) {
+        free_.enqueue_bulk(std::make_move_iterator(buffers.begin()), count);
+    }
+    buffers.clear();
+}
+
+} // namespace vcf_tool::domain::memory
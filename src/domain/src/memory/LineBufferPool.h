@@ -0,0 +1,51 @@
+// LineBufferPool.h
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <moodycamel/concurrentqueue.h>
+
+
+namespace vcf_tool::domain::memory {
+
+// Larger line buffers are freed rather than pooled
+inline constexpr std::size_t kMaxPooledLineBytes = 1 << 20;
+
+/**
+ * @brief Lock-free free list of line buffers shared by the reader and parsers
+ *
+ * The reader reads each line into a pooled std::string; once a parser has
+ * copied the line into its chunk arena it hands the buffer back, capacity
+ * intact. In steady state reading allocates nothing, and buffers are no
+ * longer allocated by one thread and freed by another (the worst case for
+ * malloc's per-thread arenas).
+ *
+ * Both ends work in bulk, one queue operation per chunk. At most
+ * `max_buffers` buffers are kept and none larger than `max_buffer_bytes`,
+ * so a burst or a single huge line cannot pin memory.
+ */
+class LineBufferPool {
+public:
+    explicit LineBufferPool(std::size_t max_buffers, std::size_t max_buffer_bytes = kMaxPooledLineBytes);
+
+    LineBufferPool(const LineBufferPool&) = delete;
+    LineBufferPool& operator=(const LineBufferPool&) = delete;
+
+    /// Append up to `count` pooled (empty) buffers to `out`; returns how many
+    std::size_t acquire_bulk(std::vector<std::string>& out, std::size_t count);
+
+    /// Take back every buffer in `buffers` (left empty)
+    void release_bulk(std::vector<std::string>& buffers);
+
+    /// Buffers currently free (approximate)
+    std::size_t size_approx() const { return free_.size_approx(); }
+
+private:
+    std::size_t max_buffers_;
+    std::size_t max_buffer_bytes_;
+    moodycamel::ConcurrentQueue<std::string> free_;
+};
+
+} // namespace vcf_tool::domain::memory
@@ -0,0 +1,127 @@
+// PipelineMetrics.h
+#pragma once
+
+#include <vcf_tool/core/Metrics.h>
+
+
+namespace vcf_tool::domain::metrics {
+
+using core::metrics::Counter;
+using core::metrics::Gauge;
+using core::metrics::Histogram;
+using core::metrics::MetricsRegistry;
+
+/**
+ * @brief Handles to every per-stage metric of one import
+ *
+ * Registered once on a MetricsRegistry; workers keep a reference and update
+ * the metrics directly (sharded relaxed atomics, no locks on the hot path).
+ *
+ * Durations are recorded in nanoseconds and exported in seconds. The
+ * `*_wait` counters accumulate time a stage spent blocked on its input
+ * queue: a stage that rarely waits is the saturated one.
+ */
+struct PipelineMetrics {
+    static constexpr double kNanosToSeconds = 1e-9;
+
+    explicit PipelineMetrics(MetricsRegistry& registry)
+        : lines_read(registry.counter(
+              "vcf_reader_lines_total", "Lines read from the input file"))
+        , bytes_read(registry.counter(
+              "vcf_reader_bytes_total", "Bytes read from the input file"))
+        , read_offset(registry.gauge(
+              "vcf_reader_offset_bytes", "Input offset reached by the reader"))
+        , input_bytes(registry.gauge(
+              "vcf_reader_input_bytes", "Input file size"))
+        , reader_active_ns(registry.counter(
+              "vcf_reader_active_nanoseconds_total", "Time the reader spent reading and enqueueing lines"))
+        , line_buffers_reused(registry.counter(
+              "vcf_reader_line_buffers_reused_total", "Line buffers the reader took back from the parsers"))
+        , parse_chunk_seconds(registry.histogram(
+              "vcf_parser_chunk_seconds", "Time to parse one dequeued chunk of lines", kNanosToSeconds))
+        , records_parsed(registry.counter(
+              "vcf_parser_records_total", "Lines parsed into records"))
+        , parser_wait_ns(registry.counter(
+              "vcf_parser_wait_nanoseconds_total", "Time parsers spent waiting on the line queue"))
+        , wide_lines(registry.counter(
+              "vcf_parser_wide_lines_total", "Lines whose sample columns were parsed in concurrent ranges"))
+        , filter_accepted(registry.counter(
+              "vcf_filter_accepted_total", "Records that passed the --filter expression"))
+        , filter_rejected(registry.counter(
+              "vcf_filter_rejected_total", "Records dropped by the --filter expression"))
+        , malformed_columns(registry.counter(
+              "vcf_parser_malformed_columns_total", "Lines rejected for having fewer than 8 columns"))
+        , malformed_position(registry.counter(
+              "vcf_parser_malformed_position_total", "Lines rejected for a POS that is not an integer"))
+        , records_split(registry.counter(
+              "vcf_parser_split_records_total", "Multiallelic records split into biallelic ones"))
+        , records_trimmed(registry.counter(
+              "vcf_parser_trimmed_records_total", "Records whose REF / ALT shared bases were trimmed"))
+        , duplicates(registry.counter(
+              "vcf_parser_duplicate_records_total", "Records dropped as duplicates of an earlier CHROM/POS/REF/ALT"))
+        , encode_seconds(registry.histogram(
+              "vcf_writer_encode_seconds", "Time to encode one batch to BSON", kNanosToSeconds))
+        , insert_seconds(registry.histogram(
+              "vcf_writer_insert_seconds", "Latency of one bulk insert", kNanosToSeconds))
+        , records_written(registry.counter(
+              "vcf_writer_records_total", "Records written to the database"))
+        , records_skipped(registry.counter(
+              "vcf_writer_skipped_total", "Records skipped (header and empty lines)"))
+        , batches(registry.counter(
+              "vcf_writer_batches_total", "Batches flushed"))
+        , failed_batches(registry.counter(
+              "vcf_writer_failed_batches_total", "Batches that were not fully written"))
+        , retries(registry.counter(
+              "vcf_writer_retries_total", "Bulk insert attempts that were retried"))
+        , writer_wait_ns(registry.counter(
+              "vcf_writer_wait_nanoseconds_total", "Time the writer spent waiting on the record queue"))
+        , active_parsers(registry.gauge(
+              "vcf_parser_active_workers", "Parser workers currently allowed to run"))
+        , encode_workers(registry.gauge(
+              "vcf_writer_encode_workers", "Threads encoding each batch"))
+        , parser_scale_ups(registry.counter(
+              "vcf_adaptive_scale_up_total", "Adaptive controller decisions that added a parser"))
+        , parser_scale_downs(registry.counter(
+              "vcf_adaptive_scale_down_total", "Adaptive controller decisions that parked a parser"))
+    {
+    }
+
+    // Reader
+    Counter& lines_read;
+    Counter& bytes_read;
+    Gauge& read_offset;
+    Gauge& input_bytes;
+    Counter& reader_active_ns;
+    Counter& line_buffers_reused;
+
+    // Parsers
+    Histogram& parse_chunk_seconds;
+    Counter& records_parsed;
+    Counter& parser_wait_ns;
+    Counter& wide_lines;
+    Counter& filter_accepted;
+    Counter& filter_rejected;
+    Counter& malformed_columns;   // Lenient mode (--max-errors): rejected lines per category
+    Counter& malformed_position;
+    Counter& records_split;       // --split-multiallelic
+    Counter& records_trimmed;
+    Counter& duplicates;          // --dedup
+
+    // Writer
+    Histogram& encode_seconds;
+    Histogram& insert_seconds;
+    Counter& records_written;
+    Counter& records_skipped;
+    Counter& batches;
+    Counter& failed_batches;
+    Counter& retries;
+    Counter& writer_wait_ns;
+
+    // Adaptive concurrency
+    Gauge& active_parsers;
+    Gauge& encode_workers;
+    Counter& parser_scale_ups;
+    Counter& parser_scale_downs;
+};
+
+} // namespace vcf_tool::domain::metrics
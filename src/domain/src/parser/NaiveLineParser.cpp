@@ -6,10 +6,12 @@
 
 namespace vcf_tool::domain::parser {
 
-ParsedRecord NaiveLineParser::operator()(const RawLine& raw) const {
+ParsedRecord NaiveLineParser::operator()(const RawLine& raw, const memory::ArenaRef& arena) const {
     ParsedRecord result;
     result.line_number = raw.line_number;
-    result.raw_text    = raw.text;
+    result.end_offset  = raw.end_offset;
+    result.arena       = arena;
+    result.raw_text    = arena->copy(raw.text);
     result.is_end      = raw.is_end;
 
     // Split on TAB delimiter (VCF format)
@@ -2,6 +2,7 @@
 
 #include "../entity/RawLine.h"
 #include "../entity/ParsedRecord.h"
+#include "../memory/ChunkArena.h"
 
 
 namespace vcf_tool::domain::parser {
@@ -19,9 +20,10 @@ struct NaiveLineParser {
     /**
      * @brief Parse a raw line into structured fields
      * @param raw The raw input line to parse
+     * @param arena Chunk arena the record's text is copied into
      * @return ParsedRecord containing extracted fields
      */
-    ParsedRecord operator()(const RawLine& raw) const;
+    ParsedRecord operator()(const RawLine& raw, const memory::ArenaRef& arena) const;
 };
 
 } // namespace vcf_tool::domain::parser
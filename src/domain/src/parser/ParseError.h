@@ -0,0 +1,63 @@
+// ParseError.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <vcf_tool/utils/Format.h>
+
+
+namespace vcf_tool::domain::parser {
+
+/**
+ * @brief Why a data line could not be parsed
+ *
+ * Returned by the non-throwing parse path instead of a ParsingError, so a
+ * lenient import handles a malformed line without unwinding the parser
+ * thread. Cheap to produce: the message is only formatted by reason().
+ */
+struct ParseError {
+    enum class Kind : std::uint8_t {
+        None,
+        Columns,   // Fewer than 8 tab-separated columns
+        Position,  // POS is not an unsigned integer
+    };
+
+    Kind kind{Kind::None};
+    std::size_t columns{0};  // Columns found (Columns)
+    std::string_view value;  // Offending text (Position), a view into the line
+
+    explicit operator bool() const { return kind != Kind::None; }
+
+    // Category name used in the reject file and the logs
+    static std::string_view category(Kind kind)
+    {
+        switch (kind) {
+            case Kind::None:
+                return "none";
+            case Kind::Columns:
+                return "columns";
+            case Kind::Position:
+                return "position";
+        }
+        return "unknown";
+    }
+
+    // Description without the line number
+    std::string reason() const
+    {
+        switch (kind) {
+            case Kind::None:
+                return {};
+            case Kind::Columns:
+                return utils::format("Expected at least 8 fields, got {}", columns);
+            case Kind::Position:
+                return utils::format("Invalid position '{}'", value);
+        }
+        return {};
+    }
+};
+
+} // namespace vcf_tool::domain::parser
@@ -0,0 +1,31 @@
+// ParserGate.cpp
+#include "ParserGate.h"
+
+
+namespace vcf_tool::domain::parser {
+
+void ParserGate::set_active(std::size_t n)
+{
+    {
+        std::scoped_lock lock(mutex_);
+        active_.store(n, std::memory_order_relaxed);
+    }
+    cv_.notify_all();
+}
+
+void ParserGate::open()
+{
+    {
+        std::scoped_lock lock(mutex_);
+        open_.store(true, std::memory_order_release);
+    }
+    cv_.notify_all();
+}
+
+void ParserGate::park(std::size_t index)
+{
+    std::unique_lock lock(mutex_);
+    cv_.wait(lock, [&] { return index < active() || is_open(); });
+}
+
+} // namespace vcf_tool::domain::parser
@@ -0,0 +1,60 @@
+// ParserGate.h
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+
+namespace vcf_tool::domain::parser {
+
+/**
+ * @brief Parks parser workers above a runtime-adjustable active count
+ *
+ * Parser i may dequeue work only while i < active(). The adaptive
+ * controller raises or lowers the active count; parked workers block on a
+ * condition variable and hold no work, so they cost nothing.
+ *
+ * End of stream: the first parser that receives a sentinel calls open(),
+ * which wakes every parked worker for good so each one can consume its own
+ * sentinel and exit (the reader always emits one per pool thread).
+ *
+ * Thread Safety:
+ *   - All methods are thread-safe; wait_turn() is lock-free when not parked
+ */
+class ParserGate {
+public:
+    explicit ParserGate(std::size_t active) : active_(active) {}
+
+    ParserGate(const ParserGate&) = delete;
+    ParserGate& operator=(const ParserGate&) = delete;
+
+    /// Change the number of workers allowed to run (ignored once open)
+    void set_active(std::size_t n);
+
+    std::size_t active() const noexcept { return active_.load(std::memory_order_relaxed); }
+    bool is_open() const noexcept { return open_.load(std::memory_order_acquire); }
+
+    /// Block while worker `index` is parked
+    void wait_turn(std::size_t index) {
+        if (index < active() || is_open()) {
+            return;
+        }
+        park(index);
+    }
+
+    /// Release all workers permanently (end of stream)
+    void open();
+
+private:
+    void park(std::size_t index);
+
+    std::atomic<std::size_t> active_;
+    std::atomic<bool> open_{false};
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+} // namespace vcf_tool::domain::parser
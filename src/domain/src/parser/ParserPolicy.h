@@ -0,0 +1,96 @@
+// ParserPolicy.h
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+
+namespace vcf_tool::domain::parser {
+
+/// How the parser treats the columns after INFO
+enum class SampleMode : std::uint8_t {
+    Runtime,    // Decided per line and per configuration (generic parser)
+    SitesOnly,  // Header declares no samples: FORMAT and beyond are ignored
+    All,        // Every sample column is parsed
+    Selected,   // Only the selected sample columns are copied and parsed
+};
+
+/// How the parser treats INFO keys
+enum class InfoMode : std::uint8_t {
+    Runtime,    // Projection checked if one is set (generic parser)
+    All,        // Every key is kept, no projection code
+    Projected,  // Every key is tested against the projection
+};
+
+/**
+ * @brief Compile-time options of BasicVcfLineParser
+ *
+ * Each option fixed here removes its runtime branch from the parser's inner
+ * loops; `Runtime` keeps the branch, so GenericPolicy handles any
+ * configuration. The pipeline picks the specialized variant matching the
+ * header and options once at startup (with_parser_policy).
+ */
+template<SampleMode Samples, InfoMode Info>
+struct ParserPolicy {
+    static constexpr SampleMode kSamples = Samples;
+    static constexpr InfoMode kInfo = Info;
+};
+
+using GenericPolicy = ParserPolicy<SampleMode::Runtime, InfoMode::Runtime>;
+
+/**
+ * Call `f(ParserPolicy<samples, info>{})` with the policy matching the
+ * runtime options and return its result. Every combination is a separate
+ * instantiation of whatever `f` is templated on.
+ */
+template<typename F>
+decltype(auto) with_parser_policy(SampleMode samples, InfoMode info, F&& f)
+{
+    const auto with_info = [&]<SampleMode S>() -> decltype(auto) {
+        if (info == InfoMode::Projected) {
+            return std::forward<F>(f)(ParserPolicy<S, InfoMode::Projected>{});
+        }
+        return std::forward<F>(f)(ParserPolicy<S, InfoMode::All>{});
+    };
+    switch (samples) {
+        case SampleMode::SitesOnly:
+            return with_info.template operator()<SampleMode::SitesOnly>();
+        case SampleMode::Selected:
+            return with_info.template operator()<SampleMode::Selected>();
+        case SampleMode::All:
+        case SampleMode::Runtime:
+            break;
+    }
+    return with_info.template operator()<SampleMode::All>();
+}
+
+inline std::string_view to_string(SampleMode mode)
+{
+    switch (mode) {
+        case SampleMode::Runtime:
+            return "runtime";
+        case SampleMode::SitesOnly:
+            return "sites-only";
+        case SampleMode::All:
+            return "all samples";
+        case SampleMode::Selected:
+            return "selected samples";
+    }
+    return "unknown";
+}
+
+inline std::string_view to_string(InfoMode mode)
+{
+    switch (mode) {
+        case InfoMode::Runtime:
+            return "runtime";
+        case InfoMode::All:
+            return "all INFO keys";
+        case InfoMode::Projected:
+            return "projected INFO";
+    }
+    return "unknown";
+}
+
+} // namespace vcf_tool::domain::parser
@@ -0,0 +1,73 @@
+// RejectLog.cpp
+#include "RejectLog.h"
+
+#include <filesystem>
+#include <utility>
+
+#include <vcf_tool/utils/Errors.h>
+#include <vcf_tool/utils/Format.h>
+#include <vcf_tool/utils/Logger.h>
+
+
+namespace vcf_tool::domain::parser {
+
+using utils::errors::IOError;
+using utils::errors::ParsingError;
+
+RejectLog::RejectLog(std::string path, std::size_t max_errors, bool append, metrics::PipelineMetrics& metrics)
+    : path_(std::move(path))
+    , max_errors_(max_errors)
+    , metrics_(metrics)
+{
+    if (path_.empty()) {
+        return;
+    }
+
+    std::error_code ec;
+    const auto existing = append ? std::filesystem::file_size(path_, ec) : 0;
+    const bool fresh = ec || existing == 0;  // Write the column header
+    out_.open(path_, append ? std::ios::app : std::ios::trunc);
+    if (!out_.is_open()) {
+        throw IOError(utils::format("Cannot open reject file '{}'", path_));
+    }
+    if (fresh) {
+        out_ << "#line\tcategory\treason\ttext\n";
+    }
+}
+
+void RejectLog::reject(const entity::RawLine& raw, const ParseError& error)
+{
+    switch (error.kind) {
+        case ParseError::Kind::Columns:
+            metrics_.malformed_columns.add();
+            break;
+        case ParseError::Kind::Position:
+            metrics_.malformed_position.add();
+            break;
+        case ParseError::Kind::None:
+            return;
+    }
+
+    const std::size_t count = count_.fetch_add(1, std::memory_order_relaxed) + 1;
+    const auto reason = error.reason();
+    if (count <= kLoggedRejects) {
+        LOG_WARN_F("Parser: rejected line {} ({}): {}", raw.line_number, ParseError::category(error.kind), reason);
+    }
+
+    if (out_.is_open()) {
+        std::lock_guard lock(mutex_);
+        out_ << raw.line_number << '\t' << ParseError::category(error.kind) << '\t' << reason << '\t'
+             << raw.text << '\n';
+    }
+
+    if (count > max_errors_) {
+        {
+            std::lock_guard lock(mutex_);
+            out_.flush();
+        }
+        throw ParsingError(utils::format("Line {}: {} (more than {} malformed lines)",
+                                         raw.line_number, reason, max_errors_));
+    }
+}
+
+} // namespace vcf_tool::domain::parser
@@ -0,0 +1,67 @@
+// RejectLog.h
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+#include "../entity/RawLine.h"
+#include "../metrics/PipelineMetrics.h"
+#include "ParseError.h"
+
+
+namespace vcf_tool::domain::parser {
+
+/**
+ * @brief Where a lenient import (--max-errors) puts the lines it cannot parse
+ *
+ * Each rejected line is counted in its category's metric and appended to
+ * the reject file as one tab-separated row:
+ *
+ *   line_number  category  reason  original line
+ *
+ * The first kLoggedRejects are also logged. Once more than `max_errors`
+ * lines were rejected, reject() throws and the import fails as it would
+ * have on the first one without --max-errors.
+ *
+ * Thread Safety: reject() may be called from every parser thread; rows
+ * are written under a mutex (malformed lines are expected to be rare).
+ */
+class RejectLog {
+public:
+    static constexpr std::size_t kLoggedRejects = 10;
+
+    /**
+     * @param path        Reject file (empty = count and log only)
+     * @param max_errors  Malformed lines tolerated before the import fails
+     * @param append      Keep the rows of a previous run (resume)
+     * @throws IOError if `path` cannot be opened
+     */
+    RejectLog(std::string path, std::size_t max_errors, bool append, metrics::PipelineMetrics& metrics);
+
+    /**
+     * Record `raw`, which failed to parse with `error`.
+     *
+     * @throws ParsingError if this is rejected line max_errors + 1
+     */
+    void reject(const entity::RawLine& raw, const ParseError& error);
+
+    // Lines rejected so far
+    std::size_t count() const { return count_.load(std::memory_order_relaxed); }
+
+    std::size_t max_errors() const { return max_errors_; }
+    const std::string& path() const { return path_; }
+
+private:
+    std::string path_;
+    std::size_t max_errors_;
+    metrics::PipelineMetrics& metrics_;
+    std::atomic<std::size_t> count_{0};
+
+    std::mutex mutex_;
+    std::ofstream out_;
+};
+
+} // namespace vcf_tool::domain::parser
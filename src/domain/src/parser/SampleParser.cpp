@@ -0,0 +1,418 @@
+// SampleParser.cpp
+#include "SampleParser.h"
+
+#include <algorithm>
+#include <charconv>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace vcf_tool::domain::parser {
+
+namespace {
+
+constexpr std::uint32_t kNoKey = UINT32_MAX;
+
+enum class Stored { Ok, TooWide, Untyped };
+
+std::uint32_t count_of(std::string_view text, char sep)
+{
+    return static_cast<std::uint32_t>(std::count(text.begin(), text.end(), sep)) + 1;
+}
+
+// Next `sep`-delimited token of `rest` (consumed from the front); `more` = a separator followed
+std::string_view next_token(std::string_view& rest, char sep, bool& more)
+{
+    std::size_t pos = rest.find(sep);
+    std::string_view token = rest.substr(0, pos);
+    more = pos != std::string_view::npos;
+    rest = more ? rest.substr(pos + 1) : std::string_view{};
+    return token;
+}
+
+// Alleles in a GT value ("0/1" = 2, "1" = 1, "|0|1" = 2)
+std::uint32_t ploidy_of(std::string_view gt)
+{
+    if (!gt.empty() && (gt.front() == '/' || gt.front() == '|')) {
+        gt.remove_prefix(1);
+    }
+    return 1 + static_cast<std::uint32_t>(std::count_if(gt.begin(), gt.end(),
+                                                        [](char c) { return c == '/' || c == '|'; }));
+}
+
+// One GT value as `ploidy` bytes ((allele + 1) << 1 | phased), padded with kGtEnd
+Stored store_genotype(std::string_view gt, std::uint8_t* out, std::uint32_t ploidy)
+{
+    std::uint32_t n = 0;
+    if (gt.empty()) {
+        out[n++] = 0;  // Missing subfield
+    } else {
+        bool phased = false;
+        if (gt.front() == '/' || gt.front() == '|') {
+            phased = gt.front() == '|';
+            gt.remove_prefix(1);
+        }
+        std::size_t i = 0;
+        while (true) {
+            std::uint32_t code = 0;  // Missing allele
+            if (i < gt.size() && gt[i] == '.') {
+                ++i;
+            } else {
+                std::uint32_t allele = 0;
+                auto [ptr, ec] = std::from_chars(gt.data() + i, gt.data() + gt.size(), allele);
+                if (ec != std::errc{} || allele > kMaxGtAllele) {
+                    return Stored::Untyped;
+                }
+                i = static_cast<std::size_t>(ptr - gt.data());
+                code = allele + 1;
+            }
+            if (n == ploidy) {
+                return Stored::TooWide;
+            }
+            out[n++] = static_cast<std::uint8_t>((code << 1) | (phased ? 1u : 0u));
+
+            if (i == gt.size()) {
+                break;
+            }
+            if (gt[i] != '/' && gt[i] != '|') {
+                return Stored::Untyped;
+            }
+            phased = gt[i] == '|';
+            ++i;
+        }
+    }
+    std::fill(out + n, out + ploidy, kGtEnd);
+    return Stored::Ok;
+}
+
+// Comma-separated numbers as `width` values, padded with `end`
+template<typename T>
+Stored store_numbers(std::string_view text, T* out, std::uint32_t width, T missing, T end)
+{
+    std::uint32_t n = 0;
+    if (text.empty()) {
+        out[n++] = missing;  // Missing subfield
+    } else {
+        bool more = true;
+        while (more) {
+            std::string_view item = next_token(text, ',', more);
+            if (n == width) {
+                return Stored::TooWide;
+            }
+            if (item == ".") {
+                out[n++] = missing;
+                continue;
+            }
+            T value{};
+            auto [ptr, ec] = std::from_chars(item.data(), item.data() + item.size(), value);
+            if (ec != std::errc{} || ptr != item.data() + item.size() || item.empty()) {
+                return Stored::Untyped;
+            }
+            if constexpr (std::is_same_v<T, std::int32_t>) {
+                if (value <= kEndInt) {
+                    return Stored::Untyped;  // Reserved for the sentinels
+                }
+            }
+            out[n++] = value;
+        }
+    }
+    std::fill(out + n, out + width, end);
+    return Stored::Ok;
+}
+
+// Parse one sample's value of key `k` into its slots, flagging what didn't fit
+void store(SampleParser::Plan& plan, std::uint32_t k, std::uint32_t sample, std::string_view value)
+{
+    Stored result = Stored::Ok;
+    if (k == plan.gt_key) {
+        result = store_genotype(value, plan.genotypes + std::size_t{sample} * plan.ploidy, plan.ploidy);
+        if (result == Stored::TooWide) {
+            plan.gt_too_wide.store(true, std::memory_order_relaxed);
+        } else if (result == Stored::Untyped) {
+            plan.gt_untyped.store(true, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    auto& key = plan.keys[k];
+    const std::size_t slot = std::size_t{sample} * key.column.width;
+    switch (key.column.type) {
+        case FormatColumn::Type::Integer:
+            result = store_numbers(value, key.integers + slot, key.column.width, kMissingInt, kEndInt);
+            break;
+        case FormatColumn::Type::Float:
+            result = store_numbers(value, key.floats + slot, key.column.width, kMissingFloat, kEndFloat);
+            break;
+        case FormatColumn::Type::String:
+            key.strings[sample] = value == "." ? std::string_view{} : value;
+            break;
+    }
+    if (result == Stored::TooWide) {
+        key.too_wide.store(true, std::memory_order_relaxed);
+    } else if (result == Stored::Untyped) {
+        key.untyped.store(true, std::memory_order_relaxed);
+    }
+}
+
+// Call fn(sample, value) with every sample's value of key `k` (empty if absent)
+template<typename Fn>
+void for_each_value(std::string_view samples, std::uint32_t k, Fn&& fn)
+{
+    std::uint32_t sample = 0;
+    bool more_samples = true;
+    while (more_samples) {
+        std::string_view rest = next_token(samples, '\t', more_samples);
+        std::string_view value;
+        bool more = true;
+        for (std::uint32_t i = 0; i <= k && more; ++i) {
+            value = next_token(rest, ':', more);
+            if (i < k && !more) {
+                value = {};
+            }
+        }
+        fn(sample++, value);
+    }
+}
+
+void allocate_column(SampleParser::KeyPlan& key, std::uint32_t sample_count, memory::ChunkArena& arena)
+{
+    const std::size_t slots = std::size_t{sample_count} * key.column.width;
+    switch (key.column.type) {
+        case FormatColumn::Type::Integer:
+            key.integers = arena.allocate<std::int32_t>(slots).data();
+            break;
+        case FormatColumn::Type::Float:
+            key.floats = arena.allocate<float>(slots).data();
+            break;
+        case FormatColumn::Type::String:
+            key.strings = arena.allocate<std::string_view>(sample_count).data();
+            break;
+    }
+}
+
+} // namespace
+
+SampleParser::Plan& SampleParser::plan(std::string_view format, std::string_view first_sample,
+                                       std::uint32_t sample_count, std::uint32_t alt_count,
+                                       memory::ChunkArena& arena) const
+{
+    Plan& plan = *std::construct_at(arena.allocate<Plan>(1).data());
+    plan.sample_count = sample_count;
+    plan.keys = arena.allocate<KeyPlan>(count_of(format, ':'));
+
+    bool more_keys = true;
+    bool more_values = true;
+    for (std::uint32_t k = 0; more_keys; ++k) {
+        KeyPlan& key = *std::construct_at(&plan.keys[k]);
+        std::string_view name = next_token(format, ':', more_keys);
+        std::string_view first_value = more_values ? next_token(first_sample, ':', more_values) : std::string_view{};
+
+        if (fields_ && !fields_->keeps(name)) {
+            key.skip = true;
+            continue;
+        }
+        plan.key_limit = k + 1;
+
+        key.column.key = dictionary_->format_keys.intern(name);
+        if (name == "GT" && plan.gt_key == kNoKey) {
+            plan.gt_key = k;
+            plan.ploidy = std::min(ploidy_of(first_value), kMaxPloidy);
+            continue;
+        }
+
+        // Header type and Number=; variable widths are taken from the first sample
+        const auto shape = dictionary_->format_shape(key.column.key);
+        switch (shape.type) {
+            case header::ValueShape::Type::Integer: key.column.type = FormatColumn::Type::Integer; break;
+            case header::ValueShape::Type::Float:   key.column.type = FormatColumn::Type::Float; break;
+            default:                                key.column.type = FormatColumn::Type::String; break;
+        }
+        if (key.column.type != FormatColumn::Type::String) {
+            key.column.width = shape.width(alt_count, plan.ploidy);
+            if (key.column.width == 0) {
+                key.column.width = count_of(first_value, ',');
+            }
+        }
+    }
+
+    plan.genotypes = arena.allocate<std::uint8_t>(std::size_t{sample_count} * plan.ploidy).data();
+    for (std::uint32_t k = 0; k < plan.keys.size(); ++k) {
+        if (k != plan.gt_key && !plan.keys[k].skip) {
+            allocate_column(plan.keys[k], sample_count, arena);
+        }
+    }
+    return plan;
+}
+
+void SampleParser::fill(Plan& plan, std::string_view samples, std::uint32_t first)
+{
+    bool more_samples = true;
+    for (std::uint32_t sample = first; more_samples && sample < plan.sample_count; ++sample) {
+        std::string_view rest = next_token(samples, '\t', more_samples);
+
+        // Trailing keys may be dropped from a sample: they are missing
+        bool more = true;
+        for (std::uint32_t k = 0; k < plan.key_limit; ++k) {
+            std::string_view value = more ? next_token(rest, ':', more) : std::string_view{};
+            if (!plan.keys[k].skip) {
+                store(plan, k, sample, value);
+            }
+        }
+    }
+}
+
+GenotypeMatrix SampleParser::finish(Plan& plan, std::string_view samples, memory::ChunkArena& arena) const
+{
+    auto as_strings = [&](std::uint32_t k) {
+        KeyPlan& key = plan.keys[k];
+        key.column.type = FormatColumn::Type::String;
+        key.column.width = 1;
+        allocate_column(key, plan.sample_count, arena);
+        for_each_value(samples, k, [&](std::uint32_t sample, std::string_view value) {
+            key.strings[sample] = value == "." ? std::string_view{} : value;
+        });
+    };
+
+    // GT: a sample with more alleles than the first one re-encodes the column;
+    // alleles that don't fit a byte keep GT as text
+    if (plan.gt_key != kNoKey && (plan.gt_too_wide || plan.gt_untyped)) {
+        bool encodable = !plan.gt_untyped;
+        if (encodable) {
+            std::uint32_t ploidy = 0;
+            for_each_value(samples, plan.gt_key, [&](std::uint32_t, std::string_view value) {
+                ploidy = std::max(ploidy, ploidy_of(value));
+            });
+            encodable = ploidy <= kMaxPloidy;
+            if (encodable) {
+                plan.ploidy = ploidy;
+                plan.genotypes = arena.allocate<std::uint8_t>(std::size_t{plan.sample_count} * ploidy).data();
+                plan.gt_too_wide = false;
+                for_each_value(samples, plan.gt_key, [&](std::uint32_t sample, std::string_view value) {
+                    store(plan, plan.gt_key, sample, value);
+                });
+                encodable = !plan.gt_untyped && !plan.gt_too_wide;
+            }
+        }
+        if (!encodable) {
+            const std::uint32_t gt_key = std::exchange(plan.gt_key, kNoKey);
+            plan.ploidy = 0;
+            plan.genotypes = nullptr;
+            as_strings(gt_key);
+        }
+    }
+
+    for (std::uint32_t k = 0; k < plan.keys.size(); ++k) {
+        KeyPlan& key = plan.keys[k];
+        if (k == plan.gt_key || key.skip || key.column.type == FormatColumn::Type::String) {
+            continue;
+        }
+        if (key.too_wide && !key.untyped) {
+            std::uint32_t width = 0;
+            for_each_value(samples, k, [&](std::uint32_t, std::string_view value) {
+                width = std::max(width, count_of(value, ','));
+            });
+            key.column.width = width;
+            key.too_wide = false;
+            allocate_column(key, plan.sample_count, arena);
+            for_each_value(samples, k, [&](std::uint32_t sample, std::string_view value) {
+                store(plan, k, sample, value);
+            });
+        }
+        if (key.untyped) {
+            as_strings(k);
+        }
+    }
+
+    // GT bytes plus one column per other key, in FORMAT order
+    GenotypeMatrix matrix;
+    matrix.sample_count = plan.sample_count;
+    matrix.ploidy = plan.ploidy;
+    matrix.genotypes = {plan.genotypes, std::size_t{plan.sample_count} * plan.ploidy};
+
+    const auto column_count = static_cast<std::size_t>(std::count_if(
+        plan.keys.begin(), plan.keys.end(), [](const KeyPlan& key) { return !key.skip; }))
+        - (plan.gt_key != kNoKey ? 1 : 0);
+    auto columns = arena.allocate<FormatColumn>(column_count);
+    std::size_t c = 0;
+    for (std::uint32_t k = 0; k < plan.keys.size(); ++k) {
+        if (k == plan.gt_key || plan.keys[k].skip) {
+            continue;
+        }
+        const KeyPlan& key = plan.keys[k];
+        FormatColumn column = key.column;
+        const std::size_t slots = std::size_t{plan.sample_count} * column.width;
+        switch (column.type) {
+            case FormatColumn::Type::Integer: column.integers = {key.integers, slots}; break;
+            case FormatColumn::Type::Float:   column.floats = {key.floats, slots}; break;
+            case FormatColumn::Type::String:  column.strings = {key.strings, plan.sample_count}; break;
+        }
+        columns[c++] = column;
+    }
+    matrix.columns = columns;
+    return matrix;
+}
+
+GenotypeMatrix SampleParser::parse(std::string_view format, std::string_view samples,
+                                   std::uint32_t alt_count, memory::ChunkArena& arena) const
+{
+    if (format.empty() || samples.empty()) {
+        return {};
+    }
+    const std::uint32_t sample_count = count_of(samples, '\t');
+    Plan& p = plan(format, samples.substr(0, samples.find('\t')), sample_count, alt_count, arena);
+    fill(p, samples, 0);
+    return finish(p, samples, arena);
+}
+
+GenotypeMatrix SampleParser::parse_parallel(std::string_view format, std::string_view samples,
+                                            std::uint32_t alt_count, memory::ChunkArena& arena,
+                                            core::ThreadPool& pool, std::size_t ranges) const
+{
+    if (format.empty() || samples.empty()) {
+        return {};
+    }
+
+    // Cut at the first tab after each 1/ranges of the bytes; counting the
+    // samples of each range gives the index of the next one's first sample
+    struct Range {
+        std::string_view text;
+        std::uint32_t first;
+    };
+    std::vector<Range> parts;
+    parts.reserve(ranges);
+    std::uint32_t sample_count = 0;
+    for (std::size_t start = 0, r = 1; start <= samples.size(); ++r) {
+        std::size_t end = r < ranges ? samples.find('\t', std::max(start, samples.size() * r / ranges)) : std::string_view::npos;
+        if (end == std::string_view::npos) {
+            end = samples.size();
+        }
+        const std::string_view text = samples.substr(start, end - start);
+        parts.push_back(Range{text, sample_count});
+        sample_count += count_of(text, '\t');
+        start = end + 1;
+    }
+
+    Plan& p = plan(format, parts.front().text.substr(0, parts.front().text.find('\t')),
+                   sample_count, alt_count, arena);
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(parts.size() - 1);
+    for (std::size_t i = 1; i < parts.size(); ++i) {
+        futures.push_back(pool.submit([&p, part = parts[i]] { fill(p, part.text, part.first); }));
+    }
+    fill(p, parts.front().text, parts.front().first);
+
+    // Wait for every range before rethrowing: they all write into the plan
+    for (auto& future : futures) {
+        future.wait();
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+    return finish(p, samples, arena);
+}
+
+} // namespace vcf_tool::domain::parser
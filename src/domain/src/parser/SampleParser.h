@@ -0,0 +1,107 @@
+// SampleParser.h
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include <vcf_tool/core/ThreadPool.h>
+
+#include "../entity/VcfRecord.h"
+#include "../header/FieldProjection.h"
+#include "../header/VcfDictionary.h"
+#include "../memory/ChunkArena.h"
+
+
+namespace vcf_tool::domain::parser {
+
+/**
+ * @brief Parses FORMAT and every sample column into a GenotypeMatrix
+ *
+ * Work is split in three steps so that ranges of samples can be filled
+ * independently (and concurrently):
+ *   plan()   - intern the FORMAT keys, pick each column's type and width
+ *              (header declaration, ALT count, first sample) and allocate
+ *              all arrays from the arena
+ *   fill()   - parse a range of samples into its slots; no allocation,
+ *              never writes outside the range's slots
+ *   finish() - redo the columns a range could not fit (wider vectors,
+ *              higher ploidy, values not matching the declared type)
+ *
+ * parse() runs all three on the calling thread; parse_parallel() fills
+ * byte ranges of a wide line concurrently.
+ *
+ * With project(), keys the projection drops are neither interned nor
+ * converted: fill() steps over their values and stops tokenizing a sample
+ * after the last kept key.
+ */
+class SampleParser {
+public:
+    /// Work state of one FORMAT key (arena-allocated)
+    struct KeyPlan {
+        FormatColumn column;
+        std::int32_t* integers{nullptr};
+        float* floats{nullptr};
+        std::string_view* strings{nullptr};
+        std::atomic<bool> too_wide{false};  // A sample had more values than `column.width`
+        std::atomic<bool> untyped{false};   // A value did not parse as `column.type`
+        bool skip{false};                   // Dropped by the FORMAT projection
+    };
+
+    /// Work state of one record's samples (arena-allocated)
+    struct Plan {
+        std::uint32_t sample_count{0};
+        std::uint32_t gt_key{UINT32_MAX};   // Index of GT in `keys` (UINT32_MAX = none)
+        std::uint32_t ploidy{0};
+        std::uint32_t key_limit{0};         // Keys up to the last one kept
+        std::uint8_t* genotypes{nullptr};
+        std::span<KeyPlan> keys;            // In FORMAT order
+        std::atomic<bool> gt_too_wide{false};
+        std::atomic<bool> gt_untyped{false};
+    };
+
+    explicit SampleParser(header::VcfDictionary& dictionary)
+        : dictionary_(&dictionary)
+    {
+    }
+
+    /// Keep only the FORMAT keys `fields` keeps (must outlive the parser)
+    void project(const header::FieldProjection& fields) { fields_ = &fields; }
+
+    /**
+     * Lay out the matrix of a record.
+     *
+     * @param format        FORMAT column
+     * @param first_sample  First sample column (sizes variable-width keys and GT)
+     * @param sample_count  Number of sample columns
+     * @param alt_count     Number of ALT alleles (for Number=A/R/G)
+     */
+    Plan& plan(std::string_view format, std::string_view first_sample,
+               std::uint32_t sample_count, std::uint32_t alt_count,
+               memory::ChunkArena& arena) const;
+
+    /// Parse the tab-separated samples `samples`, the first of which is sample `first`
+    static void fill(Plan& plan, std::string_view samples, std::uint32_t first);
+
+    /// Redo what fill() could not fit; `samples` are all sample columns
+    GenotypeMatrix finish(Plan& plan, std::string_view samples, memory::ChunkArena& arena) const;
+
+    /// plan + fill + finish for all sample columns on the calling thread
+    GenotypeMatrix parse(std::string_view format, std::string_view samples,
+                         std::uint32_t alt_count, memory::ChunkArena& arena) const;
+
+    /**
+     * parse() with the samples cut (at tabs) into up to `ranges` ranges of
+     * similar byte size: the calling thread fills the first, `pool` the others.
+     */
+    GenotypeMatrix parse_parallel(std::string_view format, std::string_view samples,
+                                  std::uint32_t alt_count, memory::ChunkArena& arena,
+                                  core::ThreadPool& pool, std::size_t ranges) const;
+
+private:
+    header::VcfDictionary* dictionary_;
+    const header::FieldProjection* fields_{nullptr};
+};
+
+} // namespace vcf_tool::domain::parser
@@ -0,0 +1,100 @@
+// SampleSelector.cpp
+#include "SampleSelector.h"
+
+#include <bit>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace vcf_tool::domain::parser {
+
+const char* skip_tabs(const char* begin, const char* end, std::size_t n)
+{
+    if (n == 0) {
+        return begin;
+    }
+    const char* p = begin;
+
+#if defined(__SSE2__)
+    // One bit per tab of the block; drop whole blocks while they hold fewer than n
+    const __m128i tab = _mm_set1_epi8('\t');
+    while (end - p >= 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, tab)));
+        const auto count = static_cast<std::size_t>(std::popcount(mask));
+        if (count >= n) {
+            for (std::size_t i = 1; i < n; ++i) {
+                mask &= mask - 1;  // Clear the lowest tab
+            }
+            return p + std::countr_zero(mask) + 1;
+        }
+        n -= count;
+        p += 16;
+    }
+#endif
+
+    while (p < end) {
+        const auto* tab_at = static_cast<const char*>(std::memchr(p, '\t', static_cast<std::size_t>(end - p)));
+        if (!tab_at) {
+            break;
+        }
+        p = tab_at + 1;
+        if (--n == 0) {
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+std::string_view SampleSelector::copy(std::string_view line, memory::ChunkArena& arena) const
+{
+    const char* begin = line.data();
+    const char* end = begin + line.size();
+
+    // Sites-only line or FORMAT without samples: nothing to select
+    const char* samples = skip_tabs(begin, end, fixed_columns_);
+    if (!samples) {
+        return arena.copy(line);
+    }
+    const auto prefix = static_cast<std::size_t>(samples - begin);  // Through the tab after FORMAT
+    if (columns_.empty()) {
+        return arena.copy(line.substr(0, prefix - 1));
+    }
+
+    // Locate the selected columns; `p` is the start of column `at` (nullptr past the last)
+    auto parts = arena.allocate<std::string_view>(columns_.size());
+    std::size_t bytes = prefix - 1;
+    const char* p = samples;
+    std::uint32_t at = 0;
+    for (std::size_t i = 0; i < columns_.size(); ++i) {
+        if (p) {
+            p = skip_tabs(p, end, columns_[i] - at);
+        }
+        if (!p) {
+            parts[i] = ".";
+        } else {
+            const auto* tab = static_cast<const char*>(std::memchr(p, '\t', static_cast<std::size_t>(end - p)));
+            const char* stop = tab ? tab : end;
+            parts[i] = std::string_view(p, static_cast<std::size_t>(stop - p));
+            p = tab ? tab + 1 : nullptr;
+            at = columns_[i] + 1;
+        }
+        bytes += 1 + parts[i].size();
+    }
+
+    auto out = arena.allocate<char>(bytes);
+    char* w = out.data();
+    std::memcpy(w, begin, prefix - 1);
+    w += prefix - 1;
+    for (const auto part : parts) {
+        *w++ = '\t';
+        std::memcpy(w, part.data(), part.size());
+        w += part.size();
+    }
+    return {out.data(), out.size()};
+}
+
+} // namespace vcf_tool::domain::parser
@@ -0,0 +1,52 @@
+// SampleSelector.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "../memory/ChunkArena.h"
+
+
+namespace vcf_tool::domain::parser {
+
+/**
+ * Pointer just past the `n`-th tab of [begin, end) (`begin` for n = 0),
+ * nullptr if there are fewer. Counts 16 bytes at a time with SSE2.
+ */
+const char* skip_tabs(const char* begin, const char* end, std::size_t n);
+
+/**
+ * @brief Copies a data line keeping only the selected sample columns
+ *
+ * The fixed columns (through FORMAT) are kept; of the sample columns only
+ * the selected ones are copied, in file order. Unselected columns are
+ * skipped by counting tabs without looking at their contents, so the copy
+ * and everything parsed from it cost in proportion to the selection.
+ *
+ * A line with fewer sample columns than the header gets "." for the
+ * selected columns it lacks, so every record has one sample per selected
+ * column.
+ */
+class SampleSelector {
+public:
+    /**
+     * @param fixed_columns  Columns before the first sample (9 in VCF)
+     * @param columns        Selected sample columns, ascending; must outlive the selector
+     */
+    SampleSelector(std::size_t fixed_columns, std::span<const std::uint32_t> columns)
+        : fixed_columns_(fixed_columns)
+        , columns_(columns)
+    {
+    }
+
+    /// Arena copy of `line` with only the selected sample columns
+    std::string_view copy(std::string_view line, memory::ChunkArena& arena) const;
+
+private:
+    std::size_t fixed_columns_;
+    std::span<const std::uint32_t> columns_;
+};
+
+} // namespace vcf_tool::domain::parser
@@ -1,5 +1,14 @@
 #include "SimpleParserService.h"
 
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <vcf_tool/core/Metrics.h>
+#include <vcf_tool/core/Tracer.h>
+#include <vcf_tool/utils/Errors.h>
+#include <vcf_tool/utils/Format.h>
+
 #include "../entity/RawLine.h"
 #include "../entity/ParsedRecord.h"
 #include "NaiveLineParser.h"
@@ -11,28 +20,211 @@ namespace vcf_tool::domain::parser {
 using entity::ParsedRecord;
 using entity::RawLine;
 
+using core::metrics::Stopwatch;
+using core::trace::Span;
+using core::trace::Tracer;
+using utils::errors::ParsingError;
+using utils::format;
+
+using ::vcf_tool::domain::BasicVcfLineParser;
+
+template<typename Parser>
+std::optional<ParsedRecord> SimpleParserService<Parser>::parse_line(const RawLine& raw, const memory::ArenaRef& arena) const {
+    if constexpr (requires { this->parser.parse_fixed(raw, arena); }) {
+        // Fixed columns first: INFO / FORMAT are decoded only for records kept
+        ParseError error;
+        ParsedRecord record = this->parser.parse_fixed(raw, arena, error);
+        if (error) {
+            if (!this->rejects) {
+                throw ParsingError(format("Line {}: {}", raw.line_number, error.reason()));
+            }
+            this->rejects->reject(raw, error);
+            return drop(record);
+        }
+        // A split line is filtered and deduplicated per part (select_parts)
+        if (!this->splitter && record.vcf_data.chromosome != kNoStringId && !keep(record)) {
+            return drop(record);
+        }
+        this->parser.decode_fields(record);
+        return record;
+    } else {
+        return this->parser(raw, arena);
+    }
+}
+
+template<typename Parser>
+std::optional<ParsedRecord> SimpleParserService<Parser>::drop(const ParsedRecord& record) const {
+    if (!this->commit_rejected) {
+        return std::nullopt;
+    }
+    // Line number only: no arena reference, nothing for the writer to encode
+    ParsedRecord empty;
+    empty.line_number = record.line_number;
+    empty.end_offset = record.end_offset;
+    return empty;
+}
+
+template<typename Parser>
+bool SimpleParserService<Parser>::keep(const ParsedRecord& record) const {
+    if (this->filter) {
+        if (!this->filter->matches(record.vcf_data)) {
+            this->metrics.filter_rejected.add();
+            return false;
+        }
+        this->metrics.filter_accepted.add();
+    }
+    return !this->duplicates || this->duplicates->first_seen(this->index, record.vcf_data, record.line_number);
+}
+
+template<typename Parser>
+void SimpleParserService<Parser>::select_parts(std::vector<ParsedRecord>& records, std::size_t first) const {
+    auto kept = records.begin() + static_cast<std::ptrdiff_t>(first);
+    for (auto it = kept; it != records.end(); ++it) {
+        if (keep(*it)) {
+            if (kept != it) {
+                *kept = std::move(*it);
+            }
+            ++kept;
+            continue;
+        }
+        // The part that commits its line still has to reach the writer
+        if (it->commits_line) {
+            if (auto empty = drop(*it)) {
+                *kept++ = std::move(*empty);
+            }
+        }
+    }
+    records.erase(kept, records.end());
+}
+
 template<typename Parser>
 void SimpleParserService<Parser>::operator()() {
-    RawLine raw;
+    std::size_t held_sentinels = 0;
+    try {
+        run(held_sentinels);
+    } catch (...) {
+        // The writer waits for one sentinel per parser, failed or not, and
+        // the other parsers for the sentinels this one took from the queue
+        if (this->gate) {
+            this->gate->open();
+        }
+        for (std::size_t i = 0; i < held_sentinels; ++i) {
+            this->input_queue.enqueue(RawLine{.line_number = 0, .text = {}, .is_end = true});
+        }
+        ParsedRecord sentinel{};
+        sentinel.is_end = true;
+        this->output_queue.enqueue(std::move(sentinel));
+        throw;
+    }
+}
+
+template<typename Parser>
+void SimpleParserService<Parser>::run(std::size_t& held_sentinels) {
+    std::vector<RawLine> chunk(kLineChunkSize);
+    std::vector<ParsedRecord> records;
+    records.reserve(kLineChunkSize);
+    std::vector<std::string> spent;  // Line buffers to hand back to the reader
+    spent.reserve(kLineChunkSize);
+    Tracer::instance().set_thread_name("parser");
 
     for (;;) {
-        this->input_queue.wait_dequeue(raw);
+        if (this->gate) {
+            this->gate->wait_turn(this->index);
+        }
+        if (this->duplicates) {
+            this->duplicates->begin_chunk(this->index);
+        }
+
+        Stopwatch wait;
+        Span wait_span("line_queue_wait", "parser", kMinTracedWaitNs);
+        std::size_t count = this->input_queue.wait_dequeue_bulk(chunk.begin(), chunk.size());
+        wait_span.end();
+        this->metrics.parser_wait_ns.add(wait.elapsed_ns());
+
+        // Lines come in file order, sentinels last, one per parser: any
+        // beyond the first belong to other parsers and must go back to the
+        // queue even if parsing this chunk throws
+        std::size_t lines = count;
+        while (lines > 0 && chunk[lines - 1].is_end) {
+            --lines;
+        }
+        const bool end = lines < count;
+        held_sentinels = end ? count - lines - 1 : 0;
+
+        if (this->duplicates) {
+            if (lines > 0) {
+                this->duplicates->took_lines(this->index, chunk[0].line_number, chunk[lines - 1].line_number);
+            }
+        }
+
+        Stopwatch parse;
+        Span parse_span("parse_chunk", "parser");
+        parse_span.set_arg(count);
+
+        // Every record of the chunk lives in this arena
+        const memory::ArenaRef arena = this->arenas ? this->arenas->acquire() : memory::ChunkArena::create();
+
+        for (std::size_t i = 0; i < lines; ++i) {
+            if (auto record = parse_line(chunk[i], arena)) {
+                if (this->splitter && record->vcf_data.chromosome != kNoStringId) {
+                    const std::size_t first = records.size();
+                    this->splitter->split(std::move(*record), records);
+                    if (this->filter || this->duplicates) {
+                        select_parts(records, first);
+                    }
+                } else {
+                    records.push_back(std::move(*record));
+                }
+            }
+        }
+
+        if (this->duplicates) {
+            this->duplicates->end_chunk(this->index);
+        }
+
+        // Lines now live in the arena; recycle their buffers
+        if (this->line_buffers) {
+            for (std::size_t i = 0; i < lines; ++i) {
+                spent.push_back(std::move(chunk[i].text));
+            }
+            this->line_buffers->release_bulk(spent);
+        }
+
+        if (!records.empty()) {
+            this->metrics.records_parsed.add(records.size());
+            this->output_queue.enqueue_bulk(std::make_move_iterator(records.begin()), records.size());
+            records.clear();
+            this->metrics.parse_chunk_seconds.observe(parse.elapsed_ns());
+        }
+        parse_span.end();
+
+        if (end) {
+            // Input is exhausted: parked workers must wake to take their sentinels
+            if (this->gate) {
+                this->gate->open();
+            }
+            for (; held_sentinels > 0; --held_sentinels) {
+                this->input_queue.enqueue(RawLine{.line_number = 0, .text = {}, .is_end = true});
+            }
 
-        if (raw.is_end) {
             // Propagate sentinel downstream
             ParsedRecord sentinel{};
             sentinel.is_end = true;
             this->output_queue.enqueue(std::move(sentinel));
             break;
         }
-
-        ParsedRecord rec = this->parser(raw);
-        this->output_queue.enqueue(std::move(rec));
     }
 }
 
-// Explicit template instantiations for the parsers we use
+// Explicit template instantiations for the parsers we use: the generic
+// VcfLineParser and every variant with_parser_policy() selects
 template struct SimpleParserService<NaiveLineParser>;
 template struct SimpleParserService<::vcf_tool::domain::VcfLineParser>;
+template struct SimpleParserService<BasicVcfLineParser<ParserPolicy<SampleMode::SitesOnly, InfoMode::All>>>;
+template struct SimpleParserService<BasicVcfLineParser<ParserPolicy<SampleMode::SitesOnly, InfoMode::Projected>>>;
+template struct SimpleParserService<BasicVcfLineParser<ParserPolicy<SampleMode::All, InfoMode::All>>>;
+template struct SimpleParserService<BasicVcfLineParser<ParserPolicy<SampleMode::All, InfoMode::Projected>>>;
+template struct SimpleParserService<BasicVcfLineParser<ParserPolicy<SampleMode::Selected, InfoMode::All>>>;
+template struct SimpleParserService<BasicVcfLineParser<ParserPolicy<SampleMode::Selected, InfoMode::Projected>>>;
 
 } // namespace vcf_tool::domain::parser
@@ -1,35 +1,113 @@
 #pragma once
 
+#include <cstddef>
+
+#include <optional>
+#include <vector>
+
 #include "../Queues.h"
+#include "../entity/ParsedRecord.h"
+#include "../entity/RawLine.h"
+#include "../metrics/PipelineMetrics.h"
+#include "../memory/ChunkArena.h"
+#include "../memory/LineBufferPool.h"
+#include "../filter/DuplicateFilter.h"
+#include "../filter/RecordFilter.h"
+#include "../transform/AlleleSplitter.h"
+#include "ParserGate.h"
+#include "RejectLog.h"
 
 
 namespace vcf_tool::domain::parser {
 
 using domain::LineQueue;
 using domain::RecordQueue;
+using entity::ParsedRecord;
+using entity::RawLine;
 
 /**
  * @brief Concurrent parsing service using producer-consumer pattern
  *
- * Continuously dequeues raw lines from input queue, parses them,
+ * Continuously dequeues chunks of raw lines from input queue, parses them,
  * and enqueues parsed records to output queue. Handles end-of-stream
- * sentinels for proper pipeline termination.
+ * sentinels for proper pipeline termination. Each chunk is timed into the
+ * parse latency histogram.
+ *
+ * Each chunk is parsed into one arena from `arenas` (this worker's pool):
+ * the records share it, and it is recycled in one step once the writer has
+ * dropped the last of them. The chunk's line buffers are no longer needed
+ * then and go back to `line_buffers` for the reader to reuse.
+ *
+ * With a ParserGate, worker `index` parks between chunks while the gate's
+ * active count is at or below its index (adaptive parser concurrency).
+ *
+ * Parsers with parse_fixed() / decode_fields() (VcfLineParser) decode the
+ * fixed columns of a line first and its INFO / FORMAT only if the record
+ * is kept: with a `filter`, a rejected line is dropped right there and
+ * never enters the record queue. When checkpointing (`commit_rejected`),
+ * it is forwarded as an empty record instead so the writer can commit its
+ * line number.
+ *
+ * Malformed lines fail the import (ParsingError) unless there is a reject
+ * log (--max-errors): then the parser reports them without throwing, the
+ * log records them, and they are dropped (or forwarded empty) like
+ * filtered lines until the log's error budget is spent.
+ *
+ * With a `splitter` (--split-multiallelic), each record is split into
+ * biallelic records and trimmed right after decoding, in the same arena;
+ * a split line yields several records. The filter then runs on each part
+ * (its own ALT and Number=A/R/G values) instead of on the whole line, so
+ * every line is decoded, and filter_accepted / filter_rejected count parts.
  *
- * @tparam Parser Type of parser to use (must implement operator()(const RawLine&))
+ * With `duplicates` (--dedup), a record whose CHROM/POS/REF/ALT was seen
+ * before is dropped like a filtered one, right after the filter and
+ * before INFO / FORMAT are decoded (after splitting, per biallelic part).
+ * Worker `index` reports the chunks it takes so that sorted-input dedup
+ * can release the chromosomes every worker has passed.
+ *
+ * @tparam Parser Type of parser to use (must implement operator()(const RawLine&, const ArenaRef&))
  */
 template<typename Parser>
 struct SimpleParserService {
     LineQueue&  input_queue;
     RecordQueue& output_queue;
     Parser      parser;  // Injected parser (strategy pattern)
+    metrics::PipelineMetrics& metrics;
+    ParserGate* gate{nullptr};  // nullptr = always active
+    std::size_t index{0};       // Position of this worker for the gate
+    memory::ArenaPool* arenas{nullptr};  // nullptr = a fresh arena per chunk
+    memory::LineBufferPool* line_buffers{nullptr};  // nullptr = line buffers are freed
+    const filter::RecordFilter* filter{nullptr};    // nullptr = keep every record
+    bool commit_rejected{false};                    // Forward rejected lines as empty records
+    RejectLog* rejects{nullptr};                    // nullptr = a malformed line throws
+    const transform::AlleleSplitter* splitter{nullptr};  // nullptr = records keep all their ALT alleles
+    filter::DuplicateFilter* duplicates{nullptr};        // nullptr = duplicates are kept
 
     /**
      * @brief Main processing loop - designed to run in a thread
      *
      * Continuously processes lines until an end-of-stream sentinel
-     * is received, then propagates it downstream and terminates.
+     * is received, then propagates it downstream and terminates. A worker
+     * that fails still sends its sentinel, and puts back the sentinels of
+     * other parsers it had taken from the input queue, before rethrowing.
      */
     void operator()();
+
+private:
+    // `held_sentinels`: other parsers' sentinels taken with the current chunk
+    void run(std::size_t& held_sentinels);
+
+    // The record to forward for `raw`, if any
+    std::optional<ParsedRecord> parse_line(const RawLine& raw, const memory::ArenaRef& arena) const;
+
+    // What replaces a filtered or malformed line: nothing, or an empty record to commit
+    std::optional<ParsedRecord> drop(const ParsedRecord& record) const;
+
+    // The record passes the filter and is not a duplicate
+    bool keep(const ParsedRecord& record) const;
+
+    // Drop the filtered and duplicate records among records[first..] (parts of a split line)
+    void select_parts(std::vector<ParsedRecord>& records, std::size_t first) const;
 };
 
 } // namespace vcf_tool::domain::parser
@@ -1,7 +1,10 @@
 #include "VcfLineParser.h"
 
-#include <sstream>
 #include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <utility>
 
 #include <vcf_tool/utils/Errors.h>
 #include <vcf_tool/utils/Format.h>
@@ -11,10 +14,104 @@ using vcf_tool::utils::format;
 
 namespace vcf_tool::domain {
 
-entity::ParsedRecord VcfLineParser::operator()(const entity::RawLine& raw) const {
+namespace {
+
+// CHROM POS ID REF ALT QUAL FILTER INFO FORMAT (sample columns follow)
+constexpr std::size_t kFixedColumns = 9;
+
+// CHROM through INFO: the columns every data line has
+constexpr std::size_t kSiteColumns = 8;
+
+// Split the first `fields.size()` columns; returns how many were found,
+// `rest` gets what follows them (the sample columns)
+std::size_t split_columns(std::string_view line, std::span<std::string_view> fields, std::string_view& rest)
+{
+    std::size_t count = 0;
+    std::size_t start = 0;
+    while (count < fields.size() && start < line.size()) {
+        std::size_t tab = line.find('\t', start);
+        if (tab == std::string_view::npos) {
+            tab = line.size();
+        }
+        fields[count++] = line.substr(start, tab - start);
+        start = tab + 1;
+    }
+    rest = start < line.size() ? line.substr(start) : std::string_view{};
+    return count;
+}
+
+FieldValue value_of(std::string_view text)
+{
+    if (auto number = VcfLineParser::try_parse_double(text)) {
+        return FieldValue{.kind = FieldValue::Kind::Number, .number = *number, .text = {}};
+    }
+    return FieldValue{.kind = FieldValue::Kind::String, .number = 0.0, .text = text};
+}
+
+// Next `sep`-delimited token of `rest` (consumed from the front)
+std::string_view next_token(std::string_view& rest, char sep)
+{
+    std::size_t pos = rest.find(sep);
+    std::string_view token = rest.substr(0, pos);
+    rest = pos == std::string_view::npos ? std::string_view{} : rest.substr(pos + 1);
+    return token;
+}
+
+// Record left for a malformed line: position in the input only
+entity::ParsedRecord malformed(const entity::RawLine& raw)
+{
+    entity::ParsedRecord result;
+    result.line_number = raw.line_number;
+    result.end_offset = raw.end_offset;
+    return result;
+}
+
+} // namespace
+
+template<typename Policy>
+void BasicVcfLineParser<Policy>::split_wide_lines(core::ThreadPool& pool, std::size_t min_bytes,
+                                                  core::metrics::Counter* split_lines) {
+    range_pool_ = &pool;
+    wide_line_bytes_ = min_bytes;
+    wide_lines_ = split_lines;
+}
+
+template<typename Policy>
+void BasicVcfLineParser<Policy>::select_samples(std::span<const std::uint32_t> columns) {
+    selector_.emplace(kFixedColumns, columns);
+}
+
+template<typename Policy>
+void BasicVcfLineParser<Policy>::project_fields(const header::FieldProjection& info, const header::FieldProjection& format) {
+    info_fields_ = info.keeps_all() ? nullptr : &info;
+    if (!format.keeps_all()) {
+        samples_.project(format);
+    }
+}
+
+template<typename Policy>
+entity::ParsedRecord BasicVcfLineParser<Policy>::operator()(const entity::RawLine& raw, const memory::ArenaRef& arena) const {
+    auto result = parse_fixed(raw, arena);
+    decode_fields(result);
+    return result;
+}
+
+template<typename Policy>
+entity::ParsedRecord BasicVcfLineParser<Policy>::parse_fixed(const entity::RawLine& raw, const memory::ArenaRef& arena) const {
+    parser::ParseError error;
+    auto result = parse_fixed(raw, arena, error);
+    if (error) {
+        throw ParsingError(format("Line {}: {}", raw.line_number, error.reason()));
+    }
+    return result;
+}
+
+template<typename Policy>
+entity::ParsedRecord BasicVcfLineParser<Policy>::parse_fixed(const entity::RawLine& raw, const memory::ArenaRef& arena,
+                                                             parser::ParseError& error) const {
     entity::ParsedRecord result;
     result.line_number = raw.line_number;
-    result.raw_text = raw.text;
+    result.end_offset = raw.end_offset;
     result.is_end = raw.is_end;
 
     // Handle sentinels and empty lines
@@ -27,165 +124,177 @@ entity::ParsedRecord VcfLineParser::operator()(const entity::RawLine& raw) const
         return result;  // Return empty record for headers
     }
 
-    // Split on TAB
-    auto fields = split_tabs(raw.text);
+    // All views below point into the arena copy of the line (selected samples only)
+    result.arena = arena;
+    if constexpr (Policy::kSamples == parser::SampleMode::Selected) {
+        result.raw_text = selector_->copy(raw.text, *arena);
+    } else if constexpr (Policy::kSamples == parser::SampleMode::Runtime) {
+        result.raw_text = selector_ ? selector_->copy(raw.text, *arena) : arena->copy(raw.text);
+    } else {
+        result.raw_text = arena->copy(raw.text);
+    }
+
+    // Split on TAB (sites-only: nothing past INFO is looked at)
+    constexpr std::size_t kColumns = Policy::kSamples == parser::SampleMode::SitesOnly ? kSiteColumns : kFixedColumns;
+    std::array<std::string_view, kColumns> fields;
+    std::string_view samples;
+    std::size_t field_count = split_columns(result.raw_text, fields, samples);
 
     // Validate: need at least 8 fields (CHROM through INFO)
-    if (fields.size() < 8) {
-        throw ParsingError(format(
-            "Line {}: Expected at least 8 fields, got {}",
-            raw.line_number, fields.size()
-        ));
+    if (field_count < kSiteColumns) {
+        error = parser::ParseError{.kind = parser::ParseError::Kind::Columns, .columns = field_count, .value = {}};
+        return malformed(raw);
     }
 
-    // Extract fixed fields
-    result.vcf_data.chromosome = fields[0];
+    auto& record = result.vcf_data;
 
-    // Parse position
-    try {
-        result.vcf_data.position = std::stoull(fields[1]);
-    } catch (...) {
-        throw ParsingError(format(
-            "Line {}: Invalid position '{}'",
-            raw.line_number, fields[1]
-        ));
+    // Parse position (before interning anything from a line that may be rejected)
+    auto [ptr, ec] = std::from_chars(fields[1].data(), fields[1].data() + fields[1].size(), record.position);
+    if (ec != std::errc{} || ptr != fields[1].data() + fields[1].size()) {
+        error = parser::ParseError{.kind = parser::ParseError::Kind::Position, .columns = field_count, .value = fields[1]};
+        return malformed(raw);
     }
 
-    result.vcf_data.ref = fields[3];
-    result.vcf_data.alt = fields[4];
-
-    // Build DATA JSON
-    nlohmann::json data = nlohmann::json::object();
+    // Extract fixed fields
+    record.chromosome = dictionary_->contigs.intern(fields[0]);
 
-    // FILTER (string)
-    data["FILTER"] = fields[6];
+    record.ref = fields[3];
+    record.alt = fields[4];
 
     // QUAL (numeric or null)
-    if (fields[5] == ".") {
-        data["QUAL"] = nullptr;
-    } else {
-        auto qual_opt = try_parse_double(fields[5]);
-        data["QUAL"] = qual_opt.value_or(0.0);
+    if (fields[5] != ".") {
+        record.qual = try_parse_double(fields[5]).value_or(0.0);
     }
 
-    // INFO (JSON object)
-    data["INFO"] = parse_info_field(fields[7]);
+    record.filter = dictionary_->filters.intern(fields[6]);
 
-    // FORMAT (JSON object) - if present
-    if (fields.size() >= 10) {
-        data["FORMAT"] = parse_format_field(fields[8], fields[9]);
-    } else {
-        data["FORMAT"] = nlohmann::json::object();
+    // INFO, FORMAT and all sample columns are decoded on first access
+    if (fields[7] != ".") {
+        record.deferred.info = fields[7];
+    }
+    if constexpr (Policy::kSamples != parser::SampleMode::SitesOnly) {
+        if (field_count == kFixedColumns && !fields[8].empty() && !samples.empty()) {
+            record.deferred.format = fields[8];
+            record.deferred.samples = samples;
+        }
     }
-
-    result.vcf_data.data = std::move(data);
 
     return result;
 }
 
-std::vector<std::string> VcfLineParser::split_tabs(const std::string& line) const {
-    std::vector<std::string> result;
-    std::istringstream iss(line);
-    std::string field;
-
-    while (std::getline(iss, field, '\t')) {
-        result.push_back(field);
+template<typename Policy>
+void BasicVcfLineParser<Policy>::decode_info(entity::ParsedRecord& result) const {
+    auto& record = result.vcf_data;
+    if (record.deferred.info.empty()) {
+        return;
     }
-
-    return result;
+    record.info = parse_info_field(record.deferred.info, *result.arena);
+    record.deferred.info = {};
 }
 
-nlohmann::json VcfLineParser::parse_info_field(const std::string& info_str) const {
-    nlohmann::json info = nlohmann::json::object();
-
-    if (info_str.empty() || info_str == ".") {
-        return info;
+template<typename Policy>
+void BasicVcfLineParser<Policy>::decode_samples(entity::ParsedRecord& result) const {
+    if constexpr (Policy::kSamples == parser::SampleMode::SitesOnly) {
+        return;  // Never deferred
     }
-
-    // Split on semicolon: "DP=50;AF=0.25;AC=2"
-    std::istringstream iss(info_str);
-    std::string pair;
-
-    while (std::getline(iss, pair, ';')) {
-        auto eq_pos = pair.find('=');
-
-        if (eq_pos == std::string::npos) {
-            // Flag field (no value, e.g., "PASS")
-            info[pair] = true;
-        } else {
-            std::string key = pair.substr(0, eq_pos);
-            std::string value = pair.substr(eq_pos + 1);
-
-            // Try to parse as number, otherwise keep as string
-            auto num_opt = try_parse_double(value);
-            if (num_opt) {
-                info[key] = num_opt.value();
-            } else {
-                info[key] = value;  // Keep as string (handles "10,20,30")
-            }
+    auto& record = result.vcf_data;
+    if (record.deferred.format.empty()) {
+        return;
+    }
+    const std::string_view format = std::exchange(record.deferred.format, {});
+    const std::string_view samples = std::exchange(record.deferred.samples, {});
+
+    const auto alt_count = record.alt == "."
+        ? 0u
+        : static_cast<std::uint32_t>(std::count(record.alt.begin(), record.alt.end(), ',')) + 1;
+    const std::size_t ranges = range_pool_ && samples.size() >= wide_line_bytes_
+        ? std::min(range_pool_->size() + 1, samples.size() / kMinRangeBytes)
+        : 1;
+    if (ranges > 1) {
+        record.samples = samples_.parse_parallel(format, samples, alt_count, *result.arena, *range_pool_, ranges);
+        if (wide_lines_) {
+            wide_lines_->add();
         }
+    } else {
+        record.samples = samples_.parse(format, samples, alt_count, *result.arena);
     }
-
-    return info;
 }
 
-nlohmann::json VcfLineParser::parse_format_field(
-    const std::string& format_str,
-    const std::string& sample_str
-) const {
-    nlohmann::json format = nlohmann::json::object();
+template<typename Policy>
+entity::ParsedRecord BasicVcfLineParser<Policy>::operator()(const entity::RawLine& raw) const {
+    // Line copy plus a generous estimate for the entry arrays
+    return (*this)(raw, memory::ChunkArena::create(raw.text.size() * 4 + 256));
+}
 
-    if (format_str.empty() || sample_str.empty()) {
-        return format;
+template<typename Policy>
+std::vector<std::string_view> BasicVcfLineParser<Policy>::split_tabs(std::string_view line) {
+    std::vector<std::string_view> result;
+    while (!line.empty()) {
+        result.push_back(next_token(line, '\t'));
     }
+    return result;
+}
 
-    // Split format keys: "GT:AD:DP"
-    std::vector<std::string> keys;
-    std::istringstream iss_keys(format_str);
-    std::string key;
-    while (std::getline(iss_keys, key, ':')) {
-        keys.push_back(key);
+template<typename Policy>
+std::span<const Field> BasicVcfLineParser<Policy>::parse_info_field(std::string_view info_str, memory::ChunkArena& arena) const {
+    if (info_str.empty() || info_str == ".") {
+        return {};
     }
 
-    // Split sample values: "0/1:18,18:36"
-    std::vector<std::string> values;
-    std::istringstream iss_vals(sample_str);
-    std::string value;
-    while (std::getline(iss_vals, value, ':')) {
-        values.push_back(value);
-    }
+    // Split on semicolon: "DP=50;AF=0.25;AC=2"
+    auto entries = arena.allocate<Field>(static_cast<std::size_t>(std::count(info_str.begin(), info_str.end(), ';')) + 1);
+    std::size_t count = 0;
+
+    std::string_view rest = info_str;
+    while (!rest.empty()) {
+        std::string_view pair = next_token(rest, ';');
+        if (pair.empty()) {
+            continue;
+        }
 
-    // Zip together (stop at minimum length)
-    size_t count = std::min(keys.size(), values.size());
-    for (size_t i = 0; i < count; ++i) {
-        if (values[i] == ".") {
-            format[keys[i]] = nullptr;
-        } else {
-            // Try numeric, otherwise string
-            auto num_opt = try_parse_double(values[i]);
-            if (num_opt) {
-                format[keys[i]] = num_opt.value();
-            } else {
-                format[keys[i]] = values[i];  // Keeps "0/1", "10,20,30", etc.
+        auto eq_pos = pair.find('=');
+        if constexpr (Policy::kInfo == parser::InfoMode::Projected) {
+            if (!info_fields_->keeps(pair.substr(0, eq_pos))) {
+                continue;  // Not interned, value not converted
+            }
+        } else if constexpr (Policy::kInfo == parser::InfoMode::Runtime) {
+            if (info_fields_ && !info_fields_->keeps(pair.substr(0, eq_pos))) {
+                continue;
             }
         }
+        if (eq_pos == std::string_view::npos) {
+            // Flag field (no value, e.g., "DB")
+            entries[count++] = Field{.key = dictionary_->info_keys.intern(pair), .value = FieldValue{.kind = FieldValue::Kind::Flag, .number = 0.0, .text = {}}};
+        } else {
+            // Number if it parses as one, otherwise string (handles "10,20,30")
+            entries[count++] = Field{.key = dictionary_->info_keys.intern(pair.substr(0, eq_pos)), .value = value_of(pair.substr(eq_pos + 1))};
+        }
     }
 
-    return format;
+    return entries.first(count);
 }
 
-std::optional<double> VcfLineParser::try_parse_double(const std::string& str) const {
-    try {
-        size_t pos;
-        double val = std::stod(str, &pos);
-        // Ensure entire string was consumed (not just prefix)
-        if (pos == str.size()) {
-            return val;
-        }
-    } catch (...) {
-        // Not a valid number
+template<typename Policy>
+std::optional<double> BasicVcfLineParser<Policy>::try_parse_double(std::string_view str) {
+    // Whole string must be a finite number (not just a prefix); no exceptions
+    double val = 0.0;
+    auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), val);
+    if (ec == std::errc{} && ptr == str.data() + str.size() && !str.empty() && std::isfinite(val)) {
+        return val;
     }
     return std::nullopt;
 }
 
+// The generic parser and every variant parser::with_parser_policy() selects
+using parser::InfoMode;
+using parser::ParserPolicy;
+using parser::SampleMode;
+template class BasicVcfLineParser<parser::GenericPolicy>;
+template class BasicVcfLineParser<ParserPolicy<SampleMode::SitesOnly, InfoMode::All>>;
+template class BasicVcfLineParser<ParserPolicy<SampleMode::SitesOnly, InfoMode::Projected>>;
+template class BasicVcfLineParser<ParserPolicy<SampleMode::All, InfoMode::All>>;
+template class BasicVcfLineParser<ParserPolicy<SampleMode::All, InfoMode::Projected>>;
+template class BasicVcfLineParser<ParserPolicy<SampleMode::Selected, InfoMode::All>>;
+template class BasicVcfLineParser<ParserPolicy<SampleMode::Selected, InfoMode::Projected>>;
+
 }  // namespace vcf_tool::domain
@@ -1,31 +1,145 @@
 #pragma once
 
-#include <string>
-#include <vector>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
-#include <nlohmann/json.hpp>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <vcf_tool/core/Metrics.h>
+#include <vcf_tool/core/ThreadPool.h>
 
 #include "../entity/RawLine.h"
 #include "../entity/ParsedRecord.h"
+#include "../header/VcfDictionary.h"
+#include "../header/FieldProjection.h"
+#include "../memory/ChunkArena.h"
+#include "ParseError.h"
+#include "ParserPolicy.h"
+#include "SampleParser.h"
+#include "SampleSelector.h"
 
 namespace vcf_tool::domain {
 
-class VcfLineParser {
+/**
+ * @brief Parses a VCF data line into a VcfRecord
+ *
+ * The line is copied into the given chunk arena once; every field of the
+ * record is a view into that copy, and the INFO entries and the genotype
+ * matrix of all sample columns are allocated from the same arena. No
+ * per-field heap allocation.
+ *
+ * CHROM, FILTER and the INFO / FORMAT keys are interned in `dictionary`
+ * (shared by all parser threads); a known string costs one lock-free lookup.
+ *
+ * With split_wide_lines(), the sample columns of very wide lines (large
+ * cohorts) are cut into ranges parsed concurrently, so one line no longer
+ * keeps a single thread busy while the others idle.
+ *
+ * parse_fixed() decodes only CHROM through FILTER and defers INFO and
+ * FORMAT to decode_info() / decode_samples(), so a caller that drops
+ * records on their fixed columns skips the expensive part of the line.
+ *
+ * With select_samples(), only the chosen sample columns are copied and
+ * parsed; the others are skipped by counting tabs. With project_fields(),
+ * INFO and FORMAT keys outside the projections are skipped unconverted.
+ *
+ * `Policy` (a parser::ParserPolicy) fixes the sample and INFO modes at
+ * compile time: a specialized variant has no branch for the options it
+ * excludes (e.g. no sample code at all when sites-only, no projection test
+ * when every INFO key is kept). VcfLineParser, the generic variant, decides
+ * at runtime. A SampleMode::Selected variant needs select_samples(), an
+ * InfoMode::Projected one an INFO projection.
+ */
+template<typename Policy>
+class BasicVcfLineParser {
 public:
-    VcfLineParser() = default;
+    explicit BasicVcfLineParser(header::VcfDictionary& dictionary)
+        : dictionary_(&dictionary)
+        , samples_(dictionary)
+    {
+    }
+
+    /**
+     * Parse the sample columns of lines with at least `min_bytes` of them in
+     * ranges of at least kMinRangeBytes: one on the calling thread, the
+     * others on `pool` (which must not be the pool running this parser).
+     * `split_lines` (optional) counts the lines split.
+     */
+    void split_wide_lines(core::ThreadPool& pool, std::size_t min_bytes,
+                          core::metrics::Counter* split_lines = nullptr);
+
+    static constexpr std::size_t kMinRangeBytes = 64 * 1024;
+
+    /**
+     * Keep only sample columns `columns` (ascending indices, 0 = first
+     * after FORMAT; must outlive the parser). Records get one sample per
+     * selected column, in file order.
+     */
+    void select_samples(std::span<const std::uint32_t> columns);
+
+    /// Keep only the INFO / FORMAT keys the projections keep (must outlive the parser)
+    void project_fields(const header::FieldProjection& info, const header::FieldProjection& format);
+
+    // Main parsing interface: the record keeps a reference to `arena`
+    entity::ParsedRecord operator()(const entity::RawLine& raw, const memory::ArenaRef& arena) const;
+
+    /**
+     * Decode the fixed columns only; INFO and FORMAT stay in
+     * `vcf_data.deferred` until decoded.
+     *
+     * @throws ParsingError if a fixed column is malformed
+     */
+    entity::ParsedRecord parse_fixed(const entity::RawLine& raw, const memory::ArenaRef& arena) const;
 
-    // Main parsing interface (matches NaiveLineParser)
+    /**
+     * Non-throwing parse_fixed(): a malformed line sets `error` and yields
+     * a record with only its line number and end offset.
+     */
+    entity::ParsedRecord parse_fixed(const entity::RawLine& raw, const memory::ArenaRef& arena,
+                                     parser::ParseError& error) const;
+
+    /**
+     * Decode deferred INFO / FORMAT into the record's arena (no-op once
+     * decoded). Must run on the thread allocating from that arena, i.e.
+     * the parser thread that produced the record.
+     */
+    void decode_info(entity::ParsedRecord& record) const;
+    void decode_samples(entity::ParsedRecord& record) const;
+    void decode_fields(entity::ParsedRecord& record) const
+    {
+        decode_info(record);
+        decode_samples(record);
+    }
+
+    // Convenience for one-off parsing: the record gets an arena of its own
     entity::ParsedRecord operator()(const entity::RawLine& raw) const;
 
+    // Stateless helpers (public for benchmarks)
+    static std::vector<std::string_view> split_tabs(std::string_view line);
+    static std::optional<double> try_parse_double(std::string_view str);
+
 private:
     // Helper methods
-    std::vector<std::string> split_tabs(const std::string& line) const;
-    nlohmann::json parse_info_field(const std::string& info_str) const;
-    nlohmann::json parse_format_field(
-        const std::string& format_str,
-        const std::string& sample_str
-    ) const;
-    std::optional<double> try_parse_double(const std::string& str) const;
+    std::span<const Field> parse_info_field(std::string_view info_str, memory::ChunkArena& arena) const;
+
+    header::VcfDictionary* dictionary_;
+    parser::SampleParser samples_;
+
+    // Wide line splitting (disabled without a pool)
+    core::ThreadPool* range_pool_{nullptr};
+    std::size_t wide_line_bytes_{0};
+    core::metrics::Counter* wide_lines_{nullptr};
+
+    // Sample subset (all samples without one)
+    std::optional<parser::SampleSelector> selector_;
+
+    // INFO projection (every key without one)
+    const header::FieldProjection* info_fields_{nullptr};
 };
 
+// Generic parser: every option decided at runtime
+using VcfLineParser = BasicVcfLineParser<parser::GenericPolicy>;
+
 }  // namespace vcf_tool::domain
@@ -0,0 +1,148 @@
+// AdaptiveController.cpp
+#include "AdaptiveController.h"
+
+#include <algorithm>
+
+#include <vcf_tool/utils/Logger.h>
+
+
+namespace vcf_tool::domain::pipeline {
+
+namespace {
+
+// Queue fill levels (fraction of configured capacity) and busy fractions
+constexpr double kQueueFilling = 0.5;
+constexpr double kQueueDraining = 0.25;
+constexpr double kQueueEmpty = 0.05;
+constexpr double kBusy = 0.8;
+constexpr double kWriterSaturated = 0.9;
+constexpr double kIdle = 0.5;
+
+double fill(std::size_t depth, std::size_t capacity)
+{
+    return capacity == 0 ? 0.0 : static_cast<double>(depth) / static_cast<double>(capacity);
+}
+
+std::uint64_t sum_ns(const core::metrics::Histogram& histogram)
+{
+    return histogram.snapshot().sum;
+}
+
+} // namespace
+
+AdaptiveController::AdaptiveController(Context& ctx,
+                                       writer::DbWriterWorker& writer,
+                                       std::size_t min_parsers,
+                                       std::chrono::milliseconds interval)
+    : ctx_(ctx)
+    , writer_(writer)
+    , min_parsers_(std::max<std::size_t>(1, min_parsers))
+    , max_parsers_(ctx.parser_count())
+    , interval_(interval)
+    , last_time_(std::chrono::steady_clock::now())
+    , thread_([this](std::stop_token st) {
+        run(st);
+      })
+{
+}
+
+AdaptiveController::~AdaptiveController()
+{
+    thread_.request_stop();
+    cv_.notify_all();
+}
+
+void AdaptiveController::run(std::stop_token st)
+{
+    while (!st.stop_requested()) {
+        {
+            std::unique_lock lock(mutex_);
+            // Returns early when stop is requested
+            cv_.wait_for(lock, st, interval_, [] { return false; });
+        }
+        if (st.stop_requested() || ctx_.parser_gate().is_open()) {
+            break;  // Input exhausted: every parser is draining its sentinel
+        }
+        sample();
+    }
+}
+
+void AdaptiveController::sample()
+{
+    auto& metrics = ctx_.metrics();
+    const auto& config = ctx_.config();
+    const std::size_t active = ctx_.parser_gate().active();
+
+    auto now = std::chrono::steady_clock::now();
+    double elapsed_ns = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_time_).count());
+    std::uint64_t parse_ns = sum_ns(metrics.parse_chunk_seconds);
+    std::uint64_t writer_ns = sum_ns(metrics.encode_seconds) + sum_ns(metrics.insert_seconds);
+
+    const double line_fill = fill(ctx_.line_queue().size_approx(), config.line_queue_capacity);
+    const double record_fill = fill(ctx_.record_queue().size_approx(), config.record_queue_capacity);
+    const double parser_busy = elapsed_ns > 0.0
+        ? static_cast<double>(parse_ns - last_parse_ns_) / (elapsed_ns * static_cast<double>(active))
+        : 0.0;
+    const double writer_busy = elapsed_ns > 0.0
+        ? static_cast<double>(writer_ns - last_writer_ns_) / elapsed_ns
+        : 0.0;
+
+    last_time_ = now;
+    last_parse_ns_ = parse_ns;
+    last_writer_ns_ = writer_ns;
+
+    Decision decision = Decision::Hold;
+    const char* reason = "";
+    if (record_fill >= kQueueFilling || writer_busy >= kWriterSaturated) {
+        decision = Decision::Shrink;
+        reason = "writer-bound";
+    } else if (line_fill >= kQueueFilling && record_fill < kQueueDraining && parser_busy >= kBusy) {
+        decision = Decision::Grow;
+        reason = "parser-bound";
+    } else if (line_fill < kQueueEmpty && parser_busy < kIdle) {
+        decision = Decision::Shrink;
+        reason = "reader-bound";
+    }
+
+    LOG_DEBUG_F("Adaptive: {} parsers, line queue {:.0f}%, record queue {:.0f}%, "
+                "parsers {:.0f}% busy, writer {:.0f}% busy",
+                active, line_fill * 100.0, record_fill * 100.0, parser_busy * 100.0, writer_busy * 100.0);
+
+    // Act only when two consecutive samples agree
+    const bool confirmed = decision != Decision::Hold && decision == pending_;
+    pending_ = confirmed ? Decision::Hold : decision;
+    if (!confirmed) {
+        return;
+    }
+
+    if (decision == Decision::Grow && active < max_parsers_) {
+        metrics.parser_scale_ups.add();
+        apply(active + 1);
+    } else if (decision == Decision::Shrink && active > min_parsers_) {
+        metrics.parser_scale_downs.add();
+        apply(active - 1);
+    } else {
+        return;
+    }
+
+    LOG_INFO_F("Adaptive: parsers {} -> {} ({}: line queue {:.0f}%, record queue {:.0f}%, "
+               "parsers {:.0f}% busy, writer {:.0f}% busy); encode workers {}",
+               active, ctx_.parser_gate().active(), reason,
+               line_fill * 100.0, record_fill * 100.0, parser_busy * 100.0, writer_busy * 100.0,
+               writer_.encode_workers());
+}
+
+void AdaptiveController::apply(std::size_t active)
+{
+    ctx_.parser_gate().set_active(active);
+
+    // Cores of parked parsers encode batches instead
+    std::size_t encode_workers = ctx_.encode_pool() ? 1 + (max_parsers_ - active) : 1;
+    writer_.set_encode_workers(encode_workers);
+
+    ctx_.metrics().active_parsers.set(static_cast<std::int64_t>(active));
+    ctx_.metrics().encode_workers.set(static_cast<std::int64_t>(encode_workers));
+}
+
+} // namespace vcf_tool::domain::pipeline
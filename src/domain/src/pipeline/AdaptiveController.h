@@ -0,0 +1,71 @@
+// AdaptiveController.h
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+
+#include "Context.h"
+#include "../writer/DbWriterWorker.h"
+
+
+namespace vcf_tool::domain::pipeline {
+
+/**
+ * @brief Background thread that adapts the number of active parsers
+ *
+ * Every interval it samples both queue depths and the busy fraction of
+ * the parsers and the writer over the last interval, then classifies the
+ * pipeline:
+ *   - parser-bound (line queue filling, record queue draining, parsers
+ *     busy): unpark one parser, up to parser_count
+ *   - writer-bound (record queue filling or writer saturated) or
+ *     reader-bound (line queue empty, parsers idle): park one parser,
+ *     down to min_parsers
+ *
+ * A decision needs the same classification on two consecutive samples, to
+ * avoid flapping. Cores freed by parked parsers are handed to the writer
+ * as extra encode workers (1 + parked parsers). Decisions are logged and
+ * counted in the vcf_adaptive_* metrics.
+ */
+class AdaptiveController {
+public:
+    AdaptiveController(Context& ctx,
+                       writer::DbWriterWorker& writer,
+                       std::size_t min_parsers,
+                       std::chrono::milliseconds interval);
+
+    ~AdaptiveController();
+
+    AdaptiveController(const AdaptiveController&) = delete;
+    AdaptiveController& operator=(const AdaptiveController&) = delete;
+
+private:
+    enum class Decision { Hold, Grow, Shrink };
+
+    void run(std::stop_token st);
+    void sample();
+    void apply(std::size_t active);
+
+    Context& ctx_;
+    writer::DbWriterWorker& writer_;
+    std::size_t min_parsers_;
+    std::size_t max_parsers_;
+    std::chrono::milliseconds interval_;
+
+    // Previous sample (controller thread only)
+    std::chrono::steady_clock::time_point last_time_;
+    std::uint64_t last_parse_ns_{0};
+    std::uint64_t last_writer_ns_{0};
+    Decision pending_{Decision::Hold};
+
+    std::mutex mutex_;
+    std::condition_variable_any cv_;
+    std::jthread thread_;
+};
+
+} // namespace vcf_tool::domain::pipeline
@@ -1,18 +1,169 @@
 // Context.cpp
 #include "Context.h"
 
+#include <algorithm>
+#include <map>
+
+#include <vcf_tool/utils/Errors.h>
+#include <vcf_tool/utils/Format.h>
+#include <vcf_tool/utils/Logger.h>
+
 
 namespace vcf_tool::domain::pipeline {
 
+namespace affinity = vcf_tool::core::affinity;
+
+namespace {
+
+CpuPlacement make_placement(const Context::Config& config)
+{
+    switch (config.affinity) {
+        case api::AffinityPolicy::None:
+            return CpuPlacement();
+        case api::AffinityPolicy::Compact:
+            return CpuPlacement(affinity::Policy::Compact, affinity::CpuTopology::detect());
+        case api::AffinityPolicy::Scatter:
+            return CpuPlacement(affinity::Policy::Scatter, affinity::CpuTopology::detect());
+        case api::AffinityPolicy::Explicit:
+            return CpuPlacement(affinity::Policy::Explicit, affinity::CpuTopology::detect(),
+                                affinity::parse_cpu_list(config.affinity_cpus));
+    }
+    return CpuPlacement();
+}
+
+// Listed keys the header has no definition for (likely typos)
+void warn_undeclared(const FieldProjection& fields, const std::vector<header::FieldDefinition>& definitions,
+                     std::string_view kind)
+{
+    for (const auto& name : fields.names()) {
+        const bool declared = std::any_of(definitions.begin(), definitions.end(),
+                                          [&](const auto& definition) { return definition.id == name; });
+        if (!declared) {
+            LOG_WARN_F("Context: {} key '{}' is not declared in the header", kind, name);
+        }
+    }
+}
+
+} // namespace
+
 Context::Context(Config config)
     : config_(config)
+    , placement_(make_placement(config))
+    , metrics_registry_()
+    , metrics_(metrics_registry_)
+    , dictionary_(std::make_unique<VcfDictionary>())
+    , info_fields_(FieldProjection::parse(config.info_fields))
+    , format_fields_(FieldProjection::parse(config.format_fields))
+    , line_buffers_(config.line_queue_capacity + config.parser_count * kLineChunkSize)
     , line_queue_(config.line_queue_capacity)
     , record_queue_(config.record_queue_capacity)
-    , thread_pool_(config.parser_count)
+    , thread_pool_(config.parser_count,
+                   [this](std::size_t worker) { placement_.pin_current_thread(kFirstParserSlot + worker); })
+    , parser_gate_(config.parser_count)
 {
     // All resources initialized via member initializer list
     // Queues: Created with configured capacities
     // ThreadPool: Created with parser_count threads (already running)
+
+    // At most parser_count - min_parsers cores can be moved to encoding
+    if (config.adaptive_parsers && config.parser_count > config.min_parsers) {
+        const std::size_t first_slot = kFirstParserSlot + config.parser_count;
+        encode_pool_ = std::make_unique<ThreadPool>(
+            config.parser_count - config.min_parsers,
+            [this, first_slot](std::size_t worker) { placement_.pin_current_thread(first_slot + worker); });
+    }
+
+    // Parsers pinned to the same NUMA node share an arena pool, whose arenas
+    // they first-touch (ArenaPool), so records are parsed into node-local
+    // memory; unpinned parsers keep a pool each
+    std::map<int, std::size_t> node_pools;
+    arena_pool_of_.reserve(config.parser_count);
+    for (std::size_t i = 0; i < config.parser_count; ++i) {
+        const auto node = placement_.numa_node_for(kFirstParserSlot + i);
+        if (node) {
+            const auto [it, added] = node_pools.try_emplace(*node, arena_pools_.size());
+            if (added) {
+                arena_pools_.push_back(std::make_unique<ArenaPool>());
+            }
+            arena_pool_of_.push_back(it->second);
+        } else {
+            arena_pool_of_.push_back(arena_pools_.size());
+            arena_pools_.push_back(std::make_unique<ArenaPool>());
+        }
+    }
+    if (!node_pools.empty()) {
+        LOG_INFO_F("Context: {} parser arena pool(s), one per NUMA node", node_pools.size());
+    }
+
+    metrics_.active_parsers.set(static_cast<std::int64_t>(config.parser_count));
+    metrics_.encode_workers.set(1);
+
+    // Queue depths are sampled at export time
+    metrics_registry_.gauge_callback(
+        "vcf_line_queue_depth", "Lines waiting in the reader->parser queue",
+        [this] { return static_cast<double>(line_queue_.size_approx()); });
+    metrics_registry_.gauge_callback(
+        "vcf_record_queue_depth", "Records waiting in the parser->writer queue",
+        [this] { return static_cast<double>(record_queue_.size_approx()); });
+    metrics_registry_.gauge_callback(
+        "vcf_parser_arenas", "Chunk arenas allocated by the parsers (in flight or free)",
+        [this] {
+            std::size_t total = 0;
+            for (const auto& pool : arena_pools_) {
+                total += pool->size();
+            }
+            return static_cast<double>(total);
+        });
+    metrics_registry_.gauge_callback(
+        "vcf_line_buffers_free", "Recycled line buffers waiting for the reader",
+        [this] { return static_cast<double>(line_buffers_.size_approx()); });
+    metrics_registry_.gauge_callback(
+        "vcf_dictionary_strings", "Distinct contigs, FILTER values and INFO/FORMAT keys interned",
+        [this] { return static_cast<double>(dictionary_->size()); });
+    metrics_registry_.gauge_callback(
+        "vcf_dedup_keys", "Record keys held by the duplicate filter",
+        [this] { return duplicate_filter_ ? static_cast<double>(duplicate_filter_->size()) : 0.0; });
+}
+
+void Context::load_header(const std::string& file_path)
+{
+    header_ = VcfHeader::read(file_path);
+    dictionary_ = std::make_unique<VcfDictionary>(header_);
+    sample_selection_ = SampleSelection::resolve(config_.samples, header_.samples);
+    warn_undeclared(info_fields_, header_.info, "INFO");
+    warn_undeclared(format_fields_, header_.format, "FORMAT");
+
+    // Range workers only help decode sample columns: sites-only input never needs them.
+    // They run on the parsers' CPUs, doing work a parser would otherwise do alone
+    if (!range_pool_ && config_.wide_line_bytes > 0 && !sample_selection_.columns.empty()) {
+        range_pool_ = std::make_unique<ThreadPool>(
+            config_.parser_count,
+            [this](std::size_t worker) { placement_.pin_current_thread(kFirstParserSlot + worker); });
+    }
+    record_filter_.reset();
+    if (!config_.filter.empty()) {
+        record_filter_.emplace(RecordFilter::compile(config_.filter, *dictionary_));
+    }
+    allele_splitter_.reset();
+    if (config_.split_multiallelic) {
+        allele_splitter_.emplace(*dictionary_, &metrics_.records_split, &metrics_.records_trimmed);
+
+        // The filter then runs on decoded parts, which only hold the projected INFO keys
+        for (const auto& key : record_filter_ ? record_filter_->info_keys() : std::vector<std::string>{}) {
+            if (!info_fields_.keeps(key)) {
+                throw utils::errors::ValidationError(utils::format(
+                    "Context: filter tests INFO.{}, which the INFO projection drops; with multiallelic "
+                    "splitting the filter runs on the decoded records",
+                    key));
+            }
+        }
+    }
+    duplicate_filter_.reset();
+    if (config_.dedup != api::DedupMode::Off) {
+        const auto order = config_.dedup == api::DedupMode::Sorted ? DuplicateFilter::Order::Sorted
+                                                                   : DuplicateFilter::Order::Unsorted;
+        duplicate_filter_.emplace(order, config_.parser_count, &metrics_.duplicates);
+    }
 }
 
 } // namespace vcf_tool::domain::pipeline
@@ -2,9 +2,28 @@
 #pragma once
 
 #include <cstddef>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
+#include <vcf_tool/core/Affinity.h>
 #include <vcf_tool/core/ThreadPool.h>
+#include <vcf_tool/core/Metrics.h>
+#include <vcf_tool/domain/VcfTool.h>
 #include "../Queues.h"
+#include "../metrics/PipelineMetrics.h"
+#include "../parser/ParserGate.h"
+#include "../header/VcfHeader.h"
+#include "../header/VcfDictionary.h"
+#include "../header/SampleSelection.h"
+#include "../header/FieldProjection.h"
+#include "../filter/DuplicateFilter.h"
+#include "../filter/RecordFilter.h"
+#include "../transform/AlleleSplitter.h"
+#include "../memory/ChunkArena.h"
+#include "../memory/LineBufferPool.h"
 
 
 namespace vcf_tool::domain::pipeline {
@@ -12,11 +31,24 @@ namespace vcf_tool::domain::pipeline {
 using vcf_tool::core::ThreadPool;
 using vcf_tool::domain::LineQueue;
 using vcf_tool::domain::RecordQueue;
+using vcf_tool::core::metrics::MetricsRegistry;
+using vcf_tool::domain::metrics::PipelineMetrics;
+using vcf_tool::domain::parser::ParserGate;
+using vcf_tool::core::affinity::CpuPlacement;
+using vcf_tool::domain::memory::ArenaPool;
+using vcf_tool::domain::memory::LineBufferPool;
+using vcf_tool::domain::header::VcfHeader;
+using vcf_tool::domain::header::VcfDictionary;
+using vcf_tool::domain::header::SampleSelection;
+using vcf_tool::domain::header::FieldProjection;
+using vcf_tool::domain::filter::DuplicateFilter;
+using vcf_tool::domain::filter::RecordFilter;
+using vcf_tool::domain::transform::AlleleSplitter;
 
 /**
  * @brief State container for VCF processing pipeline
  *
- * Owns all shared resources: queues, thread pool, and configuration.
+ * Owns all shared resources: queues, thread pool, metrics, and configuration.
  * Contains zero orchestration logic - just data and resource management.
  * Fresh instance created for each VCF file processed.
  */
@@ -30,13 +62,46 @@ public:
         std::size_t batch_size;             // Records per batch for DB writes
         std::size_t line_queue_capacity;    // Max lines in reader->parser queue
         std::size_t record_queue_capacity;  // Max records in parser->writer queue
+        std::string checkpoint_path;        // Checkpoint file (empty = disabled)
+        std::chrono::milliseconds checkpoint_interval{5000};  // Min time between checkpoint writes
+        bool resume{false};                 // Continue from checkpoint_path if present
+        std::string metrics_file;           // Prometheus text file (empty = no periodic export)
+        std::chrono::milliseconds metrics_interval{5000};  // Time between metrics exports
+        std::string metrics_summary;        // JSON summary written at end of run (empty = none)
+        std::chrono::milliseconds progress_interval{0};  // Time between progress logs (0 = off)
+        std::string trace_out;              // Chrome trace-event JSON output (empty = tracing off)
+        api::SinkType sink{api::SinkType::Mongo};  // Where batches are written
+        api::FakeSinkOptions fake_sink;     // Fake sink behaviour (sink == Fake)
+        std::string collection;             // MongoDB collection (empty = the configured one)
+        std::size_t write_retries{3};       // Retries per failed batch write
+        std::chrono::milliseconds retry_backoff{100};  // Delay before the first retry
+        bool adaptive_parsers{false};       // Vary active parsers in [min_parsers, parser_count]
+        std::size_t min_parsers{1};         // Lower bound for adaptive parsing
+        api::AffinityPolicy affinity{api::AffinityPolicy::None};  // CPU pinning of pipeline threads
+        std::string affinity_cpus;          // CPU list for AffinityPolicy::Explicit ("0-3,8")
+        std::size_t wide_line_bytes{0};     // Split sample columns of longer lines (0 = never)
+        std::string samples;                // Sample selection spec (empty = all samples)
+        std::string info_fields;            // INFO projection spec (empty = all keys)
+        std::string format_fields;          // FORMAT projection spec (empty = all keys)
+        std::string filter;                 // Record filter expression (empty = keep all)
+        std::size_t max_errors{0};          // Malformed lines tolerated (0 = the first one fails)
+        std::string reject_path;            // Where tolerated malformed lines go
+        bool split_multiallelic{false};     // Split multiallelic records into biallelic ones
+        api::DedupMode dedup{api::DedupMode::Off};  // Drop repeated CHROM/POS/REF/ALT
     };
 
+    // Thread slots in the CPU placement order
+    static constexpr std::size_t kReaderSlot = 0;
+    static constexpr std::size_t kWriterSlot = 1;
+    static constexpr std::size_t kFirstParserSlot = 2;
+
     /**
      * Construct a context with the given configuration.
-     * Initializes queues with configured capacities and thread pool with parser_count threads.
+     * Initializes queues with configured capacities and thread pool with parser_count threads,
+     * and registers the pipeline metrics (including queue depth gauges).
      *
      * @param config  Configuration for queues and thread pool
+     * @throws ValidationError if the affinity CPU list is invalid
      */
     explicit Context(Config config);
 
@@ -50,20 +115,114 @@ public:
     ThreadPool& thread_pool() { return thread_pool_; }
     const ThreadPool& thread_pool() const { return thread_pool_; }
 
+    // Chunk arenas of parser `parser`: one pool per NUMA node the parsers are
+    // pinned to, or one per parser thread when they are not pinned
+    ArenaPool& arena_pool(std::size_t parser) { return *arena_pools_[arena_pool_of_[parser]]; }
+
+    // Line buffers recycled from the parsers to the reader. A single pool:
+    // the reader fills every buffer, so they live on the reader's node anyway
+    LineBufferPool& line_buffers() { return line_buffers_; }
+
+    // Active-parser gate (all parser_count workers active unless adaptive)
+    ParserGate& parser_gate() { return parser_gate_; }
+
+    // Pool for parallel batch encoding (nullptr unless adaptive parsing can free cores)
+    ThreadPool* encode_pool() { return encode_pool_.get(); }
+
+    // Pool parsing sample ranges of wide lines (nullptr if splitting is off or
+    // no header loaded so far had a sample to decode)
+    ThreadPool* range_pool() { return range_pool_.get(); }
+
+    /**
+     * Read the header of `file_path`, seed the dictionary from it and
+     * resolve the sample selection against its #CHROM line. Projected
+     * INFO / FORMAT keys the header does not declare are logged. The
+     * record filter is compiled against the seeded dictionary, and the
+     * allele splitter (if enabled) reads its INFO / FORMAT shapes. The
+     * duplicate filter starts empty for each file. The wide-line range
+     * pool is started by the first header with a selected sample.
+     * Must be called before any worker starts.
+     *
+     * @throws IOError if the file (or the sample file) cannot be opened
+     * @throws ValidationError if a selected sample is not in the header,
+     *         or the filter expression is invalid
+     */
+    void load_header(const std::string& file_path);
+
+    // Header of the input (empty until load_header)
+    const VcfHeader& header() const { return header_; }
+
+    // Interned contigs, FILTER values and INFO / FORMAT keys shared by parsers and sink
+    VcfDictionary& dictionary() { return *dictionary_; }
+    const VcfDictionary& dictionary() const { return *dictionary_; }
+
+    // Sample columns the parsers keep (all until load_header)
+    const SampleSelection& sample_selection() const { return sample_selection_; }
+
+    // INFO / FORMAT keys the parsers keep
+    const FieldProjection& info_fields() const { return info_fields_; }
+    const FieldProjection& format_fields() const { return format_fields_; }
+
+    // Compiled record filter (nullptr = keep every record)
+    const RecordFilter* record_filter() const { return record_filter_ ? &*record_filter_ : nullptr; }
+
+    // Multiallelic record splitter (nullptr = records are not split)
+    const AlleleSplitter* allele_splitter() const { return allele_splitter_ ? &*allele_splitter_ : nullptr; }
+
+    // Duplicate record filter shared by the parsers (nullptr = duplicates are kept)
+    DuplicateFilter* duplicate_filter() { return duplicate_filter_ ? &*duplicate_filter_ : nullptr; }
+
+    // CPU placement (disabled unless an affinity policy is set)
+    const CpuPlacement& placement() const { return placement_; }
+
     std::size_t parser_count() const { return config_.parser_count; }
     std::size_t batch_size() const { return config_.batch_size; }
 
+    MetricsRegistry& metrics_registry() { return metrics_registry_; }
+    const MetricsRegistry& metrics_registry() const { return metrics_registry_; }
+
+    PipelineMetrics& metrics() { return metrics_; }
+    const PipelineMetrics& metrics() const { return metrics_; }
+
     const Config& config() const { return config_; }
 
 private:
     Config config_;
 
+    // Must precede the pools: their workers pin themselves on start
+    CpuPlacement placement_;
+
+    // Metrics (registry must outlive the handles in metrics_)
+    MetricsRegistry metrics_registry_;
+    PipelineMetrics metrics_;
+
+    VcfHeader header_;
+    std::unique_ptr<VcfDictionary> dictionary_;
+    SampleSelection sample_selection_;
+    FieldProjection info_fields_;
+    FieldProjection format_fields_;
+    std::optional<RecordFilter> record_filter_;
+    std::optional<AlleleSplitter> allele_splitter_;
+    std::optional<DuplicateFilter> duplicate_filter_;
+
+    // Must outlive the queues: queued records reference pooled arenas
+    std::vector<std::unique_ptr<ArenaPool>> arena_pools_;
+    std::vector<std::size_t> arena_pool_of_;  // Parser -> index in arena_pools_
+    LineBufferPool line_buffers_;
+
     // Queues for pipeline communication
     LineQueue line_queue_;
     RecordQueue record_queue_;
 
     // Thread pool for parser workers
     ThreadPool thread_pool_;
+
+    // Adaptive parsing: parked parsers' cores go to the encode pool
+    ParserGate parser_gate_;
+    std::unique_ptr<ThreadPool> encode_pool_;
+
+    // Wide lines: parsers hand sample ranges to these workers and wait for them
+    std::unique_ptr<ThreadPool> range_pool_;
 };
 
 } // namespace vcf_tool::domain::pipeline
@@ -4,20 +4,54 @@
 #include <iostream>  // TODO: Replace with Logger
 #include <exception>
 #include <memory>
+#include <filesystem>
+#include <fstream>
+
+#include <vcf_tool/core/Metrics.h>
+#include <vcf_tool/core/Tracer.h>
+
+#include <vcf_tool/utils/Logger.h>
+#include <vcf_tool/utils/Errors.h>
+#include <vcf_tool/utils/Format.h>
 
 #include "../parser/SimpleParserService.h"
 #include "../parser/VcfLineParser.h"
-#include "../dao/VcfDao.h"
+#include "../sink/SinkFactory.h"
+#include "../checkpoint/CheckpointTracker.h"
+#include "ProgressReporter.h"
+#include "AdaptiveController.h"
 
 
 namespace vcf_tool::domain::pipeline {
 
 using vcf_tool::domain::parser::SimpleParserService;
-using vcf_tool::domain::VcfLineParser;
+using vcf_tool::domain::BasicVcfLineParser;
+using vcf_tool::domain::parser::InfoMode;
+using vcf_tool::domain::parser::SampleMode;
+using vcf_tool::domain::checkpoint::Checkpoint;
+using vcf_tool::domain::checkpoint::CheckpointStore;
+using vcf_tool::domain::checkpoint::CheckpointTracker;
+using vcf_tool::core::metrics::MetricsExporter;
+using vcf_tool::core::metrics::Stopwatch;
+using vcf_tool::core::trace::Tracer;
+
+namespace {
+
+// Report interval when only a callback was requested
+constexpr std::chrono::milliseconds kDefaultProgressInterval{1000};
+
+// Sampling interval of the adaptive parser controller
+constexpr std::chrono::milliseconds kAdaptiveInterval{500};
 
-Pipeline::Pipeline(Context& ctx, std::string file_path)
+// How long to wait on one parser before checking the next for a failure
+constexpr std::chrono::milliseconds kErrorPollInterval{50};
+
+} // namespace
+
+Pipeline::Pipeline(Context& ctx, std::string file_path, api::ProgressCallback on_progress)
     : ctx_(ctx)
     , file_path_(std::move(file_path))
+    , on_progress_(std::move(on_progress))
 {
 }
 
@@ -25,39 +59,278 @@ void Pipeline::execute()
 {
     std::cerr << "Pipeline: starting for file: " << file_path_ << "\n";
 
+    checkpoint_ = prepare_checkpoint();
+    if (checkpoint_ && checkpoint_->completed()) {
+        LOG_INFO_F("Pipeline: checkpoint shows '{}' was already fully imported, nothing to do",
+                   file_path_);
+        return;
+    }
+
+    // Seed the dictionary before any worker can intern into it
+    ctx_.load_header(file_path_);
+    const auto& header = ctx_.header();
+    LOG_INFO_F("Pipeline: header declares {} contigs, {} FILTER, {} INFO, {} FORMAT, {} samples",
+               header.contigs.size(), header.filters.size(), header.info.size(),
+               header.format.size(), header.samples.size());
+    if (!ctx_.sample_selection().all()) {
+        LOG_INFO_F("Pipeline: keeping {} of {} samples", ctx_.sample_selection().columns.size(),
+                   header.samples.size());
+    }
+    if (const auto& cfg = ctx_.config(); !cfg.info_fields.empty() || !cfg.format_fields.empty()) {
+        LOG_INFO_F("Pipeline: INFO fields '{}', FORMAT fields '{}'",
+                   cfg.info_fields.empty() ? "all" : cfg.info_fields,
+                   cfg.format_fields.empty() ? "all" : cfg.format_fields);
+    }
+    if (const auto* filter = ctx_.record_filter()) {
+        LOG_INFO_F("Pipeline: keeping records matching '{}'", filter->expression());
+    }
+    if (ctx_.allele_splitter()) {
+        LOG_INFO_F("Pipeline: splitting multiallelic records into biallelic ones");
+    }
+    if (const auto* duplicates = ctx_.duplicate_filter()) {
+        LOG_INFO_F("Pipeline: dropping duplicate records ({} input)",
+                   duplicates->order() == DuplicateFilter::Order::Sorted ? "sorted" : "unsorted");
+    }
+    if (const auto& cfg = ctx_.config(); cfg.max_errors > 0) {
+        // A resumed run keeps the rows of the lines it already skipped
+        rejects_ = std::make_unique<parser::RejectLog>(cfg.reject_path, cfg.max_errors, cfg.resume,
+                                                       ctx_.metrics());
+        LOG_INFO_F("Pipeline: tolerating up to {} malformed lines, rejected to '{}'",
+                   cfg.max_errors, cfg.reject_path);
+    }
+
+    Stopwatch wall;
+    const auto& config = ctx_.config();
+
+    // Wall time is sampled at export time so live exports show progress
+    ctx_.metrics_registry().gauge_callback(
+        "vcf_pipeline_elapsed_seconds", "Seconds since the import started",
+        [wall] { return static_cast<double>(wall.elapsed_ns()) * 1e-9; });
+
+    if (!config.trace_out.empty()) {
+        Tracer::instance().start();
+    }
+
+    std::unique_ptr<MetricsExporter> exporter;
+    if (!config.metrics_file.empty()) {
+        exporter = std::make_unique<MetricsExporter>(
+            ctx_.metrics_registry(), config.metrics_file, config.metrics_interval);
+    }
+
+    std::error_code ec;
+    std::uint64_t total_bytes = std::filesystem::file_size(file_path_, ec);
+    if (ec) {
+        total_bytes = 0;  // Unknown size: progress reports no fraction / ETA
+    }
+    ctx_.metrics().input_bytes.set(static_cast<std::int64_t>(total_bytes));
+
+    std::unique_ptr<ProgressReporter> progress;
+    if (config.progress_interval.count() > 0 || on_progress_) {
+        auto interval = config.progress_interval.count() > 0
+            ? config.progress_interval
+            : kDefaultProgressInterval;
+        progress = std::make_unique<ProgressReporter>(
+            ctx_, total_bytes, checkpoint_ ? checkpoint_->byte_offset : 0,
+            interval, on_progress_, config.progress_interval.count() > 0);
+    }
+
     // Start all workers
     auto reader = start_reader();
     auto parser_futures = start_parsers();
     auto writer = start_writer();
 
+    // Parser and encode pool workers pinned themselves when the Context started them
+    const auto& placement = ctx_.placement();
+    if (placement.enabled()) {
+        placement.pin_thread(reader->native_handle(), Context::kReaderSlot);
+        placement.pin_thread(writer->native_handle(), Context::kWriterSlot);
+        LOG_INFO_F("Pipeline: CPU affinity {}", placement.describe());
+    }
+
+    std::unique_ptr<AdaptiveController> controller;
+    if (config.adaptive_parsers) {
+        controller = std::make_unique<AdaptiveController>(
+            ctx_, *writer, config.min_parsers, kAdaptiveInterval);
+    }
+
     // Wait for completion and check errors
-    wait_and_check_errors(reader, parser_futures, writer);
+    try {
+        wait_and_check_errors(reader, parser_futures, writer);
+    } catch (...) {
+        if (progress) {
+            progress->finish(false);
+        }
+        throw;
+    }
+    controller.reset();  // Holds a reference to the writer
+
+    // Join the writer (it may still be flushing) so final reports see the whole run
+    writer.reset();
+    reader.reset();
+
+    if (progress) {
+        progress->finish(true);  // Final report
+    }
+    exporter.reset();  // Final export
+    write_metrics_summary(wall);
+    write_trace();
 
     std::cerr << "Pipeline: completed successfully for file: " << file_path_ << "\n";
 }
 
+void Pipeline::write_metrics_summary(const Stopwatch& wall) const
+{
+    const auto& metrics = ctx_.metrics();
+    LOG_INFO_F("Pipeline: read {} lines, parsed {} records, wrote {} records in {} batches "
+               "({} failed) in {} ms",
+               metrics.lines_read.value(), metrics.records_parsed.value(),
+               metrics.records_written.value(), metrics.batches.value(),
+               metrics.failed_batches.value(), wall.elapsed_ns() / 1'000'000);
+    if (ctx_.record_filter()) {
+        LOG_INFO_F("Pipeline: filter accepted {} records, rejected {}",
+                   metrics.filter_accepted.value(), metrics.filter_rejected.value());
+    }
+    if (ctx_.allele_splitter()) {
+        LOG_INFO_F("Pipeline: split {} multiallelic records, trimmed {}",
+                   metrics.records_split.value(), metrics.records_trimmed.value());
+    }
+    if (ctx_.duplicate_filter()) {
+        LOG_INFO_F("Pipeline: dropped {} duplicate records", metrics.duplicates.value());
+    }
+    if (rejects_ && rejects_->count() > 0) {
+        LOG_WARN_F("Pipeline: rejected {} malformed lines ({} too few columns, {} bad POS), see '{}'",
+                   rejects_->count(), metrics.malformed_columns.value(),
+                   metrics.malformed_position.value(), rejects_->path());
+    }
+
+    const auto& path = ctx_.config().metrics_summary;
+    if (path.empty()) {
+        return;
+    }
+
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        LOG_WARN_F("Pipeline: cannot write metrics summary to '{}'", path);
+        return;
+    }
+    out << ctx_.metrics_registry().to_json() << "\n";
+    LOG_INFO_F("Pipeline: metrics summary written to '{}'", path);
+}
+
+void Pipeline::write_trace() const
+{
+    const auto& path = ctx_.config().trace_out;
+    if (path.empty()) {
+        return;
+    }
+
+    auto& tracer = Tracer::instance();
+    tracer.stop();
+
+    try {
+        tracer.write_chrome_trace(path);
+        LOG_INFO_F("Pipeline: trace written to '{}' (open in ui.perfetto.dev or chrome://tracing)", path);
+    } catch (const utils::errors::IOError& e) {
+        // The import itself succeeded - don't fail the run over the trace
+        LOG_WARN_F("{}", e.what());
+    }
+}
+
+std::optional<Checkpoint> Pipeline::prepare_checkpoint() const
+{
+    const auto& config = ctx_.config();
+    if (config.checkpoint_path.empty()) {
+        return std::nullopt;
+    }
+
+    Checkpoint fresh;
+    fresh.source = file_path_;
+    fresh.file_size = std::filesystem::file_size(file_path_);
+
+    if (!config.resume) {
+        return fresh;
+    }
+
+    auto saved = CheckpointStore(config.checkpoint_path).load_for(fresh.source, fresh.file_size);
+    if (!saved) {
+        LOG_WARN_F("Pipeline: no checkpoint at '{}', starting from the beginning",
+                   config.checkpoint_path);
+        return fresh;
+    }
+
+    LOG_INFO_F("Pipeline: resuming '{}' after line {} (byte offset {}, {} lines already committed ahead)",
+               file_path_, saved->line_number, saved->byte_offset, saved->lines_ahead());
+    return saved;
+}
+
 std::unique_ptr<FileLineReaderWorker> Pipeline::start_reader()
 {
+    reader::StartPosition start;
+    if (checkpoint_) {
+        start.byte_offset = checkpoint_->byte_offset;
+        start.line_number = checkpoint_->line_number;
+        for (const auto& committed : checkpoint_->committed_ahead) {
+            start.skip_ranges.emplace_back(committed.first, committed.last);
+        }
+    }
+
     return std::make_unique<FileLineReaderWorker>(
         file_path_,
         ctx_.line_queue(),
+        ctx_.metrics(),
         true,  // emit_sentinel
-        ctx_.parser_count()  // sentinel_count (one per parser)
+        ctx_.parser_count(),  // sentinel_count (one per parser)
+        std::move(start),
+        &ctx_.line_buffers()
     );
     // Thread starts immediately in FileLineReaderWorker constructor
 }
 
 std::vector<std::future<void>> Pipeline::start_parsers()
+{
+    // Pick the parser variant compiled for this header and these options
+    const SampleMode samples = ctx_.header().samples.empty() ? SampleMode::SitesOnly
+        : ctx_.sample_selection().all()                      ? SampleMode::All
+                                                             : SampleMode::Selected;
+    const InfoMode info = ctx_.info_fields().keeps_all() ? InfoMode::All : InfoMode::Projected;
+    LOG_INFO_F("Pipeline: parser specialized for {}, {}", parser::to_string(samples), parser::to_string(info));
+
+    return parser::with_parser_policy(samples, info, [this]<typename Policy>(Policy) {
+        return launch_parsers<BasicVcfLineParser<Policy>>();
+    });
+}
+
+template<typename Parser>
+std::vector<std::future<void>> Pipeline::launch_parsers()
 {
     std::vector<std::future<void>> futures;
     futures.reserve(ctx_.parser_count());
 
+    Parser parser{ctx_.dictionary()};
+    if (ThreadPool* pool = ctx_.range_pool()) {
+        parser.split_wide_lines(*pool, ctx_.config().wide_line_bytes, &ctx_.metrics().wide_lines);
+    }
+    if (!ctx_.sample_selection().all()) {
+        parser.select_samples(ctx_.sample_selection().columns);
+    }
+    parser.project_fields(ctx_.info_fields(), ctx_.format_fields());
+
     for (std::size_t i = 0; i < ctx_.parser_count(); ++i) {
         // Create parser service (functor)
         SimpleParserService parser_service{
             .input_queue = ctx_.line_queue(),
             .output_queue = ctx_.record_queue(),
-            .parser = VcfLineParser{}
+            .parser = parser,
+            .metrics = ctx_.metrics(),
+            .gate = &ctx_.parser_gate(),
+            .index = i,
+            .arenas = &ctx_.arena_pool(i),
+            .line_buffers = &ctx_.line_buffers(),
+            .filter = ctx_.record_filter(),
+            .commit_rejected = checkpoint_.has_value(),
+            .rejects = rejects_.get(),
+            .splitter = ctx_.allele_splitter(),
+            .duplicates = ctx_.duplicate_filter()
         };
 
         // Submit to thread pool and store future
@@ -77,35 +350,60 @@ std::vector<std::future<void>> Pipeline::start_parsers()
 
 std::unique_ptr<DbWriterWorker> Pipeline::start_writer()
 {
-    // Create VcfDao instance for this pipeline
-    auto dao = std::make_unique<dao::VcfDao>();
+    // Create the record sink for this pipeline
+    const auto& config = ctx_.config();
+    auto record_sink = sink::make_sink(config.sink, config.fake_sink, ctx_.dictionary(), config.collection);
+
+    std::unique_ptr<CheckpointTracker> tracker;
+    if (checkpoint_) {
+        tracker = std::make_unique<CheckpointTracker>(
+            CheckpointStore(config.checkpoint_path),
+            *checkpoint_,
+            config.checkpoint_interval
+        );
+    }
 
     return std::make_unique<DbWriterWorker>(
         ctx_.record_queue(),
         ctx_.batch_size(),
         ctx_.parser_count(),  // sentinel_count (expects N sentinels from N parsers)
-        std::move(dao)  // Inject DAO
+        std::move(record_sink),  // Inject sink
+        ctx_.metrics(),
+        writer::RetryPolicy{config.write_retries, config.retry_backoff},
+        ctx_.encode_pool(),
+        std::move(tracker)
     );
     // Thread starts immediately in DbWriterWorker constructor
 }
 
 void Pipeline::wait_and_check_errors(
-    [[maybe_unused]] std::unique_ptr<FileLineReaderWorker>& reader,
+    std::unique_ptr<FileLineReaderWorker>& reader,
     std::vector<std::future<void>>& parser_futures,
     [[maybe_unused]] std::unique_ptr<DbWriterWorker>& writer)
 {
-    // reader and writer are intentionally passed by reference (not used in body)
-    // so their RAII destructors auto-join the jthread workers when function returns
+    // writer is intentionally passed by reference (not used in body) so its
+    // RAII destructor auto-joins the jthread worker when function returns
 
     // Collect errors from parser futures
     std::vector<std::exception_ptr> errors;
 
-    for (auto& fut : parser_futures) {
-        try {
-            fut.get();  // Blocks until parser completes, re-throws if exception occurred
-        } catch (...) {
-            // Capture exception for later reporting
-            errors.push_back(std::current_exception());
+    // Poll all parsers so the first failure stops the reader right away,
+    // not once the parsers ahead of it in the list have drained the input
+    std::vector<bool> collected(parser_futures.size(), false);
+    for (std::size_t remaining = parser_futures.size(); remaining > 0;) {
+        for (std::size_t i = 0; i < parser_futures.size(); ++i) {
+            if (collected[i] || parser_futures[i].wait_for(kErrorPollInterval) != std::future_status::ready) {
+                continue;
+            }
+            collected[i] = true;
+            --remaining;
+            try {
+                parser_futures[i].get();  // Re-throws if the parser failed
+            } catch (...) {
+                // Capture exception for later reporting; the rest of the input is not needed
+                errors.push_back(std::current_exception());
+                reader->request_stop();
+            }
         }
     }
 
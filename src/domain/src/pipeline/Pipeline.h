@@ -5,10 +5,17 @@
 #include <memory>
 #include <vector>
 #include <future>
+#include <optional>
+
+#include <vcf_tool/core/Metrics.h>
+
+#include <vcf_tool/domain/Progress.h>
 
 #include "Context.h"
 #include "../reader/FileLineReaderWorker.h"
 #include "../writer/DbWriterWorker.h"
+#include "../checkpoint/CheckpointStore.h"
+#include "../parser/RejectLog.h"
 
 
 namespace vcf_tool::domain::pipeline {
@@ -21,7 +28,8 @@ using vcf_tool::domain::writer::DbWriterWorker;
  *
  * Coordinates the lifecycle of all workers:
  * - 1 reader thread (FileLineReaderWorker)
- * - N parser threads (submitted to ThreadPool)
+ * - N parser threads (submitted to ThreadPool), running the parser variant
+ *   specialized for the input's header and the options (ParserPolicy)
  * - 1 writer thread (DbWriterWorker)
  *
  * Handles:
@@ -29,16 +37,23 @@ using vcf_tool::domain::writer::DbWriterWorker;
  * - Waiting for completion
  * - Propagating errors from parser futures
  * - RAII cleanup via unique_ptr (reader/writer auto-join)
+ * - Loading the resume checkpoint and wiring checkpointing into reader/writer
+ * - Periodic metrics export and the end-of-run metrics summary
+ * - Periodic progress reports (log and/or callback)
+ * - Optional span tracing of all workers, dumped as Chrome trace-event JSON
+ * - Optional adaptive parser concurrency (AdaptiveController)
+ * - Lenient parsing (--max-errors): the reject log shared by the parsers
  */
 class Pipeline {
 public:
     /**
      * Construct a pipeline for processing a VCF file.
      *
-     * @param ctx        Reference to Context containing queues, pool, and config
-     * @param file_path  Path to VCF file to process
+     * @param ctx          Reference to Context containing queues, pool, and config
+     * @param file_path    Path to VCF file to process
+     * @param on_progress  Optional progress consumer (called from a reporter thread)
      */
-    Pipeline(Context& ctx, std::string file_path);
+    Pipeline(Context& ctx, std::string file_path, api::ProgressCallback on_progress = {});
 
     /**
      * Execute the complete pipeline:
@@ -55,10 +70,29 @@ public:
 private:
     Context& ctx_;
     std::string file_path_;
+    api::ProgressCallback on_progress_;
+
+    // Checkpoint this run starts from (std::nullopt = checkpointing disabled)
+    std::optional<checkpoint::Checkpoint> checkpoint_;
+
+    // Malformed lines tolerated so far (nullptr = strict parsing)
+    std::unique_ptr<parser::RejectLog> rejects_;
+
+    // Load the resume checkpoint (or start a fresh one) if checkpointing is enabled
+    std::optional<checkpoint::Checkpoint> prepare_checkpoint() const;
+
+    // Log the run totals and write the JSON metrics summary (if configured)
+    void write_metrics_summary(const core::metrics::Stopwatch& wall) const;
+
+    // Stop tracing and dump the trace (if configured)
+    void write_trace() const;
 
     // Worker lifecycle management
     std::unique_ptr<FileLineReaderWorker> start_reader();
     std::vector<std::future<void>> start_parsers();
+    // Parser workers with the parser variant chosen by start_parsers()
+    template<typename Parser>
+    std::vector<std::future<void>> launch_parsers();
     std::unique_ptr<DbWriterWorker> start_writer();
 
     // Error handling
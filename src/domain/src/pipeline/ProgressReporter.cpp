@@ -0,0 +1,147 @@
+// ProgressReporter.cpp
+#include "ProgressReporter.h"
+
+#include <algorithm>
+#include <exception>
+#include <string>
+
+#include <vcf_tool/utils/Logger.h>
+#include <vcf_tool/utils/Format.h>
+
+
+namespace vcf_tool::domain::pipeline {
+
+namespace {
+
+constexpr double kBytesPerMB = 1024.0 * 1024.0;
+
+double per_second(std::uint64_t delta, std::chrono::steady_clock::duration elapsed)
+{
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    return seconds > 0.0 ? static_cast<double>(delta) / seconds : 0.0;
+}
+
+} // namespace
+
+ProgressReporter::ProgressReporter(const Context& ctx,
+                                   std::uint64_t total_bytes,
+                                   std::uint64_t start_offset,
+                                   std::chrono::milliseconds interval,
+                                   ProgressCallback callback,
+                                   bool log)
+    : ctx_(ctx)
+    , total_bytes_(total_bytes)
+    , start_offset_(start_offset)
+    , interval_(interval)
+    , callback_(std::move(callback))
+    , log_(log)
+    , started_(std::chrono::steady_clock::now())
+    , last_time_(started_)
+    , last_bytes_(start_offset)
+    , thread_([this](std::stop_token st) {
+        run(st);
+      })
+{
+}
+
+ProgressReporter::~ProgressReporter()
+{
+    finish(false);
+}
+
+void ProgressReporter::finish(bool succeeded)
+{
+    if (finished_) {
+        return;
+    }
+    finished_ = true;
+    thread_.request_stop();
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    report(true, !succeeded);
+}
+
+void ProgressReporter::run(std::stop_token st)
+{
+    while (!st.stop_requested()) {
+        {
+            std::unique_lock lock(mutex_);
+            // Returns early when stop is requested
+            cv_.wait_for(lock, st, interval_, [] { return false; });
+        }
+        if (st.stop_requested()) {
+            break;
+        }
+        report(false);
+    }
+}
+
+void ProgressReporter::report(bool finished, bool failed)
+{
+    const auto& metrics = ctx_.metrics();
+    const auto& config = ctx_.config();
+    auto now = std::chrono::steady_clock::now();
+
+    Progress progress;
+    progress.bytes_read = static_cast<std::uint64_t>(metrics.read_offset.value());
+    progress.total_bytes = total_bytes_;
+    progress.lines_read = metrics.lines_read.value();
+    progress.records_written = metrics.records_written.value();
+    progress.line_queue_depth = ctx_.line_queue().size_approx();
+    progress.line_queue_capacity = config.line_queue_capacity;
+    progress.record_queue_depth = ctx_.record_queue().size_approx();
+    progress.record_queue_capacity = config.record_queue_capacity;
+    progress.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - started_);
+    progress.finished = finished;
+    progress.failed = failed;
+
+    // The reader offset can briefly trail the resume offset at startup
+    std::uint64_t bytes = std::max(progress.bytes_read, last_bytes_);
+    if (finished) {
+        // Final report: averages over the whole run
+        progress.mb_per_sec = per_second(bytes - start_offset_, now - started_) / kBytesPerMB;
+        progress.records_per_sec = per_second(progress.records_written, now - started_);
+    } else {
+        progress.mb_per_sec = per_second(bytes - last_bytes_, now - last_time_) / kBytesPerMB;
+        progress.records_per_sec = per_second(progress.records_written - last_records_, now - last_time_);
+    }
+
+    // ETA from the average rate of this run (steadier than the last interval)
+    double avg_bytes_per_sec = per_second(bytes - start_offset_, now - started_);
+    if (finished) {
+        progress.eta = std::chrono::seconds{0};
+    } else if (avg_bytes_per_sec > 0.0 && total_bytes_ >= bytes) {
+        progress.eta = std::chrono::seconds{
+            static_cast<std::int64_t>(static_cast<double>(total_bytes_ - bytes) / avg_bytes_per_sec)};
+    }
+
+    last_time_ = now;
+    last_bytes_ = bytes;
+    last_records_ = progress.records_written;
+
+    if (log_) {
+        LOG_INFO_F("{}: {:.1f}% ({:.1f}/{:.1f} MB), {} records, {:.0f} rec/s, {:.1f} MB/s, "
+                   "queues {}/{} lines {}/{} records, ETA {}",
+                   failed ? "Failed" : (finished ? "Finished" : "Progress"),
+                   progress.fraction() * 100.0,
+                   static_cast<double>(progress.bytes_read) / kBytesPerMB,
+                   static_cast<double>(progress.total_bytes) / kBytesPerMB,
+                   progress.records_written, progress.records_per_sec, progress.mb_per_sec,
+                   progress.line_queue_depth, progress.line_queue_capacity,
+                   progress.record_queue_depth, progress.record_queue_capacity,
+                   progress.eta ? utils::format("{}s", progress.eta->count()) : std::string("?"));
+    }
+
+    if (callback_) {
+        try {
+            callback_(progress);
+        } catch (const std::exception& e) {
+            // A failing observer must not take the import down
+            LOG_WARN_F("Progress callback threw: {}", e.what());
+        }
+    }
+}
+
+} // namespace vcf_tool::domain::pipeline
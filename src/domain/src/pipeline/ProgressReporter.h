@@ -0,0 +1,79 @@
+// ProgressReporter.h
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+
+#include <vcf_tool/domain/Progress.h>
+#include "Context.h"
+
+
+namespace vcf_tool::domain::pipeline {
+
+using api::Progress;
+using api::ProgressCallback;
+
+/**
+ * @brief Background thread that reports import progress at a fixed interval
+ *
+ * Samples the pipeline metrics (reader offset, records written) and queue
+ * depths, logs a one-line summary and hands a Progress snapshot to the
+ * optional callback. Sampling only reads relaxed atomics, so workers are
+ * never slowed down. finish() stops the thread and emits the final report
+ * (`finished = true`, `failed` unless the run succeeded); a reporter destroyed
+ * without it reports the run as failed.
+ */
+class ProgressReporter {
+public:
+    /**
+     * @param ctx           Pipeline context (metrics and queues are sampled)
+     * @param total_bytes   Input size
+     * @param start_offset  Offset the reader starts from (non-zero on resume)
+     * @param interval      Time between reports
+     * @param callback      Optional consumer of each report
+     * @param log           Log each report (false = callback only)
+     */
+    ProgressReporter(const Context& ctx,
+                     std::uint64_t total_bytes,
+                     std::uint64_t start_offset,
+                     std::chrono::milliseconds interval,
+                     ProgressCallback callback,
+                     bool log);
+
+    ~ProgressReporter();
+
+    /// Stop reporting and emit the final report; later calls do nothing
+    void finish(bool succeeded);
+
+    ProgressReporter(const ProgressReporter&) = delete;
+    ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+private:
+    void run(std::stop_token st);
+    void report(bool finished, bool failed = false);
+
+    const Context& ctx_;
+    std::uint64_t total_bytes_;
+    std::uint64_t start_offset_;
+    std::chrono::milliseconds interval_;
+    ProgressCallback callback_;
+    bool log_;
+
+    std::chrono::steady_clock::time_point started_;
+
+    // Previous sample, for per-interval rates (reporter thread only)
+    std::chrono::steady_clock::time_point last_time_;
+    std::uint64_t last_bytes_;
+    std::uint64_t last_records_{0};
+
+    std::mutex mutex_;
+    std::condition_variable_any cv_;
+    bool finished_{false};
+    std::jthread thread_;
+};
+
+} // namespace vcf_tool::domain::pipeline
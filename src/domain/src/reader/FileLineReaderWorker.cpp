@@ -3,18 +3,28 @@
 
 #include <fstream>
 #include <iostream>  // or your Logger
+#include <iterator>
+
+#include <vcf_tool/core/Metrics.h>
+#include <vcf_tool/core/Tracer.h>
 
 
 namespace vcf_tool::domain::reader {
 
 FileLineReaderWorker::FileLineReaderWorker(std::string file_path,
                                            LineQueue& output_queue,
+                                           metrics::PipelineMetrics& metrics,
                                            bool emit_sentinel,
-                                           std::size_t sentinel_count)
+                                           std::size_t sentinel_count,
+                                           StartPosition start,
+                                           memory::LineBufferPool* buffers)
     : file_path_(std::move(file_path))
     , output_queue_(output_queue)
+    , metrics_(metrics)
     , emit_sentinel_(emit_sentinel)
     , sentinel_count_(sentinel_count)
+    , start_(std::move(start))
+    , buffers_(buffers)
     , thread_([this](std::stop_token st) {
         run(st);
       })
@@ -38,6 +48,8 @@ void FileLineReaderWorker::request_stop()
 
 void FileLineReaderWorker::run(std::stop_token st)
 {
+    core::trace::Tracer::instance().set_thread_name("reader");
+
     std::ifstream in(file_path_);
     if (!in.is_open()) {
         std::cerr << "FileLineReaderWorker: failed to open file: "
@@ -52,22 +64,70 @@ void FileLineReaderWorker::run(std::stop_token st)
         return;
     }
 
-    std::string line;
-    std::uint64_t line_number = 0;
+    // Resume: skip everything already committed by a previous run
+    std::uint64_t offset = start_.byte_offset;
+    std::uint64_t line_number = start_.line_number;
+    if (offset > 0) {
+        in.seekg(static_cast<std::streamoff>(offset));
+    }
+    metrics_.read_offset.set(static_cast<std::int64_t>(offset));
+
+    auto next_skip = start_.skip_ranges.cbegin();
 
-    while (!st.stop_requested() && std::getline(in, line)) {
+    // The line queue is unbounded, so the reader never blocks: its whole
+    // lifetime is active time
+    core::metrics::Stopwatch active;
+
+    std::vector<RawLine> chunk;
+    chunk.reserve(kLineChunkSize);
+    std::vector<std::string> spare;  // Recycled buffers not yet used
+    spare.reserve(kLineChunkSize);
+    std::uint64_t chunk_bytes = 0;
+    core::trace::Span chunk_span("read_chunk", "reader");
+
+    for (;;) {
+        // Read straight into a recycled buffer (getline keeps its capacity)
+        std::string line = next_buffer(spare);
+        if (st.stop_requested() || !std::getline(in, line)) {
+            break;
+        }
         ++line_number;
 
-        RawLine raw{
+        // getline() consumed the '\n' unless the last line has no terminator
+        std::uint64_t line_bytes = line.size() + (in.eof() ? 0u : 1u);
+        offset += line_bytes;
+        chunk_bytes += line_bytes;
+
+        if (next_skip != start_.skip_ranges.cend() && line_number >= next_skip->first) {
+            // Committed ahead of the checkpoint by the previous run
+            if (line_number == next_skip->second) {
+                ++next_skip;
+            }
+            spare.push_back(std::move(line));
+            continue;
+        }
+
+        chunk.push_back(RawLine{
             .line_number = line_number,
-            .text        = line,
+            .end_offset  = offset,
+            .text        = std::move(line),
             .is_end      = false
-        };
+        });
 
-        // This will block if queue is full (bounded queue)
-        output_queue_.enqueue(std::move(raw));
+        if (chunk.size() >= kLineChunkSize) {
+            chunk_span.set_arg(chunk.size());
+            flush_chunk(chunk, chunk_bytes, offset);
+            chunk_span.end();
+            chunk_bytes = 0;
+            chunk_span.next(kLineChunkSize);
+        }
     }
 
+    chunk_span.set_arg(chunk.size());
+    flush_chunk(chunk, chunk_bytes, offset);
+    chunk_span.end();
+    metrics_.reader_active_ns.add(active.elapsed_ns());
+
     // Emit N sentinels (one per downstream parser) to signal end-of-stream
     // This ensures all N parsers receive a termination signal
     if (emit_sentinel_) {
@@ -77,4 +137,36 @@ void FileLineReaderWorker::run(std::stop_token st)
     }
 }
 
-} // namespace vcf_tool::domain::reader
\ No newline at end of file
+std::string FileLineReaderWorker::next_buffer(std::vector<std::string>& spare)
+{
+    if (spare.empty() && buffers_) {
+        metrics_.line_buffers_reused.add(buffers_->acquire_bulk(spare, kLineChunkSize));
+    }
+    if (spare.empty()) {
+        return {};
+    }
+    std::string buffer = std::move(spare.back());
+    spare.pop_back();
+    buffer.clear();
+    return buffer;
+}
+
+void FileLineReaderWorker::flush_chunk(std::vector<RawLine>& chunk, std::uint64_t bytes,
+                                       std::uint64_t offset)
+{
+    // Bytes include resume-skipped lines: they were still read from disk
+    metrics_.bytes_read.add(bytes);
+    metrics_.read_offset.set(static_cast<std::int64_t>(offset));
+
+    if (chunk.empty()) {
+        return;
+    }
+
+    metrics_.lines_read.add(chunk.size());
+
+    // One bulk enqueue per chunk instead of one queue operation per line
+    output_queue_.enqueue_bulk(std::make_move_iterator(chunk.begin()), chunk.size());
+    chunk.clear();
+}
+
+} // namespace vcf_tool::domain::reader
@@ -5,26 +5,50 @@
 #include <thread>
 #include <stop_token>
 #include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 #include "../Queues.h"
+#include "../metrics/PipelineMetrics.h"
+#include "../memory/LineBufferPool.h"
 
 namespace vcf_tool::domain::reader {
 
+/**
+ * Position to start reading from (used when resuming from a checkpoint).
+ * `line_number` is the number of lines already consumed before `byte_offset`;
+ * `skip_ranges` lists (ascending) runs of later lines, [first, last], that
+ * were already committed.
+ */
+struct StartPosition {
+    std::uint64_t byte_offset{0};
+    std::uint64_t line_number{0};
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> skip_ranges;
+};
+
 class FileLineReaderWorker {
 public:
     /**
      * Construct a worker that reads the given file line-by-line
-     * and enqueues each RawLine into the provided LineQueue.
+     * and enqueues the RawLines into the provided LineQueue in chunks
+     * of up to kLineChunkSize lines.
      *
      * @param file_path       Path to the file to read.
      * @param output_queue    Queue where lines will be pushed.
+     * @param metrics         Pipeline metrics (lines / bytes read, offset reached).
      * @param emit_sentinel   Whether to push a RawLine{.is_end = true} when done.
      * @param sentinel_count  Number of sentinel values to emit (one per downstream parser).
+     * @param start           Byte offset / line number to resume from.
+     * @param buffers         Pool of recycled line buffers (nullptr = allocate every line).
      */
     FileLineReaderWorker(std::string file_path,
                          LineQueue& output_queue,
+                         metrics::PipelineMetrics& metrics,
                          bool emit_sentinel = true,
-                         std::size_t sentinel_count = 1);
+                         std::size_t sentinel_count = 1,
+                         StartPosition start = {},
+                         memory::LineBufferPool* buffers = nullptr);
 
     // Non-copyable, non-movable
     FileLineReaderWorker(const FileLineReaderWorker&) = delete;
@@ -35,14 +59,26 @@ public:
     /// Request the worker to stop (optional, std::jthread also requests stop in dtor)
     void request_stop();
 
+    /// Underlying thread handle (for CPU pinning)
+    std::jthread::native_handle_type native_handle() { return thread_.native_handle(); }
+
 private:
     // Thread entry
     void run(std::stop_token st);
 
+    // Enqueue the pending chunk and account for it
+    void flush_chunk(std::vector<RawLine>& chunk, std::uint64_t bytes, std::uint64_t offset);
+
+    // Empty buffer for the next line, refilled from the pool one chunk at a time
+    std::string next_buffer(std::vector<std::string>& spare);
+
     std::string  file_path_;
     LineQueue&   output_queue_;
+    metrics::PipelineMetrics& metrics_;
     bool         emit_sentinel_;
     std::size_t  sentinel_count_;
+    StartPosition start_;
+    memory::LineBufferPool* buffers_;
 
     std::jthread thread_;
 };
@@ -0,0 +1,87 @@
+// FakeSink.cpp
+#include "FakeSink.h"
+
+#include <thread>
+
+#include <vcf_tool/utils/Errors.h>
+#include <vcf_tool/utils/Format.h>
+
+#include "../dao/VcfDao.h"
+
+
+namespace vcf_tool::domain::sink {
+
+FakeSink::FakeSink(const header::VcfDictionary& dictionary, FakeSinkOptions options)
+    : dictionary_(dictionary)
+    , options_(options)
+    , rng_(options.seed)
+{
+}
+
+EncodedBatch FakeSink::encode(std::span<const entity::ParsedRecord> records)
+{
+    return EncodedBatch{records.size(), dao::VcfDao::encode(records, dictionary_)};
+}
+
+std::size_t FakeSink::write(const EncodedBatch& batch)
+{
+    std::chrono::microseconds delay = options_.latency;
+    bool fail = false;
+    {
+        std::scoped_lock lock(mutex_);
+        ++write_calls_;
+        if (options_.latency_jitter.count() > 0) {
+            std::uniform_int_distribution<std::int64_t> jitter(0, options_.latency_jitter.count());
+            delay += std::chrono::microseconds(jitter(rng_));
+        }
+        if (options_.failure_rate > 0.0) {
+            fail = std::uniform_real_distribution<double>(0.0, 1.0)(rng_) < options_.failure_rate;
+        }
+    }
+
+    // Simulated round trip happens outside the lock, like a real driver call
+    if (delay.count() > 0) {
+        std::this_thread::sleep_for(delay);
+    }
+
+    std::scoped_lock lock(mutex_);
+    if (fail) {
+        ++injected_failures_;
+        throw utils::errors::DatabaseError(
+            utils::format("Injected failure on fake sink write #{}", write_calls_),
+            utils::errors::Component::Database
+        );
+    }
+
+    documents_written_ += batch.record_count;
+    if (options_.keep_documents) {
+        documents_.insert(documents_.end(), batch.documents.begin(), batch.documents.end());
+    }
+    return batch.record_count;
+}
+
+std::uint64_t FakeSink::documents_written() const
+{
+    std::scoped_lock lock(mutex_);
+    return documents_written_;
+}
+
+std::uint64_t FakeSink::write_calls() const
+{
+    std::scoped_lock lock(mutex_);
+    return write_calls_;
+}
+
+std::uint64_t FakeSink::injected_failures() const
+{
+    std::scoped_lock lock(mutex_);
+    return injected_failures_;
+}
+
+Documents FakeSink::documents() const
+{
+    std::scoped_lock lock(mutex_);
+    return documents_;
+}
+
+} // namespace vcf_tool::domain::sink
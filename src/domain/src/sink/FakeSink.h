@@ -0,0 +1,54 @@
+// FakeSink.h
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <random>
+
+#include <vcf_tool/domain/VcfTool.h>
+#include "RecordSink.h"
+#include "../header/VcfDictionary.h"
+
+
+namespace vcf_tool::domain::sink {
+
+using api::FakeSinkOptions;
+
+/**
+ * @brief In-process stand-in for the database
+ *
+ * Encodes batches exactly like MongoSink (so encode cost is real), then
+ * simulates the insert: sleeps for the configured latency (plus uniform
+ * jitter) and fails a configurable fraction of writes with DatabaseError.
+ * Failures are drawn from a seeded RNG, so runs are reproducible.
+ *
+ * Documents are only kept when `keep_documents` is set (unit tests); large
+ * runs just count them. The dictionary must outlive the sink.
+ */
+class FakeSink final : public RecordSink {
+public:
+    explicit FakeSink(const header::VcfDictionary& dictionary, FakeSinkOptions options = {});
+
+    EncodedBatch encode(std::span<const entity::ParsedRecord> records) override;
+    std::size_t write(const EncodedBatch& batch) override;
+    std::string_view name() const override { return "fake"; }
+
+    // Inspection (safe to call from any thread)
+    std::uint64_t documents_written() const;
+    std::uint64_t write_calls() const;
+    std::uint64_t injected_failures() const;
+    Documents documents() const;
+
+private:
+    const header::VcfDictionary& dictionary_;
+    FakeSinkOptions options_;
+
+    mutable std::mutex mutex_;
+    std::mt19937_64 rng_;
+    Documents documents_;
+    std::uint64_t documents_written_{0};
+    std::uint64_t write_calls_{0};
+    std::uint64_t injected_failures_{0};
+};
+
+} // namespace vcf_tool::domain::sink
@@ -0,0 +1,28 @@
+// MongoSink.cpp
+#include "MongoSink.h"
+
+
+namespace vcf_tool::domain::sink {
+
+MongoSink::MongoSink(const header::VcfDictionary& dictionary, const std::string& collection)
+    : MongoSink(dictionary, std::make_unique<dao::VcfDao>(collection))
+{
+}
+
+MongoSink::MongoSink(const header::VcfDictionary& dictionary, std::unique_ptr<dao::VcfDao> dao)
+    : dictionary_(dictionary)
+    , dao_(std::move(dao))
+{
+}
+
+EncodedBatch MongoSink::encode(std::span<const entity::ParsedRecord> records)
+{
+    return EncodedBatch{records.size(), dao::VcfDao::encode(records, dictionary_)};
+}
+
+std::size_t MongoSink::write(const EncodedBatch& batch)
+{
+    return dao_->insert_encoded(batch.documents);
+}
+
+} // namespace vcf_tool::domain::sink
@@ -0,0 +1,33 @@
+// MongoSink.h
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "RecordSink.h"
+#include "../dao/VcfDao.h"
+
+
+namespace vcf_tool::domain::sink {
+
+/**
+ * @brief RecordSink backed by MongoDB (via VcfDao)
+ *
+ * Requires core::MongoDatabase to be initialized. Writes to `collection`
+ * (empty = the configured one). The dictionary must outlive the sink.
+ */
+class MongoSink final : public RecordSink {
+public:
+    explicit MongoSink(const header::VcfDictionary& dictionary, const std::string& collection = {});
+    MongoSink(const header::VcfDictionary& dictionary, std::unique_ptr<dao::VcfDao> dao);
+
+    EncodedBatch encode(std::span<const entity::ParsedRecord> records) override;
+    std::size_t write(const EncodedBatch& batch) override;
+    std::string_view name() const override { return "mongo"; }
+
+private:
+    const header::VcfDictionary& dictionary_;
+    std::unique_ptr<dao::VcfDao> dao_;
+};
+
+} // namespace vcf_tool::domain::sink
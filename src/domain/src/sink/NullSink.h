@@ -0,0 +1,26 @@
+// NullSink.h
+#pragma once
+
+#include "RecordSink.h"
+
+
+namespace vcf_tool::domain::sink {
+
+/**
+ * @brief RecordSink that discards everything (parse-only / --dry-run)
+ *
+ * Skips encoding as well, so a run measures reader and parser throughput
+ * alone.
+ */
+class NullSink final : public RecordSink {
+public:
+    EncodedBatch encode(std::span<const entity::ParsedRecord> records) override {
+        return EncodedBatch{records.size(), {}};
+    }
+
+    std::size_t write(const EncodedBatch& batch) override { return batch.record_count; }
+
+    std::string_view name() const override { return "null"; }
+};
+
+} // namespace vcf_tool::domain::sink
@@ -0,0 +1,66 @@
+// RecordSink.h
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <bsoncxx/document/value.hpp>
+
+#include "../entity/ParsedRecord.h"
+
+
+namespace vcf_tool::domain::sink {
+
+using Documents = std::vector<bsoncxx::document::value>;
+
+/**
+ * @brief A batch converted to the sink's wire format
+ *
+ * `record_count` is the number of input records; `documents` may be empty
+ * for sinks that do not need an encoded form (e.g. NullSink).
+ */
+struct EncodedBatch {
+    std::size_t record_count{0};
+    Documents documents;
+};
+
+/**
+ * @brief Destination of parsed records (database, fake, or nothing)
+ *
+ * The writer drives a sink in two steps so encode and write latency can
+ * be measured separately:
+ *   auto encoded = sink.encode(batch);
+ *   auto written = sink.write(encoded);
+ *
+ * write() throws DatabaseError for transient failures (the writer retries
+ * the same EncodedBatch with backoff) and returns fewer than
+ * `record_count` for a permanent partial failure (not retried, since
+ * part of the batch may already be stored).
+ *
+ * Thread Safety:
+ *   - encode() must be safe to call concurrently on disjoint slices (the
+ *     writer may encode a large batch in parallel)
+ *   - write() is only called from the DbWriterWorker thread
+ */
+class RecordSink {
+public:
+    virtual ~RecordSink() = default;
+
+    /// Convert a batch (or a slice of one) to the sink's wire format
+    virtual EncodedBatch encode(std::span<const entity::ParsedRecord> records) = 0;
+
+    /**
+     * Store an encoded batch.
+     *
+     * @return Number of records stored
+     * @throws DatabaseError on transient failure
+     */
+    virtual std::size_t write(const EncodedBatch& batch) = 0;
+
+    /// Short name for logs ("mongo", "null", "fake")
+    virtual std::string_view name() const = 0;
+};
+
+} // namespace vcf_tool::domain::sink
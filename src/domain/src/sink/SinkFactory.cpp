@@ -0,0 +1,26 @@
+// SinkFactory.cpp
+#include "SinkFactory.h"
+
+#include "MongoSink.h"
+#include "NullSink.h"
+#include "FakeSink.h"
+
+
+namespace vcf_tool::domain::sink {
+
+std::unique_ptr<RecordSink> make_sink(api::SinkType type, const api::FakeSinkOptions& fake_options,
+                                      const header::VcfDictionary& dictionary,
+                                      const std::string& collection)
+{
+    switch (type) {
+        case api::SinkType::Null:
+            return std::make_unique<NullSink>();
+        case api::SinkType::Fake:
+            return std::make_unique<FakeSink>(dictionary, fake_options);
+        case api::SinkType::Mongo:
+            break;
+    }
+    return std::make_unique<MongoSink>(dictionary, collection);
+}
+
+} // namespace vcf_tool::domain::sink
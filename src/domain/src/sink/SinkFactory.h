@@ -0,0 +1,26 @@
+// SinkFactory.h
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <vcf_tool/domain/VcfTool.h>
+#include "RecordSink.h"
+#include "../header/VcfDictionary.h"
+
+
+namespace vcf_tool::domain::sink {
+
+/**
+ * Create the sink selected in the configuration.
+ *
+ * `dictionary` resolves the records' string IDs; it must outlive the sink.
+ * `collection` is the MongoDB collection (empty = the configured one).
+ *
+ * @throws DatabaseError for SinkType::Mongo if MongoDatabase is not initialized
+ */
+std::unique_ptr<RecordSink> make_sink(api::SinkType type, const api::FakeSinkOptions& fake_options,
+                                      const header::VcfDictionary& dictionary,
+                                      const std::string& collection = {});
+
+} // namespace vcf_tool::domain::sink
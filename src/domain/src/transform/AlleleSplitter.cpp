@@ -0,0 +1,316 @@
+// AlleleSplitter.cpp
+#include "AlleleSplitter.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include "../parser/VcfLineParser.h"
+
+
+namespace vcf_tool::domain::transform {
+
+using header::ValueShape;
+
+namespace {
+
+// Values one part keeps of a Number=A/R/G list, by ascending index into the list
+struct Picks {
+    std::array<std::uint32_t, 3> index{};
+    std::uint32_t count{0};
+};
+
+// Index of genotype a/b (a <= b) in a diploid Number=G list
+constexpr std::uint32_t genotype_index(std::uint32_t a, std::uint32_t b)
+{
+    return b * (b + 1) / 2 + a;
+}
+
+bool per_allele(ValueShape::Count count)
+{
+    return count == ValueShape::Count::PerAlt || count == ValueShape::Count::PerAllele
+        || count == ValueShape::Count::PerGenotype;
+}
+
+Picks picks(ValueShape::Count count, std::uint32_t alt, bool haploid)
+{
+    if (count == ValueShape::Count::PerAlt) {
+        return Picks{.index = {alt - 1, 0, 0}, .count = 1};
+    }
+    if (count == ValueShape::Count::PerAllele || haploid) {
+        return Picks{.index = {0, alt, 0}, .count = 2};
+    }
+    return Picks{.index = {genotype_index(0, 0), genotype_index(0, alt), genotype_index(alt, alt)}, .count = 3};
+}
+
+// Values a Number=A/R/G list has for `alt_count` ALT alleles
+std::uint32_t list_length(ValueShape::Count count, std::uint32_t alt_count, bool haploid)
+{
+    return ValueShape{.type = ValueShape::Type::String, .count = count, .fixed = 0}.width(alt_count, haploid ? 1 : 2);
+}
+
+// Values per sample of a subset typed FORMAT column
+std::uint32_t subset_width(ValueShape::Count count, std::uint32_t ploidy)
+{
+    if (count == ValueShape::Count::PerAlt) {
+        return 1;
+    }
+    return count == ValueShape::Count::PerGenotype && ploidy != 1 ? 3 : 2;
+}
+
+// Next `sep`-delimited token of `rest` (consumed from the front)
+std::string_view next_token(std::string_view& rest, char sep)
+{
+    const std::size_t pos = rest.find(sep);
+    const std::string_view token = rest.substr(0, pos);
+    rest = pos == std::string_view::npos ? std::string_view{} : rest.substr(pos + 1);
+    return token;
+}
+
+// The values part `alt` keeps of comma-separated `text`, std::nullopt if `text` is not a full list
+std::optional<std::string_view> pick_text(std::string_view text, ValueShape::Count count, std::uint32_t alt,
+                                          std::uint32_t alt_count, memory::ChunkArena& arena)
+{
+    const auto values = static_cast<std::uint32_t>(std::count(text.begin(), text.end(), ',')) + 1;
+    const bool haploid = count == ValueShape::Count::PerGenotype && values == alt_count + 1;
+    if (values != list_length(count, alt_count, haploid)) {
+        return std::nullopt;
+    }
+
+    const Picks p = picks(count, alt, haploid);
+    std::array<std::string_view, 3> tokens;
+    std::size_t bytes = p.count - 1;  // Commas
+    std::string_view rest = text;
+    for (std::uint32_t i = 0, found = 0; found < p.count; ++i) {
+        const auto token = next_token(rest, ',');
+        if (i == p.index[found]) {
+            tokens[found++] = token;
+            bytes += token.size();
+        }
+    }
+    if (p.count == 1) {
+        return tokens[0];
+    }
+
+    auto out = arena.allocate<char>(bytes);
+    char* w = out.data();
+    for (std::uint32_t i = 0; i < p.count; ++i) {
+        if (i > 0) {
+            *w++ = ',';
+        }
+        std::memcpy(w, tokens[i].data(), tokens[i].size());
+        w += tokens[i].size();
+    }
+    return std::string_view(out.data(), out.size());
+}
+
+// Same typing as the parser: a number if the whole text is one
+FieldValue value_of(std::string_view text)
+{
+    if (auto number = VcfLineParser::try_parse_double(text)) {
+        return FieldValue{.kind = FieldValue::Kind::Number, .number = *number, .text = {}};
+    }
+    return FieldValue{.kind = FieldValue::Kind::String, .number = 0.0, .text = text};
+}
+
+bool is_end(std::int32_t value)
+{
+    return value == kEndInt;
+}
+
+bool is_end(float value)
+{
+    return std::bit_cast<std::uint32_t>(value) == kEndFloatBits;
+}
+
+// Typed column values of part `alt`: `out_width` per sample, padded with `end`
+template<typename T>
+std::span<const T> subset_values(std::span<const T> values, std::uint32_t width, std::uint32_t sample_count,
+                                 ValueShape::Count count, std::uint32_t alt, std::uint32_t alt_count,
+                                 std::uint32_t out_width, T missing, T end, memory::ChunkArena& arena)
+{
+    auto out = arena.allocate<T>(std::size_t{sample_count} * out_width);
+    for (std::uint32_t s = 0; s < sample_count; ++s) {
+        const auto sample = values.subspan(std::size_t{s} * width, width);
+        std::uint32_t length = 0;
+        while (length < width && !is_end(sample[length])) {
+            ++length;
+        }
+        const bool haploid = count == ValueShape::Count::PerGenotype && length == alt_count + 1;
+
+        T* w = out.data() + std::size_t{s} * out_width;
+        std::uint32_t written = 0;
+        if (length == list_length(count, alt_count, haploid)) {
+            const Picks p = picks(count, alt, haploid);
+            for (; written < p.count; ++written) {
+                w[written] = sample[p.index[written]];
+            }
+        } else {
+            w[written++] = missing;  // "." or a list of the wrong length
+        }
+        std::fill(w + written, w + out_width, end);
+    }
+    return out;
+}
+
+} // namespace
+
+void AlleleSplitter::split(entity::ParsedRecord record, std::vector<entity::ParsedRecord>& out) const
+{
+    const auto& data = record.vcf_data;
+    const auto alt_count = data.alt == "."
+        ? 0u
+        : static_cast<std::uint32_t>(std::count(data.alt.begin(), data.alt.end(), ',')) + 1;
+    if (alt_count < 2 || !record.arena || !data.decoded()) {
+        if (trim(record.vcf_data) && trimmed_records_) {
+            trimmed_records_->add();
+        }
+        out.push_back(std::move(record));
+        return;
+    }
+
+    auto& arena = *record.arena;
+    std::string_view alts = data.alt;
+    for (std::uint32_t alt = 1; alt <= alt_count; ++alt) {
+        entity::ParsedRecord part = record;
+        part.vcf_data.alt = next_token(alts, ',');
+        part.vcf_data.info = subset_info(data, alt, alt_count, arena);
+        part.vcf_data.samples = subset_samples(data.samples, alt, alt_count, arena);
+        part.commits_line = record.commits_line && alt == alt_count;
+        if (trim(part.vcf_data) && trimmed_records_) {
+            trimmed_records_->add();
+        }
+        out.push_back(std::move(part));
+    }
+    if (split_records_) {
+        split_records_->add();
+    }
+}
+
+bool AlleleSplitter::trim(VcfRecord& record)
+{
+    // Plain bases only: symbolic, breakend, "*" and "." alleles have no shared bases to drop
+    constexpr std::string_view kBases = "ACGTNacgtn";
+    std::string_view ref = record.ref;
+    std::string_view alt = record.alt;
+    if (ref.empty() || alt.empty() || ref.find_first_not_of(kBases) != std::string_view::npos
+        || alt.find_first_not_of(kBases) != std::string_view::npos) {
+        return false;
+    }
+
+    std::size_t suffix = 0;
+    while (suffix + 1 < ref.size() && suffix + 1 < alt.size()
+           && ref[ref.size() - 1 - suffix] == alt[alt.size() - 1 - suffix]) {
+        ++suffix;
+    }
+    ref.remove_suffix(suffix);
+    alt.remove_suffix(suffix);
+
+    std::size_t prefix = 0;
+    while (prefix + 1 < ref.size() && prefix + 1 < alt.size() && ref[prefix] == alt[prefix]) {
+        ++prefix;
+    }
+    if (suffix == 0 && prefix == 0) {
+        return false;
+    }
+
+    record.ref = ref.substr(prefix);
+    record.alt = alt.substr(prefix);
+    record.position += prefix;
+    return true;
+}
+
+std::span<const Field> AlleleSplitter::subset_info(const VcfRecord& record, std::uint32_t alt,
+                                                   std::uint32_t alt_count, memory::ChunkArena& arena) const
+{
+    const auto has_list = [this](const Field& field) {
+        return per_allele(dictionary_->info_shape(field.key).count);
+    };
+    if (std::none_of(record.info.begin(), record.info.end(), has_list)) {
+        return record.info;  // Shared by all parts
+    }
+
+    auto fields = arena.allocate<Field>(record.info.size());
+    for (std::size_t i = 0; i < record.info.size(); ++i) {
+        Field field = record.info[i];
+        if (field.value.kind == FieldValue::Kind::String && has_list(field)) {
+            const auto count = dictionary_->info_shape(field.key).count;
+            if (auto text = pick_text(field.value.text, count, alt, alt_count, arena)) {
+                field.value = value_of(*text);
+            }
+        }
+        fields[i] = field;
+    }
+    return fields;
+}
+
+GenotypeMatrix AlleleSplitter::subset_samples(const GenotypeMatrix& samples, std::uint32_t alt,
+                                              std::uint32_t alt_count, memory::ChunkArena& arena) const
+{
+    GenotypeMatrix result = samples;
+    if (samples.sample_count == 0) {
+        return result;
+    }
+
+    // GT: ALT `alt` becomes allele 1, the other ALT alleles the reference
+    if (!samples.genotypes.empty()) {
+        auto genotypes = arena.allocate<std::uint8_t>(samples.genotypes.size());
+        for (std::size_t i = 0; i < genotypes.size(); ++i) {
+            const std::uint8_t gt = samples.genotypes[i];
+            if (gt == 0 || gt == kGtEnd) {
+                genotypes[i] = gt;
+                continue;
+            }
+            const std::uint32_t allele = (gt >> 1) - 1u;
+            const std::uint32_t recoded = allele == alt ? 1u : 0u;
+            genotypes[i] = static_cast<std::uint8_t>(((recoded + 1) << 1) | (gt & 1u));
+        }
+        result.genotypes = genotypes;
+    }
+
+    const auto has_list = [this](const FormatColumn& column) {
+        return per_allele(dictionary_->format_shape(column.key).count);
+    };
+    if (std::none_of(samples.columns.begin(), samples.columns.end(), has_list)) {
+        return result;
+    }
+
+    auto columns = arena.allocate<FormatColumn>(samples.columns.size());
+    for (std::size_t i = 0; i < samples.columns.size(); ++i) {
+        FormatColumn column = samples.columns[i];
+        if (has_list(column)) {
+            const auto count = dictionary_->format_shape(column.key).count;
+            const std::uint32_t width = subset_width(count, samples.ploidy);
+            switch (column.type) {
+                case FormatColumn::Type::Integer:
+                    column.integers = subset_values(column.integers, column.width, samples.sample_count, count,
+                                                    alt, alt_count, width, kMissingInt, kEndInt, arena);
+                    column.width = width;
+                    break;
+                case FormatColumn::Type::Float:
+                    column.floats = subset_values(column.floats, column.width, samples.sample_count, count,
+                                                  alt, alt_count, width, kMissingFloat, kEndFloat, arena);
+                    column.width = width;
+                    break;
+                case FormatColumn::Type::String: {
+                    auto strings = arena.allocate<std::string_view>(column.strings.size());
+                    for (std::size_t s = 0; s < strings.size(); ++s) {
+                        const auto text = column.strings[s];
+                        strings[s] = text.empty() ? text : pick_text(text, count, alt, alt_count, arena).value_or(text);
+                    }
+                    column.strings = strings;
+                    break;
+                }
+            }
+        }
+        columns[i] = column;
+    }
+    result.columns = columns;
+    return result;
+}
+
+} // namespace vcf_tool::domain::transform
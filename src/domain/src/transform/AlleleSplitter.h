@@ -0,0 +1,76 @@
+// AlleleSplitter.h
+#pragma once
+
+#include <vector>
+
+#include <vcf_tool/core/Metrics.h>
+
+#include "../entity/ParsedRecord.h"
+#include "../entity/VcfRecord.h"
+#include "../header/VcfDictionary.h"
+
+
+namespace vcf_tool::domain::transform {
+
+/**
+ * @brief Splits multiallelic records into biallelic ones and trims their alleles
+ *
+ * Runs in the parser threads on decoded records, so splitting costs no
+ * extra pass over the input. A record with n ALT alleles becomes n
+ * records, the i-th keeping ALT i only:
+ *   - INFO / FORMAT values declared Number=A keep value i, Number=R the
+ *     values of REF and ALT i, Number=G those of the genotypes made of REF
+ *     and ALT i (haploid or diploid); other values are shared unchanged
+ *   - GT alleles i become 1, the other ALT alleles 0 (reference)
+ *
+ * Every record (split or not) then has the bases its REF and ALT share
+ * trimmed, trailing first, keeping at least one base each; POS moves past
+ * the leading ones. Symbolic (<DEL>), breakend, "*" and "." alleles are
+ * left as they are.
+ *
+ * A list whose length does not fit the ALT count (or the ploidy) is kept
+ * whole in INFO and string FORMAT columns, and becomes missing in typed
+ * FORMAT columns.
+ *
+ * The parts share the input record's arena; subset lists and recoded GT
+ * are allocated from it, so split() must run on the thread owning that
+ * arena. Only the last part commits the line for checkpoints
+ * (ParsedRecord::commits_line).
+ *
+ * Thread Safety: stateless after construction; shared by all parser threads.
+ */
+class AlleleSplitter {
+public:
+    /**
+     * @param dictionary       Declared INFO / FORMAT shapes (Number=A/R/G)
+     * @param split_records    Optional: counts multiallelic records split
+     * @param trimmed_records  Optional: counts records whose alleles were trimmed
+     */
+    explicit AlleleSplitter(const header::VcfDictionary& dictionary,
+                            core::metrics::Counter* split_records = nullptr,
+                            core::metrics::Counter* trimmed_records = nullptr)
+        : dictionary_(&dictionary)
+        , split_records_(split_records)
+        , trimmed_records_(trimmed_records)
+    {
+    }
+
+    /// Append the biallelic parts of decoded `record` to `out` (the record itself if it has one ALT)
+    void split(entity::ParsedRecord record, std::vector<entity::ParsedRecord>& out) const;
+
+    /// Trim the bases REF and ALT (a single allele) share; false if there were none
+    static bool trim(VcfRecord& record);
+
+private:
+    // `record`'s INFO / FORMAT reduced to ALT `alt` (1-based) of `alt_count`
+    std::span<const Field> subset_info(const VcfRecord& record, std::uint32_t alt, std::uint32_t alt_count,
+                                       memory::ChunkArena& arena) const;
+    GenotypeMatrix subset_samples(const GenotypeMatrix& samples, std::uint32_t alt, std::uint32_t alt_count,
+                                  memory::ChunkArena& arena) const;
+
+    const header::VcfDictionary* dictionary_;
+    core::metrics::Counter* split_records_;
+    core::metrics::Counter* trimmed_records_;
+};
+
+} // namespace vcf_tool::domain::transform
@@ -1,20 +1,48 @@
 // DbWriterWorker.cpp
 #include "DbWriterWorker.h"
 
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <span>
+
+#include <vcf_tool/core/Metrics.h>
+#include <vcf_tool/core/Tracer.h>
 #include <vcf_tool/utils/Logger.h>
 #include <vcf_tool/utils/Errors.h>
 
 
 namespace vcf_tool::domain::writer {
 
+using core::metrics::Stopwatch;
+using core::trace::Span;
+
+namespace {
+
+// Smallest slice worth handing to another thread
+constexpr std::size_t kMinEncodeSlice = 512;
+
+// How often a writer waiting on an empty queue checks for a stop request
+constexpr std::chrono::milliseconds kStopPollInterval{100};
+
+} // namespace
+
 DbWriterWorker::DbWriterWorker(RecordQueue& input_queue,
                                std::size_t batch_size,
                                std::size_t sentinel_count,
-                               std::unique_ptr<dao::VcfDao> dao)
+                               std::unique_ptr<sink::RecordSink> sink,
+                               metrics::PipelineMetrics& metrics,
+                               RetryPolicy retry,
+                               core::ThreadPool* encode_pool,
+                               std::unique_ptr<checkpoint::CheckpointTracker> checkpoint)
     : input_queue_(input_queue)
     , batch_size_(batch_size)
     , sentinel_count_(sentinel_count)
-    , dao_(std::move(dao))
+    , sink_(std::move(sink))
+    , metrics_(metrics)
+    , retry_(retry)
+    , encode_pool_(encode_pool)
+    , checkpoint_(std::move(checkpoint))
     , thread_([this](std::stop_token st) {
         run(st);
       })
@@ -35,8 +63,10 @@ void DbWriterWorker::request_stop()
     thread_.request_stop();
 }
 
-void DbWriterWorker::run([[maybe_unused]] std::stop_token st)
+void DbWriterWorker::run(std::stop_token st)
 {
+    core::trace::Tracer::instance().set_thread_name("writer");
+
     std::size_t sentinels_received = 0;
     std::size_t records_processed = 0;
     std::size_t records_skipped = 0;
@@ -44,7 +74,24 @@ void DbWriterWorker::run([[maybe_unused]] std::stop_token st)
 
     for (;;) {
         ParsedRecord record;
-        input_queue_.wait_dequeue(record);
+        Stopwatch wait;
+        Span wait_span("record_queue_wait", "writer", kMinTracedWaitNs);
+        const bool dequeued = input_queue_.wait_dequeue_timed(record, kStopPollInterval);
+        wait_span.end();
+        metrics_.writer_wait_ns.add(wait.elapsed_ns());
+        if (!dequeued) {
+            // Only an empty queue is abandoned: on a normal shutdown every
+            // sentinel is queued before the stop request, so nothing is lost
+            if (st.stop_requested()) {
+                LOG_WARN_F("DbWriterWorker: stopped after {}/{} sentinels, {} records not flushed",
+                           sentinels_received, sentinel_count_, batch_.size());
+                if (checkpoint_) {
+                    checkpoint_->persist();
+                }
+                break;
+            }
+            continue;
+        }
 
         // Check for sentinel (end-of-stream signal)
         if (record.is_end) {
@@ -55,9 +102,15 @@ void DbWriterWorker::run([[maybe_unused]] std::stop_token st)
                 // All parsers have finished, flush remaining records and exit
                 if (!batch_.empty()) {
                     LOG_DEBUG_F("Flushing final batch of {} records", batch_.size());
-                    flush_batch();
+                    checkpoint_batch(flush_batch());
                     ++batches_flushed;
                 }
+                if (checkpoint_) {
+                    checkpoint_->persist();
+                    LOG_INFO_F("DbWriterWorker: checkpoint at line {} (offset {})",
+                               checkpoint_->watermark().line_number,
+                               checkpoint_->watermark().byte_offset);
+                }
                 LOG_INFO_F("DbWriterWorker: processed {} records, skipped {} empty, flushed {} batches",
                           records_processed, records_skipped, batches_flushed);
                 break;
@@ -68,8 +121,12 @@ void DbWriterWorker::run([[maybe_unused]] std::stop_token st)
 
         // Skip empty/invalid records (e.g., header lines)
         // Valid VCF records always have a chromosome
-        if (record.vcf_data.chromosome.empty()) {
+        if (record.vcf_data.chromosome == kNoStringId) {
             ++records_skipped;
+            metrics_.records_skipped.add();
+            if (checkpoint_) {
+                checkpoint_->commit(record.line_number, record.end_offset);
+            }
             LOG_DEBUG_F("Skipping empty record at line {} (total skipped: {})",
                        record.line_number, records_skipped);
             continue;
@@ -83,7 +140,7 @@ void DbWriterWorker::run([[maybe_unused]] std::stop_token st)
         // Flush if batch is full
         if (batch_.size() >= batch_size_) {
             LOG_DEBUG_F("Batch full, flushing {} records (batch #{})", batch_.size(), batches_flushed + 1);
-            flush_batch();
+            checkpoint_batch(flush_batch());
             ++batches_flushed;
             batch_.clear();
             LOG_DEBUG_F("Batch cleared, continuing...");
@@ -91,26 +148,134 @@ void DbWriterWorker::run([[maybe_unused]] std::stop_token st)
     }
 }
 
-void DbWriterWorker::flush_batch()
+bool DbWriterWorker::flush_batch()
 {
     if (batch_.empty()) {
-        return;
+        return true;
     }
 
     try {
-        LOG_DEBUG_F("Flushing batch of {} records to MongoDB", batch_.size());
-        std::size_t inserted = dao_->bulk_insert(batch_);
+        LOG_DEBUG_F("Flushing batch of {} records to {} sink", batch_.size(), sink_->name());
+        metrics_.batches.add();
+
+        Stopwatch encode;
+        Span encode_span("encode_batch", "writer");
+        encode_span.set_arg(batch_.size());
+        auto encoded = encode_batch();
+        encode_span.end();
+        metrics_.encode_seconds.observe(encode.elapsed_ns());
+
+        std::size_t inserted = write_with_retry(encoded);
+        metrics_.records_written.add(inserted);
 
         if (inserted != batch_.size()) {
             LOG_WARN_F("Partial insert: {} of {} records written", inserted, batch_.size());
-        } else {
-            LOG_DEBUG_F("Successfully flushed {} records", inserted);
+            metrics_.failed_batches.add();
+            return false;
         }
 
+        LOG_DEBUG_F("Successfully flushed {} records", inserted);
+        return true;
+
     } catch (const utils::errors::DatabaseError& e) {
         LOG_ERROR_F("Database write failed: {}", e.what());
+        metrics_.failed_batches.add();
         // Log but don't throw - continue processing
+        return false;
+    }
+}
+
+sink::EncodedBatch DbWriterWorker::encode_batch()
+{
+    std::size_t slices = encode_pool_ ? encode_workers() : 1;
+    slices = std::min(slices, batch_.size() / kMinEncodeSlice);
+    if (slices <= 1) {
+        return sink_->encode(batch_);
+    }
+
+    // Contiguous slices keep the documents in batch order
+    const std::span<const ParsedRecord> records(batch_);
+    const std::size_t slice_size = (records.size() + slices - 1) / slices;
+
+    std::vector<std::future<sink::EncodedBatch>> futures;
+    futures.reserve(slices - 1);
+    for (std::size_t begin = slice_size; begin < records.size(); begin += slice_size) {
+        auto slice = records.subspan(begin, std::min(slice_size, records.size() - begin));
+        futures.push_back(encode_pool_->submit([this, slice] { return sink_->encode(slice); }));
+    }
+
+    // Slices reference batch_, so every one must finish before we return or throw
+    sink::EncodedBatch encoded;
+    try {
+        encoded = sink_->encode(records.first(slice_size));
+    } catch (...) {
+        for (auto& future : futures) {
+            future.wait();
+        }
+        throw;
+    }
+    for (auto& future : futures) {
+        future.wait();
+    }
+
+    encoded.documents.reserve(records.size());
+    for (auto& future : futures) {
+        auto part = future.get();
+        encoded.record_count += part.record_count;
+        std::move(part.documents.begin(), part.documents.end(), std::back_inserter(encoded.documents));
+    }
+    return encoded;
+}
+
+std::size_t DbWriterWorker::write_with_retry(const sink::EncodedBatch& encoded)
+{
+    std::chrono::milliseconds backoff = retry_.backoff;
+
+    for (std::size_t attempt = 0;; ++attempt) {
+        try {
+            Stopwatch insert;
+            Span insert_span("insert_many", "writer");
+            insert_span.set_arg(encoded.record_count);
+            std::size_t inserted = sink_->write(encoded);
+            insert_span.end();
+            metrics_.insert_seconds.observe(insert.elapsed_ns());
+            return inserted;
+
+        } catch (const utils::errors::DatabaseError& e) {
+            if (attempt >= retry_.max_retries) {
+                throw;
+            }
+            metrics_.retries.add();
+            LOG_WARN_F("Batch write failed (attempt {}/{}), retrying in {} ms: {}",
+                       attempt + 1, retry_.max_retries + 1, backoff.count(), e.what());
+            std::this_thread::sleep_for(backoff);
+            backoff = std::min(backoff * 2, std::chrono::milliseconds(30'000));
+        }
+    }
+}
+
+void DbWriterWorker::checkpoint_batch(bool written)
+{
+    if (!checkpoint_) {
+        return;
+    }
+
+    if (!written) {
+        // Unordered bulk writes give no per-record outcome, so no line of
+        // the batch is committed, even by a part of it in a later batch
+        for (const auto& record : batch_) {
+            checkpoint_->stall(record.line_number);
+        }
+        return;
+    }
+
+    for (const auto& record : batch_) {
+        // A split line is committed by its last part (the others may be in an earlier batch)
+        if (record.commits_line) {
+            checkpoint_->commit(record.line_number, record.end_offset);
+        }
     }
+    checkpoint_->maybe_persist();
 }
 
 } // namespace vcf_tool::domain::writer
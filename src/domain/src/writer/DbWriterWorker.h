@@ -1,26 +1,62 @@
 // DbWriterWorker.h
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <thread>
 #include <stop_token>
 #include <vector>
 #include <memory>
 
+#include <vcf_tool/core/ThreadPool.h>
+
 #include "../Queues.h"
 #include "../entity/ParsedRecord.h"
-#include "../dao/VcfDao.h"
+#include "../sink/RecordSink.h"
+#include "../checkpoint/CheckpointTracker.h"
+#include "../metrics/PipelineMetrics.h"
 
 
 namespace vcf_tool::domain::writer {
 
 using entity::ParsedRecord;
 
+/**
+ * @brief How the writer retries a batch after a transient sink failure
+ *
+ * Attempt k (1-based) waits `backoff * 2^(k-1)` before retrying.
+ */
+struct RetryPolicy {
+    std::size_t max_retries{3};             // 0 = no retries
+    std::chrono::milliseconds backoff{100};  // Delay before the first retry
+};
+
 /**
  * @brief Database writer worker using jthread-based RAII pattern
  *
  * Continuously dequeues parsed records from input queue, accumulates them
- * into batches, and writes batches to database. Handles multiple sentinel
- * values for proper termination with N parsers.
+ * into batches, and writes batches to a RecordSink (MongoDB, null, or the
+ * in-process fake). Handles multiple sentinel values for proper termination
+ * with N parsers.
+ *
+ * A batch whose write throws DatabaseError is retried with exponential
+ * backoff (the encoded documents are reused). A partial write is not
+ * retried, since part of the batch may already be stored.
+ *
+ * With an encode pool, large batches are split into slices that are
+ * encoded concurrently (this thread takes the first slice). The number of
+ * slices is adjusted at runtime by the adaptive controller, which hands
+ * cores freed from parsing to encoding.
+ *
+ * When a CheckpointTracker is supplied, every line is reported to it once
+ * it is durable (batch flushed successfully, or record skipped), every
+ * line of a failed batch is reported as failed, and the checkpoint is
+ * persisted periodically and at end-of-stream.
+ *
+ * A stop request (request_stop(), or destruction) ends the worker once the
+ * queue is empty, even if sentinels are missing: a pipeline torn down after
+ * a failure does not wait for parsers that never reported. The records of
+ * the unfinished batch are not written.
  */
 class DbWriterWorker {
 public:
@@ -30,12 +66,20 @@ public:
      * @param input_queue     Queue from which to read parsed records.
      * @param batch_size      Number of records to accumulate before flushing.
      * @param sentinel_count  Number of sentinels to expect (one per parser).
-     * @param dao             Data access object for database operations.
+     * @param sink            Destination of the batches.
+     * @param metrics         Pipeline metrics (encode / insert latency, counts, retries).
+     * @param retry           Retry policy for failed batch writes.
+     * @param encode_pool     Optional pool for parallel encoding (nullptr = encode inline).
+     * @param checkpoint      Optional checkpoint tracker (nullptr = disabled).
      */
     DbWriterWorker(RecordQueue& input_queue,
                    std::size_t batch_size,
                    std::size_t sentinel_count,
-                   std::unique_ptr<dao::VcfDao> dao);
+                   std::unique_ptr<sink::RecordSink> sink,
+                   metrics::PipelineMetrics& metrics,
+                   RetryPolicy retry,
+                   core::ThreadPool* encode_pool,
+                   std::unique_ptr<checkpoint::CheckpointTracker> checkpoint = nullptr);
 
     // Non-copyable, non-movable
     DbWriterWorker(const DbWriterWorker&) = delete;
@@ -46,19 +90,40 @@ public:
     /// Request the worker to stop (optional, std::jthread also requests stop in dtor)
     void request_stop();
 
+    /// Underlying thread handle (for CPU pinning)
+    std::jthread::native_handle_type native_handle() { return thread_.native_handle(); }
+
+    /// Number of threads (including this one) that encode a batch; needs an encode pool
+    void set_encode_workers(std::size_t n) { encode_workers_.store(n, std::memory_order_relaxed); }
+    std::size_t encode_workers() const { return encode_workers_.load(std::memory_order_relaxed); }
+
 private:
     // Thread entry point
     void run(std::stop_token st);
 
-    // Flush accumulated batch to database
-    void flush_batch();
+    // Flush accumulated batch to the sink; returns true if every record was written
+    bool flush_batch();
+
+    // Encode the current batch, in parallel slices when an encode pool is available
+    sink::EncodedBatch encode_batch();
+
+    // Write an encoded batch, retrying transient failures; returns records written
+    std::size_t write_with_retry(const sink::EncodedBatch& encoded);
+
+    // Report a flushed (or failed) batch to the checkpoint tracker
+    void checkpoint_batch(bool written);
 
     RecordQueue& input_queue_;
     std::size_t batch_size_;
     std::size_t sentinel_count_;
 
     std::vector<ParsedRecord> batch_;
-    std::unique_ptr<dao::VcfDao> dao_;
+    std::unique_ptr<sink::RecordSink> sink_;
+    metrics::PipelineMetrics& metrics_;
+    RetryPolicy retry_;
+    core::ThreadPool* encode_pool_;
+    std::atomic<std::size_t> encode_workers_{1};
+    std::unique_ptr<checkpoint::CheckpointTracker> checkpoint_;
     std::jthread thread_;
 };
 
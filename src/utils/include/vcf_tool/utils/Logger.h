@@ -1,9 +1,21 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <fmt/core.h>
 
+// Lowest level compiled into the binary (0 = trace ... 5 = critical).
+// Calls below it are removed entirely, arguments included. Debug builds
+// (VCF_DEBUG) keep everything; other builds strip trace and debug.
+#ifndef VCF_LOG_ACTIVE_LEVEL
+#  ifdef VCF_DEBUG
+#    define VCF_LOG_ACTIVE_LEVEL 0
+#  else
+#    define VCF_LOG_ACTIVE_LEVEL 2
+#  endif
+#endif
+
 namespace vcf_tool {
 namespace utils {
 
@@ -18,14 +30,27 @@ public:
         Critical
     };
 
+    /// True if messages at `level` are compiled in (see VCF_LOG_ACTIVE_LEVEL)
+    static constexpr bool compiled(Level level) noexcept {
+        return static_cast<int>(level) >= VCF_LOG_ACTIVE_LEVEL;
+    }
+
+    /// Inline runtime level check - lets macros skip formatting entirely
+    static bool should_log(Level level) noexcept {
+        return static_cast<int>(level) >= runtime_level_.load(std::memory_order_relaxed);
+    }
+
     /// Get singleton instance (already has a minimal default configuration)
     static Logger& instance();
 
     /// Initialize / reconfigure logging (call early at startup).
     /// If log_file_path is empty => only console logging.
     /// If non-empty => console + rotating file sink.
+    /// If async => sinks are written by a background thread; when its queue
+    /// is full the oldest message is dropped, so callers never block on I/O.
     static void initialize(const std::string& log_file_path,
-                           Level level = Level::Info);
+                           Level level = Level::Info,
+                           bool async = false);
 
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
@@ -49,56 +74,85 @@ private:
 
     struct Impl;
     std::unique_ptr<Impl> impl_;
+
+    // Mirrors the spdlog logger level for the inline should_log() check
+    static inline std::atomic<int> runtime_level_{static_cast<int>(Level::Info)};
 };
 
 // ======= fmt-style helper functions (header-only, no spdlog) =======
 
 template <typename... Args>
 inline void log_trace(fmt::format_string<Args...> fmt_str, Args&&... args) {
-    Logger::instance().trace(fmt::format(fmt_str, std::forward<Args>(args)...));
+    if (Logger::should_log(Logger::Level::Trace)) {
+        Logger::instance().trace(fmt::format(fmt_str, std::forward<Args>(args)...));
+    }
 }
 
 template <typename... Args>
 inline void log_debug(fmt::format_string<Args...> fmt_str, Args&&... args) {
-    Logger::instance().debug(fmt::format(fmt_str, std::forward<Args>(args)...));
+    if (Logger::should_log(Logger::Level::Debug)) {
+        Logger::instance().debug(fmt::format(fmt_str, std::forward<Args>(args)...));
+    }
 }
 
 template <typename... Args>
 inline void log_info(fmt::format_string<Args...> fmt_str, Args&&... args) {
-    Logger::instance().info(fmt::format(fmt_str, std::forward<Args>(args)...));
+    if (Logger::should_log(Logger::Level::Info)) {
+        Logger::instance().info(fmt::format(fmt_str, std::forward<Args>(args)...));
+    }
 }
 
 template <typename... Args>
 inline void log_warn(fmt::format_string<Args...> fmt_str, Args&&... args) {
-    Logger::instance().warn(fmt::format(fmt_str, std::forward<Args>(args)...));
+    if (Logger::should_log(Logger::Level::Warn)) {
+        Logger::instance().warn(fmt::format(fmt_str, std::forward<Args>(args)...));
+    }
 }
 
 template <typename... Args>
 inline void log_error(fmt::format_string<Args...> fmt_str, Args&&... args) {
-    Logger::instance().error(fmt::format(fmt_str, std::forward<Args>(args)...));
+    if (Logger::should_log(Logger::Level::Error)) {
+        Logger::instance().error(fmt::format(fmt_str, std::forward<Args>(args)...));
+    }
 }
 
 template <typename... Args>
 inline void log_critical(fmt::format_string<Args...> fmt_str, Args&&... args) {
-    Logger::instance().critical(fmt::format(fmt_str, std::forward<Args>(args)...));
+    if (Logger::should_log(Logger::Level::Critical)) {
+        Logger::instance().critical(fmt::format(fmt_str, std::forward<Args>(args)...));
+    }
 }
 
 } // namespace utils
 } // namespace vcf_tool
 
 // ======= Convenience macros =======
+// Every macro checks the level before evaluating its arguments, so a
+// disabled LOG_DEBUG_F costs one relaxed load and a branch (no formatting,
+// no allocation). Levels below VCF_LOG_ACTIVE_LEVEL compile to nothing.
+#define VCF_LOG_AT_(level, call)                                                \
+    do {                                                                        \
+        if constexpr (::vcf_tool::utils::Logger::compiled(level)) {             \
+            if (::vcf_tool::utils::Logger::should_log(level)) {                 \
+                call;                                                           \
+            }                                                                   \
+        }                                                                       \
+    } while (0)
+
+#define VCF_LOG_LEVEL_(name) ::vcf_tool::utils::Logger::Level::name
+
 // Plain string macros
-#define LOG_TRACE(msg)    ::vcf_tool::utils::Logger::instance().trace(msg)
-#define LOG_DEBUG(msg)    ::vcf_tool::utils::Logger::instance().debug(msg)
-#define LOG_INFO(msg)     ::vcf_tool::utils::Logger::instance().info(msg)
-#define LOG_WARN(msg)     ::vcf_tool::utils::Logger::instance().warn(msg)
-#define LOG_ERROR(msg)    ::vcf_tool::utils::Logger::instance().error(msg)
-#define LOG_CRITICAL(msg) ::vcf_tool::utils::Logger::instance().critical(msg)
+#define LOG_TRACE(msg)    VCF_LOG_AT_(VCF_LOG_LEVEL_(Trace),    ::vcf_tool::utils::Logger::instance().trace(msg))
+#define LOG_DEBUG(msg)    VCF_LOG_AT_(VCF_LOG_LEVEL_(Debug),    ::vcf_tool::utils::Logger::instance().debug(msg))
+#define LOG_INFO(msg)     VCF_LOG_AT_(VCF_LOG_LEVEL_(Info),     ::vcf_tool::utils::Logger::instance().info(msg))
+#define LOG_WARN(msg)     VCF_LOG_AT_(VCF_LOG_LEVEL_(Warn),     ::vcf_tool::utils::Logger::instance().warn(msg))
+#define LOG_ERROR(msg)    VCF_LOG_AT_(VCF_LOG_LEVEL_(Error),    ::vcf_tool::utils::Logger::instance().error(msg))
+#define LOG_CRITICAL(msg) VCF_LOG_AT_(VCF_LOG_LEVEL_(Critical), ::vcf_tool::utils::Logger::instance().critical(msg))
 
 // fmt-style macros using {} placeholders
-#define LOG_TRACE_F(fmt_str, ...) ::vcf_tool::utils::log_trace(fmt_str, ##__VA_ARGS__)
-#define LOG_DEBUG_F(fmt_str, ...) ::vcf_tool::utils::log_debug(fmt_str, ##__VA_ARGS__)
-#define LOG_INFO_F(fmt_str, ...)  ::vcf_tool::utils::log_info(fmt_str,  ##__VA_ARGS__)
-#define LOG_WARN_F(fmt_str, ...)  ::vcf_tool::utils::log_warn(fmt_str,  ##__VA_ARGS__)
-#define LOG_ERROR_F(fmt_str, ...) ::vcf_tool::utils::log_error(fmt_str, ##__VA_ARGS__)
-#define LOG_CRIT_F(fmt_str, ...)  ::vcf_tool::utils::log_critical(fmt_str, ##__VA_ARGS__)
+#define LOG_TRACE_F(fmt_str, ...) VCF_LOG_AT_(VCF_LOG_LEVEL_(Trace),    ::vcf_tool::utils::log_trace(fmt_str, ##__VA_ARGS__))
+#define LOG_DEBUG_F(fmt_str, ...) VCF_LOG_AT_(VCF_LOG_LEVEL_(Debug),    ::vcf_tool::utils::log_debug(fmt_str, ##__VA_ARGS__))
+#define LOG_INFO_F(fmt_str, ...)  VCF_LOG_AT_(VCF_LOG_LEVEL_(Info),     ::vcf_tool::utils::log_info(fmt_str,  ##__VA_ARGS__))
+#define LOG_WARN_F(fmt_str, ...)  VCF_LOG_AT_(VCF_LOG_LEVEL_(Warn),     ::vcf_tool::utils::log_warn(fmt_str,  ##__VA_ARGS__))
+#define LOG_ERROR_F(fmt_str, ...) VCF_LOG_AT_(VCF_LOG_LEVEL_(Error),    ::vcf_tool::utils::log_error(fmt_str, ##__VA_ARGS__))
+#define LOG_CRIT_F(fmt_str, ...)  VCF_LOG_AT_(VCF_LOG_LEVEL_(Critical), ::vcf_tool::utils::log_critical(fmt_str, ##__VA_ARGS__))
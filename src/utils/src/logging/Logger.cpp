@@ -1,6 +1,7 @@
 #include <vcf_tool/utils/Logger.h>
 
 #include <spdlog/spdlog.h>
+#include <spdlog/async.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/rotating_file_sink.h>
 #include <vector>
@@ -41,6 +42,7 @@ Logger::Logger()
 }
 
 Logger::~Logger() {
+    impl_->logger->flush();
     spdlog::drop("vcf_tool");
 }
 
@@ -49,7 +51,7 @@ Logger& Logger::instance() {
     return inst;
 }
 
-void Logger::initialize(const std::string& log_file_path, Level level) {
+void Logger::initialize(const std::string& log_file_path, Level level, bool async) {
     auto& inst = instance(); // ensures singleton is constructed
 
     std::vector<spdlog::sink_ptr> sinks;
@@ -71,7 +73,18 @@ void Logger::initialize(const std::string& log_file_path, Level level) {
     }
 
     // Create a new logger with the chosen sinks
-    auto new_logger = std::make_shared<spdlog::logger>("vcf_tool", sinks.begin(), sinks.end());
+    std::shared_ptr<spdlog::logger> new_logger;
+    if (async) {
+        // Single background thread owns all sink I/O; overrun_oldest drops
+        // the oldest queued message instead of blocking the caller
+        spdlog::init_thread_pool(8192, 1);
+        new_logger = std::make_shared<spdlog::async_logger>(
+            "vcf_tool", sinks.begin(), sinks.end(),
+            spdlog::thread_pool(),
+            spdlog::async_overflow_policy::overrun_oldest);
+    } else {
+        new_logger = std::make_shared<spdlog::logger>("vcf_tool", sinks.begin(), sinks.end());
+    }
 
     // Optional: if you want global default level/pattern for spdlog as well
     // spdlog::set_default_logger(new_logger);
@@ -83,10 +96,12 @@ void Logger::initialize(const std::string& log_file_path, Level level) {
     spdlog::drop("vcf_tool"); // drop old one if present
     spdlog::register_logger(new_logger);
     inst.impl_->logger = std::move(new_logger);
+    runtime_level_.store(static_cast<int>(level), std::memory_order_relaxed);
 }
 
 void Logger::set_level(Level level) {
     impl_->logger->set_level(to_spdlog_level(level));
+    runtime_level_.store(static_cast<int>(level), std::memory_order_relaxed);
 }
 
 void Logger::trace(const std::string& message)    { impl_->logger->trace(message); }
@@ -0,0 +1,301 @@
+// throughput_regression.cpp - end-to-end pipeline throughput check
+//
+// Runs the full Pipeline (reader -> parsers -> writer) over a generated VCF
+// into a non-Mongo sink with one VcfToolBuilder preset, reports throughput,
+// peak RSS and per-stage utilization, and fails if records/sec dropped more
+// than --max-regression percent below the stored baseline for that preset.
+//
+// One preset per process, so ru_maxrss is the peak of that preset alone.
+// Exit codes: 0 pass, 1 regression, 2 error, 3 no baseline for the preset
+// (a gate without a baseline could never fail, so that fails too).
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <sys/resource.h>
+
+#include <CLI/CLI.hpp>
+#include <vcf_tool/utils/Json.h>
+#include <vcf_tool/utils/Logger.h>
+#include <vcf_tool/utils/Format.h>
+#include <vcf_tool/domain/VcfTool.h>
+#include <vcf_tool/domain/VcfToolBuilder.h>
+
+
+namespace {
+
+namespace fs = std::filesystem;
+using vcf_tool::domain::api::VcfToolBuilder;
+using vcf_tool::utils::Json;
+using JsonValue = vcf_tool::utils::Json::JsonValue;
+
+constexpr int kExitPass = 0;
+constexpr int kExitRegression = 1;
+constexpr int kExitError = 2;
+constexpr int kExitNoBaseline = 3;
+
+struct Options {
+    std::string input;
+    std::string preset = "defaults";
+    std::string sink = "fake";
+    std::string baseline;
+    std::string report;
+    double max_regression_pct = 15.0;
+    bool update_baseline = false;
+    std::string program;  // argv[0], to print the command recording a baseline
+};
+
+struct Result {
+    double seconds{0.0};
+    std::uint64_t input_bytes{0};
+    std::uint64_t records{0};
+    double records_per_sec{0.0};
+    double mb_per_sec{0.0};
+    double peak_rss_mb{0.0};
+    double reader_utilization{0.0};
+    double parser_utilization{0.0};
+    double writer_utilization{0.0};
+    std::size_t parser_count{0};
+};
+
+VcfToolBuilder make_builder(const std::string& preset)
+{
+    if (preset == "for_large_files") {
+        return VcfToolBuilder::for_large_files();
+    }
+    if (preset == "for_low_memory") {
+        return VcfToolBuilder::for_low_memory();
+    }
+    return VcfToolBuilder();
+}
+
+double peak_rss_mb()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;  // ru_maxrss is in KiB on Linux
+}
+
+Result run_preset(const Options& options)
+{
+    const std::string summary_path = options.report.empty()
+        ? options.input + "." + options.preset + ".metrics.json"
+        : options.report + ".metrics.json";
+
+    auto builder = make_builder(options.preset);
+    if (options.sink == "null") {
+        builder.with_dry_run();
+    } else {
+        builder.with_fake_sink();
+    }
+    builder.with_metrics_summary(summary_path);
+    auto tool = builder.build();
+
+    auto start = std::chrono::steady_clock::now();
+    tool.run(options.input);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    const auto metrics = Json::load_from_file(summary_path);
+    const auto& counters = metrics.at("counters");
+    const auto& histograms = metrics.at("histograms");
+
+    Result result;
+    result.seconds = elapsed.count();
+    result.parser_count = tool.parser_count();
+    result.input_bytes = fs::file_size(options.input);
+    result.records = counters.at("vcf_writer_records_total").get<std::uint64_t>();
+    result.records_per_sec = static_cast<double>(result.records) / result.seconds;
+    result.mb_per_sec = static_cast<double>(result.input_bytes) / (1024.0 * 1024.0) / result.seconds;
+    result.peak_rss_mb = peak_rss_mb();
+
+    // Busy time of each stage as a fraction of wall time (1.0 = saturated)
+    result.reader_utilization =
+        counters.at("vcf_reader_active_nanoseconds_total").get<double>() * 1e-9 / result.seconds;
+    result.parser_utilization =
+        histograms.at("vcf_parser_chunk_seconds").at("sum").get<double>()
+        / (result.seconds * static_cast<double>(result.parser_count));
+    result.writer_utilization =
+        (histograms.at("vcf_writer_encode_seconds").at("sum").get<double>()
+         + histograms.at("vcf_writer_insert_seconds").at("sum").get<double>())
+        / result.seconds;
+
+    return result;
+}
+
+JsonValue to_json(const Result& result)
+{
+    auto json = Json::object();
+    json["seconds"]            = result.seconds;
+    json["input_bytes"]        = result.input_bytes;
+    json["records"]            = result.records;
+    json["records_per_sec"]    = result.records_per_sec;
+    json["mb_per_sec"]         = result.mb_per_sec;
+    json["peak_rss_mb"]        = result.peak_rss_mb;
+    json["parser_count"]       = result.parser_count;
+    json["reader_utilization"] = result.reader_utilization;
+    json["parser_utilization"] = result.parser_utilization;
+    json["writer_utilization"] = result.writer_utilization;
+    return json;
+}
+
+void print(const Options& options, const Result& result)
+{
+    std::cout << vcf_tool::utils::format(
+        "preset {} ({} sink, {} parsers)\n"
+        "  records      {} in {:.2f} s\n"
+        "  throughput   {:.0f} rec/s, {:.1f} MB/s\n"
+        "  peak RSS     {:.1f} MB\n"
+        "  utilization  reader {:.0f}%, parsers {:.0f}%, writer {:.0f}%\n",
+        options.preset, options.sink, result.parser_count,
+        result.records, result.seconds,
+        result.records_per_sec, result.mb_per_sec,
+        result.peak_rss_mb,
+        result.reader_utilization * 100.0,
+        result.parser_utilization * 100.0,
+        result.writer_utilization * 100.0);
+}
+
+// CPU model and hardware threads, stored with a baseline: numbers from
+// another machine are not comparable
+std::string describe_machine()
+{
+    std::string model = "unknown CPU";
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    for (std::string line; std::getline(cpuinfo, line);) {
+        if (line.starts_with("model name")) {
+            if (auto colon = line.find(':'); colon != std::string::npos && colon + 2 <= line.size()) {
+                model = line.substr(colon + 2);
+            }
+            break;
+        }
+    }
+    return vcf_tool::utils::format("{}, {} threads", model, std::thread::hardware_concurrency());
+}
+
+JsonValue load_baseline(const std::string& path)
+{
+    if (path.empty() || !fs::exists(path)) {
+        auto json = Json::object();
+        json["presets"] = Json::object();
+        return json;
+    }
+    return Json::load_from_file(path);
+}
+
+// Exit code for the measured throughput against the preset's baseline
+int check_baseline(const Options& options, const Result& result, const JsonValue& baseline)
+{
+    const auto& presets = baseline.at("presets");
+    if (!presets.contains(options.preset)) {
+        std::cout << vcf_tool::utils::format(
+            "  FAILED: no baseline for preset {} in '{}'. Record one on the reference machine with\n"
+            "    {} --input {} --preset {} --sink {} --baseline {} --update-baseline\n"
+            "  and commit the baseline file.\n",
+            options.preset, options.baseline, options.program, options.input, options.preset,
+            options.sink, options.baseline.empty() ? "<baseline.json>" : options.baseline);
+        return kExitNoBaseline;
+    }
+
+    const auto& expected = presets.at(options.preset);
+    const double baseline_rps = expected.at("records_per_sec").get<double>();
+    const double change_pct = (result.records_per_sec / baseline_rps - 1.0) * 100.0;
+    std::cout << vcf_tool::utils::format("  baseline     {:.0f} rec/s ({:+.1f}%, allowed -{:.1f}%)\n",
+                                         baseline_rps, change_pct, options.max_regression_pct);
+
+    const auto machine = expected.value("machine", std::string{});
+    if (!machine.empty() && machine != describe_machine()) {
+        std::cout << vcf_tool::utils::format(
+            "  warning      baseline was recorded on {}, this is {}\n", machine, describe_machine());
+    }
+
+    // A different input makes the comparison meaningless; flag it loudly
+    const auto baseline_bytes = expected.value("input_bytes", std::uint64_t{0});
+    if (baseline_bytes != 0 && baseline_bytes != result.input_bytes) {
+        std::cout << vcf_tool::utils::format(
+            "  warning      baseline was recorded on a {} byte input, this one has {}\n",
+            baseline_bytes, result.input_bytes);
+    }
+
+    if (change_pct < -options.max_regression_pct) {
+        std::cout << "  FAILED: throughput regression\n";
+        return kExitRegression;
+    }
+    return kExitPass;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    CLI::App app{"throughput_regression - end-to-end pipeline throughput check"};
+
+    Options options;
+    app.add_option("--input", options.input, "Input VCF (e.g. generated by vcf_gen)")
+       ->required()
+       ->check(CLI::ExistingFile);
+    app.add_option("--preset", options.preset, "VcfToolBuilder preset")
+       ->check(CLI::IsMember({"defaults", "for_large_files", "for_low_memory"}))
+       ->capture_default_str();
+    app.add_option("--sink", options.sink, "null (parse only) or fake (encode + in-process fake DB)")
+       ->check(CLI::IsMember({"null", "fake"}))
+       ->capture_default_str();
+    app.add_option("--baseline", options.baseline, "Baseline JSON with per-preset records_per_sec");
+    app.add_option("--max-regression", options.max_regression_pct,
+                   "Fail if records/sec is more than this percentage below the baseline")
+       ->check(CLI::Range(0.0, 100.0))
+       ->capture_default_str();
+    app.add_option("--report", options.report, "Write the measured results to this JSON file");
+    app.add_flag("--update-baseline", options.update_baseline,
+                 "Store the measured throughput as the new baseline for this preset");
+
+    try {
+        app.parse(argc, argv);
+    } catch (const CLI::ParseError& e) {
+        return app.exit(e);
+    }
+
+    options.program = argv[0];
+    vcf_tool::utils::Logger::initialize("", vcf_tool::utils::Logger::Level::Warn, false);
+
+    try {
+        const Result result = run_preset(options);
+        print(options, result);
+
+        if (!options.report.empty()) {
+            auto report = to_json(result);
+            report["preset"] = options.preset;
+            report["sink"] = options.sink;
+            Json::save_to_file(report, options.report);
+        }
+
+        auto baseline = load_baseline(options.baseline);
+
+        if (options.update_baseline) {
+            if (options.baseline.empty()) {
+                std::cerr << "--update-baseline requires --baseline\n";
+                return kExitError;
+            }
+            auto entry = Json::object();
+            entry["records_per_sec"] = result.records_per_sec;
+            entry["mb_per_sec"]      = result.mb_per_sec;
+            entry["input_bytes"]     = result.input_bytes;
+            entry["sink"]            = options.sink;
+            entry["machine"]         = describe_machine();
+            baseline["presets"][options.preset] = std::move(entry);
+            Json::save_to_file(baseline, options.baseline);
+            std::cout << vcf_tool::utils::format("  baseline     updated in {} (recorded on {})\n",
+                                                 options.baseline, describe_machine());
+            return kExitPass;
+        }
+
+        return check_baseline(options, result, baseline);
+
+    } catch (const std::exception& e) {
+        std::cerr << "throughput_regression: " << e.what() << "\n";
+        return kExitError;
+    }
+}
@@ -0,0 +1,243 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "header/VcfDictionary.h"
+#include "header/VcfHeader.h"
+#include "memory/ChunkArena.h"
+#include "parser/VcfLineParser.h"
+#include "transform/AlleleSplitter.h"
+
+using namespace vcf_tool::domain;
+
+namespace {
+
+constexpr std::string_view kHeader[] = {
+    "##fileformat=VCFv4.3",
+    "##INFO=<ID=AF,Number=A,Type=Float,Description=\"Allele frequency\">",
+    "##INFO=<ID=RC,Number=R,Type=Integer,Description=\"Read count per allele\">",
+    "##INFO=<ID=GL,Number=G,Type=Float,Description=\"Genotype likelihoods\">",
+    "##INFO=<ID=DP,Number=1,Type=Integer,Description=\"Depth\">",
+    "##FORMAT=<ID=GT,Number=1,Type=String,Description=\"Genotype\">",
+    "##FORMAT=<ID=AD,Number=R,Type=Integer,Description=\"Allelic depths\">",
+    "##FORMAT=<ID=PL,Number=G,Type=Integer,Description=\"Phred likelihoods\">",
+    "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\tFORMAT\tS1\tS2",
+};
+
+// Decodes lines with kHeader and splits them
+class Fixture {
+public:
+    Fixture()
+        : header_(make_header())
+        , dictionary_(header_)
+    {
+    }
+
+    std::vector<entity::ParsedRecord> split(const std::string& line)
+    {
+        const VcfLineParser parser(dictionary_);
+        const transform::AlleleSplitter splitter(dictionary_);
+        auto record = parser(entity::RawLine{.line_number = 1, .end_offset = 0, .text = line, .is_end = false}, arena_);
+        std::vector<entity::ParsedRecord> parts;
+        splitter.split(std::move(record), parts);
+        return parts;
+    }
+
+    // INFO value of `key` as text ("" if absent), numbers printed as the parser reads them
+    std::string info(const entity::ParsedRecord& record, std::string_view key) const
+    {
+        for (const auto& field : record.vcf_data.info) {
+            if (dictionary_.info_keys.resolve(field.key) != key) {
+                continue;
+            }
+            if (field.value.kind == FieldValue::Kind::Number) {
+                return std::to_string(field.value.number);
+            }
+            return std::string(field.value.text);
+        }
+        return {};
+    }
+
+    // Integer FORMAT values of `key` for `sample`, padding dropped
+    std::vector<std::int32_t> format(const entity::ParsedRecord& record, std::string_view key,
+                                     std::uint32_t sample) const
+    {
+        const auto& samples = record.vcf_data.samples;
+        for (const auto& column : samples.columns) {
+            if (dictionary_.format_keys.resolve(column.key) != key) {
+                continue;
+            }
+            std::vector<std::int32_t> values;
+            for (auto value : column.integers.subspan(std::size_t{sample} * column.width, column.width)) {
+                if (value != kEndInt) {
+                    values.push_back(value);
+                }
+            }
+            return values;
+        }
+        return {};
+    }
+
+    // GT allele indices of `sample` (-1 = missing)
+    static std::vector<int> genotype(const entity::ParsedRecord& record, std::uint32_t sample)
+    {
+        const auto& samples = record.vcf_data.samples;
+        std::vector<int> alleles;
+        for (auto gt : samples.genotypes.subspan(std::size_t{sample} * samples.ploidy, samples.ploidy)) {
+            if (gt != kGtEnd) {
+                alleles.push_back(gt == 0 ? -1 : (gt >> 1) - 1);
+            }
+        }
+        return alleles;
+    }
+
+private:
+    static header::VcfHeader make_header()
+    {
+        header::VcfHeader header;
+        for (auto line : kHeader) {
+            header.parse_line(line);
+        }
+        return header;
+    }
+
+    header::VcfHeader header_;
+    header::VcfDictionary dictionary_;
+    memory::ArenaRef arena_ = memory::ChunkArena::create();
+};
+
+VcfRecord alleles(std::string_view ref, std::string_view alt, std::uint64_t position = 100)
+{
+    VcfRecord record;
+    record.position = position;
+    record.ref = ref;
+    record.alt = alt;
+    return record;
+}
+
+} // namespace
+
+TEST_CASE("AlleleSplitter keeps one Number=A value per part", "[domain][split]") {
+    Fixture f;
+    auto parts = f.split("chr1\t10\t.\tA\tC,G,T\t50\tPASS\tAF=0.125,0.25,0.5;DP=30\tGT\t0/1\t2/3");
+
+    REQUIRE(parts.size() == 3);
+    CHECK(parts[0].vcf_data.alt == "C");
+    CHECK(parts[1].vcf_data.alt == "G");
+    CHECK(parts[2].vcf_data.alt == "T");
+    CHECK(f.info(parts[0], "AF") == std::to_string(0.125));
+    CHECK(f.info(parts[1], "AF") == std::to_string(0.25));
+    CHECK(f.info(parts[2], "AF") == std::to_string(0.5));
+    CHECK(f.info(parts[1], "DP") == std::to_string(30.0));  // Number=1 is shared
+
+    // Only the last part commits the line
+    CHECK_FALSE(parts[0].commits_line);
+    CHECK_FALSE(parts[1].commits_line);
+    CHECK(parts[2].commits_line);
+}
+
+TEST_CASE("AlleleSplitter keeps the REF and ALT values of Number=R lists", "[domain][split]") {
+    Fixture f;
+    auto parts = f.split("chr1\t10\t.\tA\tC,G\t50\tPASS\tRC=10,20,30\tGT:AD\t1/2:5,6,7\t0/0:8,0,0");
+
+    REQUIRE(parts.size() == 2);
+    CHECK(f.info(parts[0], "RC") == "10,20");
+    CHECK(f.info(parts[1], "RC") == "10,30");
+    CHECK(f.format(parts[0], "AD", 0) == std::vector<std::int32_t>{5, 6});
+    CHECK(f.format(parts[1], "AD", 0) == std::vector<std::int32_t>{5, 7});
+    CHECK(f.format(parts[1], "AD", 1) == std::vector<std::int32_t>{8, 0});
+}
+
+TEST_CASE("AlleleSplitter keeps the REF/ALT genotypes of Number=G lists", "[domain][split]") {
+    Fixture f;
+    // Diploid order: 0/0 0/1 1/1 0/2 1/2 2/2; haploid: 0 1 2
+    auto parts = f.split("chr1\t10\t.\tA\tC,G\t50\tPASS\tGL=0,1,2,3,4,5\tGT:PL\t1/2:0,10,20,30,40,50\t2:7,8,9");
+
+    REQUIRE(parts.size() == 2);
+    CHECK(f.info(parts[0], "GL") == "0,1,2");
+    CHECK(f.info(parts[1], "GL") == "0,3,5");
+    CHECK(f.format(parts[0], "PL", 0) == std::vector<std::int32_t>{0, 10, 20});
+    CHECK(f.format(parts[1], "PL", 0) == std::vector<std::int32_t>{0, 30, 50});
+    CHECK(f.format(parts[0], "PL", 1) == std::vector<std::int32_t>{7, 8});
+    CHECK(f.format(parts[1], "PL", 1) == std::vector<std::int32_t>{7, 9});
+}
+
+TEST_CASE("AlleleSplitter recodes GT to the part's allele", "[domain][split]") {
+    Fixture f;
+    auto parts = f.split("chr1\t10\t.\tA\tC,G\t50\tPASS\t.\tGT\t1/2\t./2");
+
+    REQUIRE(parts.size() == 2);
+    CHECK(Fixture::genotype(parts[0], 0) == std::vector<int>{1, 0});
+    CHECK(Fixture::genotype(parts[1], 0) == std::vector<int>{0, 1});
+    CHECK(Fixture::genotype(parts[0], 1) == std::vector<int>{-1, 0});
+    CHECK(Fixture::genotype(parts[1], 1) == std::vector<int>{-1, 1});
+}
+
+TEST_CASE("AlleleSplitter leaves lists of the wrong length whole or missing", "[domain][split]") {
+    Fixture f;
+    auto parts = f.split("chr1\t10\t.\tA\tC,G\t50\tPASS\tAF=0.1,0.2,0.3;RC=1,2\tGT:AD:PL\t1/2:5,6:0,1\t0/1:.:.");
+
+    REQUIRE(parts.size() == 2);
+    for (const auto& part : parts) {
+        // INFO keeps the text as read
+        CHECK(f.info(part, "AF") == "0.1,0.2,0.3");
+        CHECK(f.info(part, "RC") == "1,2");
+        // Typed FORMAT values become missing
+        CHECK(f.format(part, "AD", 0) == std::vector<std::int32_t>{kMissingInt});
+        CHECK(f.format(part, "PL", 0) == std::vector<std::int32_t>{kMissingInt});
+        CHECK(f.format(part, "AD", 1) == std::vector<std::int32_t>{kMissingInt});
+    }
+}
+
+TEST_CASE("AlleleSplitter passes biallelic records through, trimmed", "[domain][split]") {
+    Fixture f;
+    auto parts = f.split("chr1\t10\t.\tACG\tACGT\t50\tPASS\tAF=0.5\tGT\t0/1\t1/1");
+
+    REQUIRE(parts.size() == 1);
+    CHECK(parts[0].vcf_data.ref == "G");
+    CHECK(parts[0].vcf_data.alt == "GT");
+    CHECK(parts[0].vcf_data.position == 12);
+    CHECK(f.info(parts[0], "AF") == std::to_string(0.5));
+    CHECK(parts[0].commits_line);
+}
+
+TEST_CASE("AlleleSplitter::trim drops shared bases, keeping one each", "[domain][split]") {
+    SECTION("already minimal") {
+        auto record = alleles("AC", "A");
+        CHECK_FALSE(transform::AlleleSplitter::trim(record));
+        CHECK(record.ref == "AC");
+        CHECK(record.alt == "A");
+        CHECK(record.position == 100);
+    }
+    SECTION("leading bases move POS") {
+        auto record = alleles("ACG", "ACGT");
+        CHECK(transform::AlleleSplitter::trim(record));
+        CHECK(record.ref == "G");
+        CHECK(record.alt == "GT");
+        CHECK(record.position == 102);
+    }
+    SECTION("trailing bases first") {
+        auto record = alleles("CAAA", "CA");
+        CHECK(transform::AlleleSplitter::trim(record));
+        CHECK(record.ref == "CAA");
+        CHECK(record.alt == "C");
+        CHECK(record.position == 100);
+    }
+    SECTION("both ends") {
+        auto record = alleles("GCATT", "GCTT");
+        CHECK(transform::AlleleSplitter::trim(record));
+        CHECK(record.ref == "CA");
+        CHECK(record.alt == "C");
+        CHECK(record.position == 101);
+    }
+    SECTION("symbolic and spanning alleles are left alone") {
+        auto symbolic = alleles("AT", "<DEL>");
+        CHECK_FALSE(transform::AlleleSplitter::trim(symbolic));
+        auto star = alleles("AT", "*");
+        CHECK_FALSE(transform::AlleleSplitter::trim(star));
+        CHECK(star.ref == "AT");
+    }
+}
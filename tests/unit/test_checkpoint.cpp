@@ -0,0 +1,261 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <vcf_tool/utils/Errors.h>
+
+#include "checkpoint/CheckpointStore.h"
+#include "checkpoint/CheckpointTracker.h"
+
+using namespace vcf_tool::domain::checkpoint;
+using vcf_tool::utils::errors::IOError;
+using vcf_tool::utils::errors::ValidationError;
+
+namespace {
+
+using Range = Checkpoint::LineRange;
+
+// Checkpoint file in a fresh directory, removed with it
+class TempCheckpoint {
+public:
+    TempCheckpoint()
+        : dir_(std::filesystem::temp_directory_path() /
+               ("vcf_tool_checkpoint_" + std::to_string(std::random_device{}())))
+    {
+        std::filesystem::create_directories(dir_);
+    }
+
+    ~TempCheckpoint() { std::filesystem::remove_all(dir_); }
+
+    TempCheckpoint(const TempCheckpoint&) = delete;
+    TempCheckpoint& operator=(const TempCheckpoint&) = delete;
+
+    std::string path() const { return (dir_ / "input.vcf.checkpoint").string(); }
+    CheckpointStore store() const { return CheckpointStore(path()); }
+
+    // Tracker for input.vcf that only persists when asked to
+    CheckpointTracker tracker(Checkpoint start = fresh()) const
+    {
+        return CheckpointTracker(store(), std::move(start), std::chrono::hours(1));
+    }
+
+    // What a resumed run would load
+    Checkpoint saved() const
+    {
+        auto checkpoint = store().load();
+        REQUIRE(checkpoint.has_value());
+        return *checkpoint;
+    }
+
+    void write(const std::string& text) const { std::ofstream(path()) << text; }
+
+    static Checkpoint fresh()
+    {
+        Checkpoint checkpoint;
+        checkpoint.source = "data/input.vcf";
+        checkpoint.file_size = 1000;
+        return checkpoint;
+    }
+
+private:
+    std::filesystem::path dir_;
+};
+
+// Line n ends at offset 10 * n
+void commit(CheckpointTracker& tracker, std::uint64_t line_number)
+{
+    tracker.commit(line_number, line_number * 10);
+}
+
+} // namespace
+
+TEST_CASE("CheckpointTracker drains out-of-order commits into the watermark", "[domain][checkpoint]") {
+    TempCheckpoint temp;
+    auto tracker = temp.tracker();
+
+    commit(tracker, 3);
+    commit(tracker, 6);
+    commit(tracker, 2);
+    commit(tracker, 7);
+    CHECK(tracker.watermark().line_number == 0);
+
+    tracker.persist();
+    CHECK(temp.saved().committed_ahead == std::vector<Range>{{2, 3, 30}, {6, 7, 70}});
+
+    commit(tracker, 1);  // Joins the run 2-3
+    CHECK(tracker.watermark().line_number == 3);
+    CHECK(tracker.watermark().byte_offset == 30);
+
+    commit(tracker, 5);  // Extends 6-7 downwards
+    commit(tracker, 3);  // Already committed
+    commit(tracker, 6);
+    tracker.persist();
+    CHECK(temp.saved().line_number == 3);
+    CHECK(temp.saved().committed_ahead == std::vector<Range>{{5, 7, 70}});
+
+    commit(tracker, 4);  // Fills the last gap
+    CHECK(tracker.watermark().line_number == 7);
+    CHECK(tracker.watermark().byte_offset == 70);
+    CHECK_FALSE(tracker.stalled());
+}
+
+TEST_CASE("CheckpointTracker merges runs that meet", "[domain][checkpoint]") {
+    TempCheckpoint temp;
+    auto tracker = temp.tracker();
+
+    // Every other line first, then the ones between them
+    for (std::uint64_t line = 3; line <= 2001; line += 2) {
+        commit(tracker, line);
+    }
+    for (std::uint64_t line = 4; line <= 2000; line += 2) {
+        commit(tracker, line);
+    }
+    tracker.persist();
+    CHECK(temp.saved().committed_ahead == std::vector<Range>{{3, 2001, 20010}});
+    CHECK(temp.saved().lines_ahead() == 1999);
+
+    commit(tracker, 2);
+    commit(tracker, 1);
+    CHECK(tracker.watermark().line_number == 2001);
+}
+
+TEST_CASE("CheckpointTracker never moves the watermark past a failed line", "[domain][checkpoint]") {
+    TempCheckpoint temp;
+
+    SECTION("a failed line commits nothing") {
+        auto tracker = temp.tracker();
+        commit(tracker, 1);
+        tracker.stall(2);
+        commit(tracker, 3);
+        commit(tracker, 4);
+        tracker.persist();
+
+        CHECK(tracker.stalled());
+        CHECK(temp.saved().line_number == 1);
+        CHECK(temp.saved().byte_offset == 10);
+        CHECK(temp.saved().committed_ahead == std::vector<Range>{{3, 4, 40}});
+    }
+
+    SECTION("a split line whose early part failed is not committed by its last part") {
+        // Line 3's first part sat in a failed batch; its last part lands in a later one
+        auto tracker = temp.tracker();
+        commit(tracker, 1);
+        commit(tracker, 2);
+        tracker.stall(3);
+        commit(tracker, 3);
+        commit(tracker, 4);
+        tracker.persist();
+
+        CHECK(tracker.watermark().line_number == 2);
+        CHECK(temp.saved().line_number == 2);
+        CHECK(temp.saved().committed_ahead == std::vector<Range>{{4, 4, 40}});
+    }
+
+    SECTION("every line of a failed batch is held back") {
+        auto tracker = temp.tracker();
+        for (std::uint64_t line : {5u, 2u, 7u}) {
+            tracker.stall(line);
+        }
+        for (std::uint64_t line = 1; line <= 8; ++line) {
+            commit(tracker, line);
+        }
+        tracker.persist();
+
+        CHECK(temp.saved().line_number == 1);
+        CHECK(temp.saved().committed_ahead == std::vector<Range>{{3, 4, 40}, {6, 6, 60}, {8, 8, 80}});
+    }
+}
+
+TEST_CASE("CheckpointTracker resumes from the committed ranges it persisted", "[domain][checkpoint]") {
+    TempCheckpoint temp;
+    {
+        auto tracker = temp.tracker();
+        commit(tracker, 1);
+        tracker.stall(2);
+        for (std::uint64_t line = 3; line <= 5; ++line) {
+            commit(tracker, line);
+        }
+        commit(tracker, 9);
+        tracker.persist();
+    }
+
+    auto loaded = temp.store().load_for("input.vcf", 1000);
+    REQUIRE(loaded.has_value());
+    CHECK(loaded->line_number == 1);
+    CHECK(loaded->committed_ahead == std::vector<Range>{{3, 5, 50}, {9, 9, 90}});
+
+    // The resumed run re-reads lines 2, 6, 7 and 8 only
+    auto tracker = temp.tracker(*loaded);
+    commit(tracker, 2);
+    CHECK(tracker.watermark().line_number == 5);
+    CHECK(tracker.watermark().byte_offset == 50);
+    commit(tracker, 7);
+    commit(tracker, 6);
+    commit(tracker, 8);
+    CHECK(tracker.watermark().line_number == 9);
+    CHECK(tracker.watermark().byte_offset == 90);
+}
+
+TEST_CASE("CheckpointStore round-trips a checkpoint", "[domain][checkpoint]") {
+    TempCheckpoint temp;
+    auto checkpoint = TempCheckpoint::fresh();
+    checkpoint.line_number = 12;
+    checkpoint.byte_offset = 340;
+    checkpoint.committed_ahead = {{14, 14, 360}, {20, 25, 500}};
+
+    CHECK_FALSE(temp.store().load().has_value());
+    temp.store().save(checkpoint);
+
+    const auto loaded = temp.saved();
+    CHECK(loaded.source == checkpoint.source);
+    CHECK(loaded.file_size == 1000);
+    CHECK(loaded.line_number == 12);
+    CHECK(loaded.byte_offset == 340);
+    CHECK(loaded.committed_ahead == checkpoint.committed_ahead);
+    CHECK(loaded.lines_ahead() == 7);
+    CHECK_FALSE(std::filesystem::exists(temp.path() + ".tmp"));
+}
+
+TEST_CASE("CheckpointStore rejects malformed committed ranges", "[domain][checkpoint]") {
+    TempCheckpoint temp;
+    const std::string prefix =
+        R"({"source": "input.vcf", "file_size": 1000, "line_number": 5, "byte_offset": 50, "committed_ahead": )";
+
+    temp.write(prefix + "[[7, 9, 90], [12, 12, 120]]}");
+    CHECK(temp.saved().committed_ahead == std::vector<Range>{{7, 9, 90}, {12, 12, 120}});
+
+    for (const char* ranges : {"[[5, 6, 60]]", "[[9, 7, 90]]", "[[7, 9, 90], [9, 10, 100]]", "[[7, 9]]"}) {
+        INFO(ranges);
+        temp.write(prefix + ranges + "}");
+        CHECK_THROWS_AS(temp.store().load(), IOError);
+    }
+}
+
+TEST_CASE("Checkpoint is completed once the whole input is committed", "[domain][checkpoint]") {
+    auto checkpoint = TempCheckpoint::fresh();
+    CHECK_FALSE(checkpoint.completed());
+    checkpoint.byte_offset = 999;
+    CHECK_FALSE(checkpoint.completed());
+    checkpoint.byte_offset = 1000;
+    CHECK(checkpoint.completed());
+
+    // An unknown (empty) input is never completed
+    checkpoint.file_size = 0;
+    CHECK_FALSE(checkpoint.completed());
+}
+
+TEST_CASE("CheckpointStore refuses to resume another input", "[domain][checkpoint]") {
+    TempCheckpoint temp;
+    CHECK_FALSE(temp.store().load_for("input.vcf", 1000).has_value());
+
+    temp.store().save(TempCheckpoint::fresh());
+    CHECK(temp.store().load_for("/elsewhere/input.vcf", 1000).has_value());
+    CHECK_THROWS_AS(temp.store().load_for("data/input.vcf", 999), ValidationError);
+    CHECK_THROWS_AS(temp.store().load_for("data/other.vcf", 1000), ValidationError);
+}
@@ -0,0 +1,215 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <vcf_tool/utils/Errors.h>
+
+#include "filter/RecordFilter.h"
+#include "header/VcfDictionary.h"
+#include "header/VcfHeader.h"
+#include "memory/ChunkArena.h"
+#include "parser/VcfLineParser.h"
+
+using namespace vcf_tool::domain;
+using vcf_tool::utils::errors::ParsingError;
+
+namespace {
+
+constexpr std::string_view kHeader[] = {
+    "##fileformat=VCFv4.3",
+    "##INFO=<ID=DP,Number=1,Type=Integer,Description=\"Depth\">",
+    "##INFO=<ID=AF,Number=A,Type=Float,Description=\"Allele frequency\">",
+    "##INFO=<ID=DB,Number=0,Type=Flag,Description=\"dbSNP\">",
+    "##FORMAT=<ID=GT,Number=1,Type=String,Description=\"Genotype\">",
+    "##FORMAT=<ID=DP,Number=1,Type=Integer,Description=\"Depth\">",
+    "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\tFORMAT\tS1\tS2",
+};
+
+constexpr std::string_view kLine = "chr2\t1500\trs1\tA\tG,T\t42.5\tPASS\tDP=10;AF=0.25,0.5;DB;XK=new\tGT:DP\t0/1:5\t1/2:7";
+
+// Parses lines with kHeader, fixed columns first
+class Fixture {
+public:
+    Fixture()
+        : header_(make_header())
+        , dictionary_(header_)
+        , parser_(dictionary_)
+    {
+    }
+
+    entity::ParsedRecord parse_fixed(std::string_view line, std::uint64_t line_number = 1)
+    {
+        return parser_.parse_fixed(raw(line, line_number), arena_);
+    }
+
+    entity::ParsedRecord parse_fixed(std::string_view line, parser::ParseError& error)
+    {
+        return parser_.parse_fixed(raw(line, 1), arena_, error);
+    }
+
+    entity::ParsedRecord parse(std::string_view line) { return parser_(raw(line, 1), arena_); }
+
+    void decode(entity::ParsedRecord& record) const { parser_.decode_fields(record); }
+
+    // INFO entries and FORMAT matrix as text
+    std::string dump(const VcfRecord& record) const
+    {
+        std::string out;
+        for (const auto& field : record.info) {
+            out += std::string(dictionary_.info_keys.resolve(field.key)) + "="
+                + std::to_string(static_cast<int>(field.value.kind)) + "/"
+                + std::to_string(field.value.number) + "/" + std::string(field.value.text) + ";";
+        }
+        const auto& samples = record.samples;
+        out += " " + std::to_string(samples.sample_count) + "x" + std::to_string(samples.ploidy) + ":";
+        for (auto byte : samples.genotypes) {
+            out += " " + std::to_string(byte);
+        }
+        for (const auto& column : samples.columns) {
+            out += " " + std::string(dictionary_.format_keys.resolve(column.key)) + "[";
+            for (auto value : column.integers) {
+                out += std::to_string(value) + ",";
+            }
+            out += "]";
+        }
+        return out;
+    }
+
+    header::VcfDictionary& dictionary() { return dictionary_; }
+
+private:
+    static header::VcfHeader make_header()
+    {
+        header::VcfHeader header;
+        for (auto line : kHeader) {
+            header.parse_line(line);
+        }
+        return header;
+    }
+
+    static entity::RawLine raw(std::string_view line, std::uint64_t line_number)
+    {
+        return entity::RawLine{.line_number = line_number, .end_offset = line_number * 100,
+                               .text = std::string(line), .is_end = false};
+    }
+
+    header::VcfHeader header_;
+    header::VcfDictionary dictionary_;
+    VcfLineParser parser_;
+    memory::ArenaRef arena_ = memory::ChunkArena::create();
+};
+
+} // namespace
+
+TEST_CASE("parse_fixed decodes the fixed columns and defers INFO and FORMAT", "[domain][deferred]") {
+    Fixture f;
+    auto record = f.parse_fixed(kLine, 7);
+
+    CHECK(record.line_number == 7);
+    CHECK(record.end_offset == 700);
+    const auto& data = record.vcf_data;
+    CHECK(f.dictionary().contigs.resolve(data.chromosome) == "chr2");
+    CHECK(data.position == 1500);
+    CHECK(data.ref == "A");
+    CHECK(data.alt == "G,T");
+    CHECK(data.qual == 42.5);
+    CHECK(f.dictionary().filters.resolve(data.filter) == "PASS");
+
+    CHECK_FALSE(data.decoded());
+    CHECK(data.info.empty());
+    CHECK(data.samples.sample_count == 0);
+    CHECK(data.deferred.info == "DP=10;AF=0.25,0.5;DB;XK=new");
+    CHECK(data.deferred.format == "GT:DP");
+    CHECK(data.deferred.samples == "0/1:5\t1/2:7");
+
+    // Keys of the deferred columns are not interned yet
+    CHECK_FALSE(f.dictionary().info_keys.find("XK").has_value());
+
+    f.decode(record);
+    CHECK(record.vcf_data.decoded());
+    CHECK(record.vcf_data.info.size() == 4);
+    CHECK(record.vcf_data.samples.sample_count == 2);
+    CHECK(f.dictionary().info_keys.find("XK").has_value());
+}
+
+TEST_CASE("Decoding a deferred record gives the full parse", "[domain][deferred]") {
+    Fixture f;
+
+    for (std::string_view line : {
+             kLine,
+             std::string_view("chr1\t10\t.\tC\tA\t.\tq10\tDB\tGT\t./.\t0|1"),
+             std::string_view("chr1\t11\t.\tC\t.\t.\t.\t.\tDP\t3\t."),
+             std::string_view("chr1\t12\t.\tC\tA\t9\tPASS\tAF=0.1"),
+         }) {
+        INFO(line);
+        const auto full = f.parse(line);
+        auto deferred = f.parse_fixed(line);
+        f.decode(deferred);
+
+        CHECK(deferred.vcf_data.decoded());
+        CHECK(f.dump(deferred.vcf_data) == f.dump(full.vcf_data));
+
+        // Decoding again is a no-op
+        f.decode(deferred);
+        CHECK(f.dump(deferred.vcf_data) == f.dump(full.vcf_data));
+    }
+}
+
+TEST_CASE("parse_fixed leaves nothing to decode for absent columns", "[domain][deferred]") {
+    Fixture f;
+
+    SECTION("INFO '.' and no FORMAT") {
+        const auto record = f.parse_fixed("chr1\t10\t.\tC\tA\t.\tPASS\t.");
+        CHECK(record.vcf_data.decoded());
+        CHECK(record.vcf_data.deferred.samples.empty());
+    }
+
+    SECTION("FORMAT without sample columns") {
+        const auto record = f.parse_fixed("chr1\t10\t.\tC\tA\t.\tPASS\tDP=1\tGT");
+        CHECK(record.vcf_data.deferred.info == "DP=1");
+        CHECK(record.vcf_data.deferred.format.empty());
+    }
+}
+
+TEST_CASE("A filter reads deferred INFO without decoding it", "[domain][deferred]") {
+    Fixture f;
+    const auto filter = filter::RecordFilter::compile("INFO.DP>=10 && QUAL>40", f.dictionary());
+
+    const auto kept = f.parse_fixed(kLine);
+    CHECK(filter.matches(kept.vcf_data));
+    CHECK_FALSE(kept.vcf_data.decoded());
+
+    const auto dropped = f.parse_fixed("chr2\t1500\t.\tA\tG\t42.5\tPASS\tDP=9\tGT\t0/1");
+    CHECK_FALSE(filter.matches(dropped.vcf_data));
+
+    // Same verdict once decoded
+    auto decoded = f.parse_fixed(kLine);
+    f.decode(decoded);
+    CHECK(filter.matches(decoded.vcf_data));
+}
+
+TEST_CASE("parse_fixed reports malformed fixed columns", "[domain][deferred]") {
+    Fixture f;
+
+    SECTION("throwing") {
+        CHECK_THROWS_AS(f.parse_fixed("chr1\t10\t.\tC\tA\t.\tPASS"), ParsingError);
+        CHECK_THROWS_AS(f.parse_fixed("chr1\t1e3\t.\tC\tA\t.\tPASS\t."), ParsingError);
+    }
+
+    SECTION("non-throwing") {
+        parser::ParseError error;
+        const auto record = f.parse_fixed("chr1\tten\t.\tC\tA\t.\tPASS\tDP=1", error);
+        CHECK(error.kind == parser::ParseError::Kind::Position);
+        CHECK(error.value == "ten");
+        CHECK(record.line_number == 1);
+        CHECK(record.vcf_data.chromosome == kNoStringId);
+        CHECK_FALSE(f.dictionary().contigs.find("chr1").has_value());
+
+        parser::ParseError short_line;
+        f.parse_fixed("chr1\t10\t.", short_line);
+        CHECK(short_line.kind == parser::ParseError::Kind::Columns);
+        CHECK(short_line.columns == 3);
+    }
+}
@@ -0,0 +1,160 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <vcf_tool/core/Metrics.h>
+
+#include "filter/DuplicateFilter.h"
+
+using namespace vcf_tool::domain;
+using filter::DuplicateFilter;
+using filter::KeySet;
+
+namespace {
+
+constexpr StringId kChr1 = 0;
+constexpr StringId kChr2 = 1;
+constexpr StringId kChr3 = 2;
+
+VcfRecord variant(StringId chromosome, std::uint64_t position, std::string_view ref = "A",
+                  std::string_view alt = "C")
+{
+    VcfRecord record;
+    record.chromosome = chromosome;
+    record.position = position;
+    record.ref = ref;
+    record.alt = alt;
+    return record;
+}
+
+// One chunk of a sorted-input worker: lines [first, first + records.size())
+std::vector<bool> chunk(DuplicateFilter& filter, std::size_t worker, std::uint64_t first,
+                        const std::vector<VcfRecord>& records)
+{
+    filter.begin_chunk(worker);
+    filter.took_lines(worker, first, first + records.size() - 1);
+    std::vector<bool> fresh;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        fresh.push_back(filter.first_seen(worker, records[i], first + i));
+    }
+    filter.end_chunk(worker);
+    return fresh;
+}
+
+} // namespace
+
+TEST_CASE("KeySet holds each key once across growth", "[domain][dedup]") {
+    KeySet keys;
+    constexpr std::uint64_t kCount = 100'000;
+    for (std::uint64_t i = 0; i < kCount; ++i) {
+        REQUIRE(keys.insert(i * 0x9E3779B97F4A7C15ull));
+    }
+    CHECK(keys.size() == kCount);
+    for (std::uint64_t i = 0; i < kCount; ++i) {
+        REQUIRE_FALSE(keys.insert(i * 0x9E3779B97F4A7C15ull));
+    }
+    CHECK(keys.size() == kCount);
+
+    SECTION("key 0 is stored as 1") {
+        KeySet small;
+        CHECK(small.insert(0));
+        CHECK_FALSE(small.insert(1));
+    }
+}
+
+TEST_CASE("DuplicateFilter keys on CHROM, POS, REF and ALT", "[domain][dedup]") {
+    const auto key = DuplicateFilter::key(variant(kChr1, 100, "A", "C"));
+    CHECK(DuplicateFilter::key(variant(kChr1, 100, "A", "C")) == key);
+    CHECK(DuplicateFilter::key(variant(kChr2, 100, "A", "C")) != key);
+    CHECK(DuplicateFilter::key(variant(kChr1, 101, "A", "C")) != key);
+    CHECK(DuplicateFilter::key(variant(kChr1, 100, "G", "C")) != key);
+    CHECK(DuplicateFilter::key(variant(kChr1, 100, "A", "T")) != key);
+    // REF and ALT are separated: moving a base across them changes the key
+    CHECK(DuplicateFilter::key(variant(kChr1, 100, "AC", "G")) != DuplicateFilter::key(variant(kChr1, 100, "A", "CG")));
+}
+
+TEST_CASE("Unsorted DuplicateFilter keeps every key for the run", "[domain][dedup]") {
+    vcf_tool::core::metrics::Counter duplicates;
+    DuplicateFilter filter(DuplicateFilter::Order::Unsorted, 2, &duplicates);
+
+    CHECK(filter.first_seen(0, variant(kChr1, 100), 1));
+    CHECK(filter.first_seen(1, variant(kChr2, 100), 2));
+    CHECK_FALSE(filter.first_seen(1, variant(kChr1, 100), 3));  // Back to chr1: still caught
+    CHECK(filter.first_seen(0, variant(kChr1, 100, "A", "G"), 4));
+    CHECK_FALSE(filter.first_seen(0, variant(kChr2, 100), 5));
+
+    CHECK(filter.size() == 3);
+    CHECK(duplicates.value() == 2);
+    CHECK_FALSE(filter.saw_unsorted());
+}
+
+TEST_CASE("Unsorted DuplicateFilter keeps one copy across threads", "[domain][dedup]") {
+    DuplicateFilter filter(DuplicateFilter::Order::Unsorted, 4);
+    constexpr std::uint64_t kVariants = 20'000;
+    std::vector<std::size_t> kept(4, 0);
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t] {
+                for (std::uint64_t pos = 1; pos <= kVariants; ++pos) {
+                    if (filter.first_seen(t, variant(kChr1, pos), pos)) {
+                        ++kept[t];
+                    }
+                }
+            });
+        }
+    }
+    CHECK(kept[0] + kept[1] + kept[2] + kept[3] == kVariants);
+    CHECK(filter.size() == kVariants);
+}
+
+TEST_CASE("Sorted DuplicateFilter releases chromosomes every parser has passed", "[domain][dedup]") {
+    vcf_tool::core::metrics::Counter duplicates;
+    DuplicateFilter filter(DuplicateFilter::Order::Sorted, 2, &duplicates);
+
+    CHECK(chunk(filter, 0, 1, {variant(kChr1, 10), variant(kChr1, 20), variant(kChr1, 10)})
+          == std::vector<bool>{true, true, false});
+    CHECK(filter.size() == 2);
+
+    SECTION("once a later chromosome starts after its last line") {
+        CHECK(chunk(filter, 1, 4, {variant(kChr2, 10), variant(kChr2, 30)}) == std::vector<bool>{true, true});
+        CHECK(filter.size() == 2);  // chr1's keys are gone
+
+        // chr2 is still open: its duplicates are caught
+        CHECK(chunk(filter, 0, 6, {variant(kChr2, 30), variant(kChr3, 5)}) == std::vector<bool>{false, true});
+        CHECK(filter.size() == 1);
+        CHECK(duplicates.value() == 2);
+        CHECK_FALSE(filter.saw_unsorted());
+    }
+
+    SECTION("not while a parser may still hold one of its lines") {
+        // Worker 0 takes lines 4-5 (the end of chr1) but hasn't parsed them yet
+        filter.begin_chunk(0);
+        filter.took_lines(0, 4, 5);
+
+        // Worker 1 starts chr2 after them
+        CHECK(chunk(filter, 1, 6, {variant(kChr2, 10)}) == std::vector<bool>{true});
+        CHECK(filter.size() == 3);
+
+        CHECK_FALSE(filter.first_seen(0, variant(kChr1, 20), 4));  // chr1 still caught
+        CHECK(filter.first_seen(0, variant(kChr1, 30), 5));
+        filter.end_chunk(0);
+        CHECK(filter.size() == 1);  // Released now that worker 0 is done
+    }
+}
+
+TEST_CASE("Sorted DuplicateFilter reports input that returns to a released chromosome", "[domain][dedup]") {
+    DuplicateFilter filter(DuplicateFilter::Order::Sorted, 1);
+
+    chunk(filter, 0, 1, {variant(kChr1, 10)});
+    chunk(filter, 0, 2, {variant(kChr2, 10)});
+    CHECK_FALSE(filter.saw_unsorted());
+
+    // chr1 again: its first block was released, so the repeat is not caught
+    CHECK(chunk(filter, 0, 3, {variant(kChr1, 10), variant(kChr1, 10)}) == std::vector<bool>{true, false});
+    CHECK(filter.saw_unsorted());
+}
@@ -0,0 +1,165 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <vcf_tool/core/Metrics.h>
+
+using namespace vcf_tool::core::metrics;
+
+namespace {
+
+// Observations 0, 1, 3, 3, 100: buckets 0, 1, 2, 2 and 7
+Histogram::Snapshot sample_snapshot()
+{
+    Histogram histogram;
+    for (std::uint64_t v : {0u, 1u, 3u, 3u, 100u}) {
+        histogram.observe(v);
+    }
+    return histogram.snapshot();
+}
+
+bool contains(const std::string& text, const std::string& part)
+{
+    return text.find(part) != std::string::npos;
+}
+
+} // namespace
+
+TEST_CASE("MetricsRegistry returns the registered metric for a known name", "[core][metrics]") {
+    MetricsRegistry registry;
+
+    auto& counter = registry.counter("vcf_lines_total", "Lines");
+    counter.add(2);
+    CHECK(&registry.counter("vcf_lines_total", "Lines again") == &counter);
+    CHECK(registry.counter("vcf_lines_total", "").value() == 2);
+
+    auto& gauge = registry.gauge("vcf_depth", "Depth");
+    CHECK(&registry.gauge("vcf_depth", "Depth") == &gauge);
+
+    auto& histogram = registry.histogram("vcf_latency_seconds", "Latency", 1e-9);
+    CHECK(&registry.histogram("vcf_latency_seconds", "Latency") == &histogram);
+
+    SECTION("a callback gauge takes the new callback") {
+        registry.gauge_callback("vcf_free", "Free", [] { return 1.0; });
+        registry.gauge_callback("vcf_free", "Free", [] { return 2.0; });
+        CHECK(contains(registry.to_prometheus(), "\nvcf_free 2\n"));
+    }
+}
+
+TEST_CASE("MetricsRegistry refuses a name registered as another kind", "[core][metrics]") {
+    MetricsRegistry registry;
+    registry.counter("vcf_records", "Records");
+    registry.gauge_callback("vcf_queue_depth", "Depth", [] { return 0.0; });
+
+    CHECK_THROWS_AS(registry.gauge("vcf_records", "Records"), std::logic_error);
+    CHECK_THROWS_AS(registry.histogram("vcf_records", "Records"), std::logic_error);
+    CHECK_THROWS_AS(registry.gauge_callback("vcf_records", "Records", [] { return 0.0; }), std::logic_error);
+    CHECK_THROWS_AS(registry.gauge("vcf_queue_depth", "Depth"), std::logic_error);
+    CHECK_THROWS_AS(registry.counter("vcf_queue_depth", "Depth"), std::logic_error);
+
+    // The failed registrations left nothing behind
+    const auto text = registry.to_prometheus();
+    CHECK(contains(text, "# TYPE vcf_records counter\n"));
+    CHECK_FALSE(contains(text, "# TYPE vcf_records gauge"));
+}
+
+TEST_CASE("Histogram buckets observations by bit width", "[core][metrics]") {
+    const auto snap = sample_snapshot();
+
+    CHECK(snap.count == 5);
+    CHECK(snap.sum == 107);
+    CHECK(snap.max == 100);
+    CHECK(snap.buckets[0] == 1);
+    CHECK(snap.buckets[1] == 1);
+    CHECK(snap.buckets[2] == 2);
+    CHECK(snap.buckets[7] == 1);
+    CHECK(snap.mean() == 107.0 / 5.0);
+
+    SECTION("huge values land in the last bucket") {
+        Histogram histogram;
+        histogram.observe(UINT64_MAX);
+        CHECK(histogram.snapshot().buckets[Histogram::kBuckets - 1] == 1);
+    }
+}
+
+TEST_CASE("Histogram quantiles are bucket upper bounds capped by the max", "[core][metrics]") {
+    const auto snap = sample_snapshot();
+
+    CHECK(snap.quantile(0.2) == 0);    // Rank 1: bucket 0
+    CHECK(snap.quantile(0.4) == 1);    // Rank 2: bucket 1 (2^1 - 1)
+    CHECK(snap.quantile(0.5) == 3);    // Rank 3: bucket 2 (2^2 - 1)
+    CHECK(snap.quantile(0.8) == 3);
+    CHECK(snap.quantile(0.9) == 100);  // Bucket 7 would be 127
+    CHECK(snap.quantile(1.0) == 100);
+
+    CHECK(Histogram::Snapshot{}.quantile(0.5) == 0);
+}
+
+TEST_CASE("Metrics updated from many threads sum every update", "[core][metrics]") {
+    MetricsRegistry registry;
+    auto& counter = registry.counter("vcf_adds_total", "Adds");
+    auto& histogram = registry.histogram("vcf_values", "Values");
+    constexpr std::size_t kThreads = 2 * kShards + 3;  // Some threads share a shard
+    constexpr std::uint64_t kPerThread = 1000;
+
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&, t] {
+                for (std::uint64_t i = 0; i < kPerThread; ++i) {
+                    counter.add();
+                    histogram.observe(t);
+                }
+            });
+        }
+    }
+
+    CHECK(counter.value() == kThreads * kPerThread);
+    const auto snap = histogram.snapshot();
+    CHECK(snap.count == kThreads * kPerThread);
+    CHECK(snap.max == kThreads - 1);
+    CHECK(snap.sum == kPerThread * (kThreads * (kThreads - 1) / 2));
+}
+
+TEST_CASE("MetricsRegistry exports the Prometheus text format", "[core][metrics]") {
+    MetricsRegistry registry;
+    registry.counter("vcf_records_total", "Records written").add(42);
+    registry.gauge("vcf_active_parsers", "Active parsers").set(-3);
+    registry.gauge_callback("vcf_queue_depth", "Queued lines", [] { return 7.5; });
+    auto& histogram = registry.histogram("vcf_batch_seconds", "Batch time", 0.5);
+    for (std::uint64_t v : {1u, 3u, 3u, 12u}) {
+        histogram.observe(v);
+    }
+    registry.histogram("vcf_empty_seconds", "Never observed");
+
+    CHECK(registry.to_prometheus() ==
+          "# HELP vcf_records_total Records written\n"
+          "# TYPE vcf_records_total counter\n"
+          "vcf_records_total 42\n"
+          "# HELP vcf_active_parsers Active parsers\n"
+          "# TYPE vcf_active_parsers gauge\n"
+          "vcf_active_parsers -3\n"
+          "# HELP vcf_queue_depth Queued lines\n"
+          "# TYPE vcf_queue_depth gauge\n"
+          "vcf_queue_depth 7.5\n"
+          "# HELP vcf_batch_seconds Batch time\n"
+          "# TYPE vcf_batch_seconds histogram\n"
+          // Cumulative, from the first to the last non-empty bucket, le = 2^i * scale
+          "vcf_batch_seconds_bucket{le=\"1\"} 1\n"
+          "vcf_batch_seconds_bucket{le=\"2\"} 3\n"
+          "vcf_batch_seconds_bucket{le=\"4\"} 3\n"
+          "vcf_batch_seconds_bucket{le=\"8\"} 4\n"
+          "vcf_batch_seconds_bucket{le=\"+Inf\"} 4\n"
+          "vcf_batch_seconds_sum 9.5\n"
+          "vcf_batch_seconds_count 4\n"
+          "# HELP vcf_empty_seconds Never observed\n"
+          "# TYPE vcf_empty_seconds histogram\n"
+          "vcf_empty_seconds_bucket{le=\"+Inf\"} 0\n"
+          "vcf_empty_seconds_sum 0\n"
+          "vcf_empty_seconds_count 0\n");
+}
@@ -0,0 +1,181 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <vcf_tool/utils/Errors.h>
+
+#include "filter/RecordFilter.h"
+#include "header/VcfDictionary.h"
+#include "header/VcfHeader.h"
+#include "memory/ChunkArena.h"
+#include "parser/VcfLineParser.h"
+
+using namespace vcf_tool::domain;
+using filter::RecordFilter;
+using vcf_tool::utils::errors::ValidationError;
+
+namespace {
+
+constexpr std::string_view kHeader[] = {
+    "##fileformat=VCFv4.3",
+    "##FILTER=<ID=q10,Description=\"Quality below 10\">",
+    "##INFO=<ID=AF,Number=A,Type=Float,Description=\"Allele frequency\">",
+    "##INFO=<ID=AC,Number=A,Type=Integer,Description=\"Allele count\">",
+    "##INFO=<ID=DB,Number=0,Type=Flag,Description=\"dbSNP member\">",
+    "##INFO=<ID=GENE,Number=1,Type=String,Description=\"Gene name\">",
+    "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO",
+};
+
+// Compiles filters and parses lines against one dictionary
+class Fixture {
+public:
+    Fixture()
+        : header_(make_header())
+        , dictionary_(header_)
+    {
+    }
+
+    RecordFilter compile(std::string_view expression) { return RecordFilter::compile(expression, dictionary_); }
+
+    // Fixed columns only: INFO still deferred, as the parsers filter it
+    VcfRecord fixed(const std::string& line)
+    {
+        return VcfLineParser(dictionary_).parse_fixed(raw(line), arena_).vcf_data;
+    }
+
+    // INFO decoded, as a split record is filtered
+    VcfRecord decoded(const std::string& line)
+    {
+        return VcfLineParser(dictionary_)(raw(line), arena_).vcf_data;
+    }
+
+    // matches() on both forms of `line`, which must agree
+    bool matches(std::string_view expression, const std::string& line)
+    {
+        const auto filter = compile(expression);
+        const bool on_fixed = filter.matches(fixed(line));
+        const bool on_decoded = filter.matches(decoded(line));
+        CHECK(on_fixed == on_decoded);
+        return on_fixed;
+    }
+
+    // Message of the ValidationError compiling `expression` throws ("" if none)
+    std::string error(std::string_view expression)
+    {
+        try {
+            compile(expression);
+        } catch (const ValidationError& e) {
+            return e.what();
+        }
+        return {};
+    }
+
+private:
+    static header::VcfHeader make_header()
+    {
+        header::VcfHeader header;
+        for (auto line : kHeader) {
+            header.parse_line(line);
+        }
+        return header;
+    }
+
+    static entity::RawLine raw(const std::string& line)
+    {
+        return entity::RawLine{.line_number = 1, .end_offset = 0, .text = line, .is_end = false};
+    }
+
+    header::VcfHeader header_;
+    header::VcfDictionary dictionary_;
+    memory::ArenaRef arena_ = memory::ChunkArena::create();
+};
+
+const std::string kPass = "chr1\t1500\trs1\tA\tG\t45.5\tPASS\tAF=0.02;AC=3,5;DB;GENE=BRCA2";
+const std::string kLowQual = "chr2\t80\t.\tAT\tA\t.\tq10\tAF=.;GENE=\"TP53\"";
+
+} // namespace
+
+TEST_CASE("RecordFilter compiles expressions and lists their INFO keys", "[domain][filter]") {
+    Fixture f;
+    const auto filter = f.compile(R"(FILTER=="PASS" && (INFO.AF>0.01 || INFO/DB) && !INFO.AF<0)");
+
+    CHECK(filter.expression() == R"(FILTER=="PASS" && (INFO.AF>0.01 || INFO/DB) && !INFO.AF<0)");
+    CHECK(filter.info_keys() == std::vector<std::string>{"AF", "DB"});
+    CHECK(f.compile("QUAL>=30").info_keys().empty());
+}
+
+TEST_CASE("RecordFilter evaluates the fixed columns", "[domain][filter]") {
+    Fixture f;
+
+    CHECK(f.matches("CHROM==chr1", kPass));
+    CHECK_FALSE(f.matches("CHROM!=chr1", kPass));
+    CHECK(f.matches("CHROM in (chr2, chrX)", kLowQual));
+    CHECK_FALSE(f.matches("CHROM in (chr2, chrX)", kPass));
+    CHECK(f.matches("POS>=1500 && POS<1501", kPass));
+    CHECK(f.matches("REF==\"AT\" && ALT=='A'", kLowQual));
+    CHECK(f.matches("ALT in (C, G)", kPass));
+    CHECK(f.matches("FILTER==PASS", kPass));
+    CHECK(f.matches("FILTER=q10", kLowQual));
+    CHECK(f.matches("FILTER in (PASS, q10)", kLowQual));
+}
+
+TEST_CASE("RecordFilter treats missing values as failing every comparison", "[domain][filter]") {
+    Fixture f;
+
+    CHECK(f.matches("QUAL>45 && QUAL<=45.5", kPass));
+    CHECK_FALSE(f.matches("QUAL>=0", kLowQual));
+    CHECK_FALSE(f.matches("QUAL<0", kLowQual));
+    CHECK(f.matches("!(QUAL>=0)", kLowQual));
+    CHECK_FALSE(f.matches("INFO.AF>=0", kLowQual));   // "."
+    CHECK_FALSE(f.matches("INFO.AC>=0", kLowQual));   // Absent
+    CHECK_FALSE(f.matches("INFO.AF==\".\"", kLowQual));
+}
+
+TEST_CASE("RecordFilter evaluates INFO values", "[domain][filter]") {
+    Fixture f;
+
+    CHECK(f.matches("INFO.AF>0.01", kPass));
+    CHECK_FALSE(f.matches("INFO.AF>0.05", kPass));
+    CHECK(f.matches("INFO.AC>4", kPass));       // Any value of a list
+    CHECK_FALSE(f.matches("INFO.AC>5", kPass));
+    CHECK(f.matches("INFO.DB", kPass));         // Flag present
+    CHECK_FALSE(f.matches("INFO.DB", kLowQual));
+    CHECK(f.matches("INFO.AF", kLowQual));      // Present, even as "."
+    CHECK(f.matches("INFO.GENE==BRCA2", kPass));
+    CHECK(f.matches("INFO.GENE!=BRCA1", kPass));
+    CHECK(f.matches("INFO.GENE in (BRCA1, BRCA2)", kPass));
+    CHECK_FALSE(f.matches("INFO.UNDECLARED", kPass));
+}
+
+TEST_CASE("RecordFilter gives && precedence over ||", "[domain][filter]") {
+    Fixture f;
+
+    CHECK(f.matches("CHROM==chr2 || CHROM==chr1 && POS==1500", kPass));
+    CHECK_FALSE(f.matches("(CHROM==chr2 || CHROM==chr1) && POS==1", kPass));
+    CHECK(f.matches("!CHROM==chr2 && !!INFO.DB", kPass));
+}
+
+TEST_CASE("RecordFilter reports the position of an invalid expression", "[domain][filter]") {
+    Fixture f;
+
+    // Positions are 1-based columns of the expression
+    CHECK(f.error("FOO==1") == "Validation error: Filter: unknown field 'FOO' at position 1 in 'FOO==1'");
+    CHECK(f.error("QUAL>=") == "Validation error: Filter: expected a value at position 7 in 'QUAL>='");
+    CHECK(f.error("QUAL>=high") == "Validation error: Filter: 'QUAL' needs a number at position 7 in 'QUAL>=high'");
+    CHECK(f.error("CHROM<chr1") ==
+          "Validation error: Filter: 'CHROM' only supports == and != at position 6 in 'CHROM<chr1'");
+    CHECK(f.error("POS in (1,2)") ==
+          "Validation error: Filter: 'POS' does not support 'in' at position 1 in 'POS in (1,2)'");
+    CHECK(f.error("FILTER==\"PASS") ==
+          "Validation error: Filter: unterminated string at position 9 in 'FILTER==\"PASS'");
+    CHECK(f.error("QUAL>=30 )") == "Validation error: Filter: unexpected ')' at position 10 in 'QUAL>=30 )'");
+    CHECK(f.error("QUAL>=30 & POS>1") ==
+          "Validation error: Filter: unexpected '&' at position 10 in 'QUAL>=30 & POS>1'");
+    CHECK(f.error("(QUAL>=30") == "Validation error: Filter: expected ')' at position 10 in '(QUAL>=30'");
+    CHECK(f.error("QUAL") == "Validation error: Filter: expected a comparison after 'QUAL' at position 5 in 'QUAL'");
+    CHECK(f.error("") ==
+          "Validation error: Filter: expected a field (CHROM, POS, REF, ALT, QUAL, FILTER, INFO.<key>) "
+          "at position 1 in ''");
+}
@@ -0,0 +1,179 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <vcf_tool/core/Metrics.h>
+#include <vcf_tool/utils/Errors.h>
+
+#include "metrics/PipelineMetrics.h"
+#include "parser/ParseError.h"
+#include "parser/RejectLog.h"
+
+using namespace vcf_tool::domain;
+using parser::ParseError;
+using parser::RejectLog;
+using vcf_tool::core::metrics::MetricsRegistry;
+using vcf_tool::utils::errors::IOError;
+using vcf_tool::utils::errors::ParsingError;
+
+namespace {
+
+// Reject file in a fresh directory, removed with it, and the metrics it counts into
+class Fixture {
+public:
+    Fixture()
+        : dir_(std::filesystem::temp_directory_path() /
+               ("vcf_tool_rejects_" + std::to_string(std::random_device{}())))
+    {
+        std::filesystem::create_directories(dir_);
+    }
+
+    ~Fixture() { std::filesystem::remove_all(dir_); }
+
+    Fixture(const Fixture&) = delete;
+    Fixture& operator=(const Fixture&) = delete;
+
+    std::string path() const { return (dir_ / "input.vcf.rejects").string(); }
+
+    std::string contents() const
+    {
+        std::ifstream in(path());
+        std::stringstream text;
+        text << in.rdbuf();
+        return text.str();
+    }
+
+    MetricsRegistry registry;
+    metrics::PipelineMetrics metrics{registry};
+
+private:
+    std::filesystem::path dir_;
+};
+
+entity::RawLine line(std::uint64_t line_number, std::string text)
+{
+    return entity::RawLine{.line_number = line_number, .end_offset = 0, .text = std::move(text), .is_end = false};
+}
+
+ParseError columns(std::size_t found)
+{
+    return ParseError{.kind = ParseError::Kind::Columns, .columns = found, .value = {}};
+}
+
+ParseError position(std::string_view value)
+{
+    return ParseError{.kind = ParseError::Kind::Position, .columns = 8, .value = value};
+}
+
+} // namespace
+
+TEST_CASE("ParseError describes each kind", "[domain][rejects]") {
+    CHECK_FALSE(ParseError{});
+    CHECK(columns(3));
+
+    CHECK(ParseError::category(ParseError::Kind::Columns) == "columns");
+    CHECK(ParseError::category(ParseError::Kind::Position) == "position");
+    CHECK(columns(3).reason() == "Expected at least 8 fields, got 3");
+    CHECK(position("12a").reason() == "Invalid position '12a'");
+    CHECK(ParseError{}.reason().empty());
+}
+
+TEST_CASE("RejectLog writes one tab-separated row per rejected line", "[domain][rejects]") {
+    Fixture f;
+    {
+        RejectLog log(f.path(), 5, false, f.metrics);
+        log.reject(line(4, "chr1\t10\t."), columns(3));
+        log.reject(line(9, "chr1\tx\t.\tA\tC\t.\t.\t."), position("x"));
+        log.reject(line(11, "ignored"), ParseError{});  // Not an error: not recorded
+        CHECK(log.count() == 2);
+    }
+
+    CHECK(f.contents() ==
+          "#line\tcategory\treason\ttext\n"
+          "4\tcolumns\tExpected at least 8 fields, got 3\tchr1\t10\t.\n"
+          "9\tposition\tInvalid position 'x'\tchr1\tx\t.\tA\tC\t.\t.\t.\n");
+    CHECK(f.metrics.malformed_columns.value() == 1);
+    CHECK(f.metrics.malformed_position.value() == 1);
+}
+
+TEST_CASE("RejectLog fails the import past max_errors", "[domain][rejects]") {
+    Fixture f;
+
+    SECTION("rejected line max_errors + 1 throws, and is still written") {
+        RejectLog log(f.path(), 2, false, f.metrics);
+        log.reject(line(1, "a"), columns(1));
+        log.reject(line(2, "b"), columns(1));
+        CHECK_THROWS_AS(log.reject(line(3, "c"), columns(1)), ParsingError);
+        CHECK(log.count() == 3);
+        CHECK(f.contents().ends_with("3\tcolumns\tExpected at least 8 fields, got 1\tc\n"));
+    }
+
+    SECTION("max_errors 0 fails on the first one") {
+        RejectLog log({}, 0, false, f.metrics);
+        CHECK_THROWS_AS(log.reject(line(1, "a"), columns(1)), ParsingError);
+        CHECK_FALSE(std::filesystem::exists(f.path()));
+    }
+
+    SECTION("counted across threads") {
+        constexpr std::size_t kThreads = 8;
+        constexpr std::size_t kPerThread = 50;
+        RejectLog log(f.path(), kThreads * kPerThread - 1, false, f.metrics);
+        std::atomic<std::size_t> thrown{0};
+        {
+            std::vector<std::jthread> threads;
+            for (std::size_t t = 0; t < kThreads; ++t) {
+                threads.emplace_back([&, t] {
+                    for (std::size_t i = 0; i < kPerThread; ++i) {
+                        try {
+                            log.reject(line(t * kPerThread + i + 1, "x"), columns(1));
+                        } catch (const ParsingError&) {
+                            ++thrown;
+                        }
+                    }
+                });
+            }
+        }
+        CHECK(thrown == 1);
+        CHECK(log.count() == kThreads * kPerThread);
+        CHECK(f.metrics.malformed_columns.value() == kThreads * kPerThread);
+    }
+}
+
+TEST_CASE("RejectLog appends to the rows of a resumed run", "[domain][rejects]") {
+    Fixture f;
+    {
+        RejectLog log(f.path(), 5, false, f.metrics);
+        log.reject(line(4, "first run"), columns(2));
+    }
+    {
+        RejectLog log(f.path(), 5, true, f.metrics);
+        log.reject(line(8, "second run"), columns(2));
+    }
+    CHECK(f.contents() ==
+          "#line\tcategory\treason\ttext\n"
+          "4\tcolumns\tExpected at least 8 fields, got 2\tfirst run\n"
+          "8\tcolumns\tExpected at least 8 fields, got 2\tsecond run\n");
+
+    SECTION("a fresh run starts the file over") {
+        {
+            RejectLog log(f.path(), 5, false, f.metrics);
+        }
+        CHECK(f.contents() == "#line\tcategory\treason\ttext\n");
+    }
+}
+
+TEST_CASE("RejectLog refuses a reject file it cannot open", "[domain][rejects]") {
+    Fixture f;
+    CHECK_THROWS_AS(RejectLog(f.path() + "/missing/dir/rejects", 5, false, f.metrics), IOError);
+}
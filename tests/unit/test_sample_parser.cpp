@@ -0,0 +1,305 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <bit>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <vcf_tool/core/ThreadPool.h>
+
+#include "header/FieldProjection.h"
+#include "header/VcfDictionary.h"
+#include "header/VcfHeader.h"
+#include "memory/ChunkArena.h"
+#include "parser/SampleParser.h"
+
+using namespace vcf_tool::domain;
+using parser::SampleParser;
+
+namespace {
+
+constexpr std::string_view kHeader[] = {
+    "##fileformat=VCFv4.3",
+    "##FORMAT=<ID=GT,Number=1,Type=String,Description=\"Genotype\">",
+    "##FORMAT=<ID=DP,Number=1,Type=Integer,Description=\"Depth\">",
+    "##FORMAT=<ID=AD,Number=R,Type=Integer,Description=\"Allelic depths\">",
+    "##FORMAT=<ID=GL,Number=G,Type=Float,Description=\"Genotype likelihoods\">",
+    "##FORMAT=<ID=HQ,Number=.,Type=Integer,Description=\"Haplotype qualities\">",
+    "##FORMAT=<ID=FT,Number=1,Type=String,Description=\"Sample filter\">",
+    "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\tFORMAT\tS1\tS2",
+};
+
+constexpr std::uint8_t kEnd = kGtEnd;
+
+// GT byte of allele `allele` (-1 = missing)
+constexpr std::uint8_t gt(int allele, bool phased = false)
+{
+    return static_cast<std::uint8_t>(((allele + 1) << 1) | (phased ? 1 : 0));
+}
+
+// Parses sample columns with kHeader
+class Fixture {
+public:
+    Fixture()
+        : header_(make_header())
+        , dictionary_(header_)
+    {
+    }
+
+    GenotypeMatrix parse(std::string_view format, std::string_view samples, std::uint32_t alt_count = 1)
+    {
+        return parser_.parse(format, samples, alt_count, *arena_);
+    }
+
+    GenotypeMatrix parse_parallel(std::string_view format, std::string_view samples, std::uint32_t alt_count,
+                                  vcf_tool::core::ThreadPool& pool, std::size_t ranges)
+    {
+        return parser_.parse_parallel(format, samples, alt_count, *arena_, pool, ranges);
+    }
+
+    void project(const header::FieldProjection& fields) { parser_.project(fields); }
+
+    // Column of `key` (nullptr if the matrix has none)
+    const FormatColumn* column(const GenotypeMatrix& matrix, std::string_view key) const
+    {
+        for (const auto& column : matrix.columns) {
+            if (dictionary_.format_keys.resolve(column.key) == key) {
+                return &column;
+            }
+        }
+        return nullptr;
+    }
+
+    // Everything in the matrix as text (floats as bits: the sentinels are NaNs)
+    std::string dump(const GenotypeMatrix& matrix) const
+    {
+        std::string out = std::to_string(matrix.sample_count) + " x " + std::to_string(matrix.ploidy) + " GT:";
+        for (auto byte : matrix.genotypes) {
+            out += " " + std::to_string(byte);
+        }
+        for (const auto& column : matrix.columns) {
+            out += "\n" + std::string(dictionary_.format_keys.resolve(column.key)) + " type "
+                + std::to_string(static_cast<int>(column.type)) + " width " + std::to_string(column.width) + ":";
+            for (auto value : column.integers) {
+                out += " " + std::to_string(value);
+            }
+            for (auto value : column.floats) {
+                out += " " + std::to_string(std::bit_cast<std::uint32_t>(value));
+            }
+            for (auto value : column.strings) {
+                out += " '" + std::string(value) + "'";
+            }
+        }
+        return out;
+    }
+
+private:
+    static header::VcfHeader make_header()
+    {
+        header::VcfHeader header;
+        for (auto line : kHeader) {
+            header.parse_line(line);
+        }
+        return header;
+    }
+
+    header::VcfHeader header_;
+    header::VcfDictionary dictionary_;
+    SampleParser parser_{dictionary_};
+    memory::ArenaRef arena_ = memory::ChunkArena::create();
+};
+
+std::vector<std::uint8_t> genotypes(const GenotypeMatrix& matrix)
+{
+    return {matrix.genotypes.begin(), matrix.genotypes.end()};
+}
+
+std::vector<std::int32_t> integers(const FormatColumn* column)
+{
+    REQUIRE(column != nullptr);
+    return {column->integers.begin(), column->integers.end()};
+}
+
+std::vector<std::uint32_t> float_bits(const FormatColumn* column)
+{
+    REQUIRE(column != nullptr);
+    std::vector<std::uint32_t> bits;
+    for (float value : column->floats) {
+        bits.push_back(std::bit_cast<std::uint32_t>(value));
+    }
+    return bits;
+}
+
+std::vector<std::string_view> strings(const FormatColumn* column)
+{
+    REQUIRE(column != nullptr);
+    return {column->strings.begin(), column->strings.end()};
+}
+
+} // namespace
+
+TEST_CASE("SampleParser encodes GT as one byte per allele", "[domain][samples]") {
+    Fixture f;
+
+    SECTION("alleles, phasing and missing alleles") {
+        const auto matrix = f.parse("GT", "0/1\t1|2\t./.\t.|1\t|0|1");
+        CHECK(matrix.sample_count == 5);
+        CHECK(matrix.ploidy == 2);
+        CHECK(matrix.columns.empty());
+        CHECK(genotypes(matrix) == std::vector<std::uint8_t>{
+                  gt(0), gt(1),
+                  gt(1), gt(2, true),
+                  gt(-1), gt(-1),
+                  gt(-1), gt(1, true),
+                  gt(0, true), gt(1, true)});
+    }
+
+    SECTION("lower ploidy is padded") {
+        const auto matrix = f.parse("GT", "0/1\t1\t.");
+        CHECK(matrix.ploidy == 2);
+        CHECK(genotypes(matrix) == std::vector<std::uint8_t>{gt(0), gt(1), gt(1), kEnd, gt(-1), kEnd});
+    }
+
+    SECTION("a sample with more alleles than the first re-encodes the column") {
+        const auto matrix = f.parse("GT", "0/1\t0/1/2\t1");
+        CHECK(matrix.ploidy == 3);
+        CHECK(genotypes(matrix) == std::vector<std::uint8_t>{
+                  gt(0), gt(1), kEnd,
+                  gt(0), gt(1), gt(2),
+                  gt(1), kEnd, kEnd});
+    }
+
+    SECTION("alleles that don't fit a byte keep GT as text") {
+        const auto matrix = f.parse("GT:DP", "0/1:5\t0/63:6\t./.:.");
+        CHECK(matrix.ploidy == 0);
+        CHECK(matrix.genotypes.empty());
+        CHECK(strings(f.column(matrix, "GT")) == std::vector<std::string_view>{"0/1", "0/63", "./."});
+        CHECK(integers(f.column(matrix, "DP")) == std::vector<std::int32_t>{5, 6, kMissingInt});
+    }
+
+    SECTION("malformed GT keeps GT as text") {
+        const auto matrix = f.parse("GT", "0/1\t0-1");
+        CHECK(matrix.ploidy == 0);
+        CHECK(strings(f.column(matrix, "GT")) == std::vector<std::string_view>{"0/1", "0-1"});
+    }
+}
+
+TEST_CASE("SampleParser pads shorter vectors and missing values", "[domain][samples]") {
+    Fixture f;
+
+    // Two ALTs: AD has 3 values (Number=R), GL 6 (Number=G, diploid)
+    const auto matrix = f.parse("GT:DP:AD:GL:FT",
+                                "0/1:7:1,2,3:-1,-2,-3,-4,-5,-6:PASS\t"
+                                "1/2:.:4,5:.:.\t"
+                                "./.",
+                                2);
+    CHECK(matrix.sample_count == 3);
+    CHECK(integers(f.column(matrix, "DP")) == std::vector<std::int32_t>{7, kMissingInt, kMissingInt});
+
+    const auto* ad = f.column(matrix, "AD");
+    REQUIRE(ad != nullptr);
+    CHECK(ad->width == 3);
+    CHECK(integers(ad) == std::vector<std::int32_t>{
+              1, 2, 3,
+              4, 5, kEndInt,
+              kMissingInt, kEndInt, kEndInt});  // Trailing keys dropped from the sample
+
+    const auto* gl = f.column(matrix, "GL");
+    REQUIRE(gl != nullptr);
+    CHECK(gl->type == FormatColumn::Type::Float);
+    CHECK(gl->width == 6);
+    const auto bits = float_bits(gl);
+    CHECK(bits[0] == std::bit_cast<std::uint32_t>(-1.0f));
+    CHECK(bits[5] == std::bit_cast<std::uint32_t>(-6.0f));
+    CHECK(bits[6] == kMissingFloatBits);
+    for (std::size_t i : {7u, 8u, 9u, 10u, 11u, 13u, 14u, 15u, 16u, 17u}) {
+        CHECK(bits[i] == kEndFloatBits);
+    }
+    CHECK(bits[12] == kMissingFloatBits);
+
+    CHECK(strings(f.column(matrix, "FT")) == std::vector<std::string_view>{"PASS", "", ""});
+}
+
+TEST_CASE("SampleParser re-plans a column the first sample did not size", "[domain][samples]") {
+    Fixture f;
+
+    SECTION("a wider Number=. vector widens the column") {
+        const auto matrix = f.parse("GT:HQ", "0/1:10\t0/1:1,2,3\t0/0:.,4");
+        const auto* hq = f.column(matrix, "HQ");
+        REQUIRE(hq != nullptr);
+        CHECK(hq->type == FormatColumn::Type::Integer);
+        CHECK(hq->width == 3);
+        CHECK(integers(hq) == std::vector<std::int32_t>{
+                  10, kEndInt, kEndInt,
+                  1, 2, 3,
+                  kMissingInt, 4, kEndInt});
+    }
+
+    SECTION("a value of another type turns the column into text") {
+        const auto matrix = f.parse("GT:DP:AD", "0/1:5:1,2\t0/1:high:3,x\t0/1:-2147483647:.");
+        CHECK(strings(f.column(matrix, "DP")) == std::vector<std::string_view>{"5", "high", "-2147483647"});
+        CHECK(strings(f.column(matrix, "AD")) == std::vector<std::string_view>{"1,2", "3,x", ""});
+        CHECK(genotypes(matrix).size() == 6);
+    }
+
+    SECTION("an undeclared key is text") {
+        const auto matrix = f.parse("GT:XX", "0/1:12\t1/1:3,4");
+        CHECK(strings(f.column(matrix, "XX")) == std::vector<std::string_view>{"12", "3,4"});
+    }
+}
+
+TEST_CASE("SampleParser drops the FORMAT keys the projection drops", "[domain][samples]") {
+    Fixture f;
+    const auto fields = header::FieldProjection::parse("GT,AD");
+    f.project(fields);
+
+    const auto matrix = f.parse("GT:DP:AD:FT", "0/1:7:1,2:PASS\t1/1:8:3,4:q10");
+    CHECK(matrix.ploidy == 2);
+    REQUIRE(matrix.columns.size() == 1);
+    CHECK(integers(f.column(matrix, "AD")) == std::vector<std::int32_t>{1, 2, 3, 4});
+    CHECK(f.column(matrix, "DP") == nullptr);
+    CHECK(f.column(matrix, "FT") == nullptr);
+}
+
+TEST_CASE("SampleParser::parse_parallel matches parse", "[domain][samples]") {
+    Fixture f;
+    vcf_tool::core::ThreadPool pool(3);
+    std::mt19937 rng(11);
+
+    // Samples with every re-planning trigger: higher ploidy, wider HQ,
+    // untyped DP, missing and dropped trailing keys
+    auto sample = [&] {
+        std::string text;
+        switch (rng() % 4) {
+            case 0: text = "0/1"; break;
+            case 1: text = "1|0"; break;
+            case 2: text = "./."; break;
+            default: text = rng() % 20 == 0 ? "0/1/1" : "1"; break;
+        }
+        if (rng() % 10 == 0) {
+            return text;
+        }
+        text += ":" + (rng() % 50 == 0 ? std::string("n/a") : std::to_string(rng() % 100));
+        text += ":" + std::to_string(rng() % 30) + "," + std::to_string(rng() % 30);
+        text += ":" + std::to_string(rng() % 60);
+        for (std::size_t extra = rng() % 8 == 0 ? 1 + rng() % 3 : 0; extra > 0; --extra) {
+            text += "," + std::to_string(rng() % 60);
+        }
+        return text;
+    };
+
+    for (std::size_t sample_count : {1u, 2u, 7u, 500u}) {
+        std::string samples;
+        for (std::size_t i = 0; i < sample_count; ++i) {
+            samples += (i == 0 ? "" : "\t") + sample();
+        }
+        const std::string expected = f.dump(f.parse("GT:DP:AD:HQ", samples));
+
+        for (std::size_t ranges : {1u, 2u, 3u, 8u, 64u}) {
+            INFO(sample_count << " samples, " << ranges << " ranges");
+            CHECK(f.dump(f.parse_parallel("GT:DP:AD:HQ", samples, 1, pool, ranges)) == expected);
+        }
+    }
+}
@@ -0,0 +1,137 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "memory/ChunkArena.h"
+#include "parser/SampleSelector.h"
+
+using namespace vcf_tool::domain;
+using parser::SampleSelector;
+using parser::skip_tabs;
+
+namespace {
+
+// Byte-at-a-time skip_tabs: offset just past the n-th tab, -1 if there are fewer
+long reference_skip(std::string_view text, std::size_t n)
+{
+    if (n == 0) {
+        return 0;
+    }
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '\t' && --n == 0) {
+            return static_cast<long>(i + 1);
+        }
+    }
+    return -1;
+}
+
+long simd_skip(std::string_view text, std::size_t n)
+{
+    const char* p = skip_tabs(text.data(), text.data() + text.size(), n);
+    return p ? static_cast<long>(p - text.data()) : -1;
+}
+
+// Every n from 0 to one past the number of tabs
+void check_all_counts(const std::string& text)
+{
+    std::size_t tabs = 0;
+    for (char c : text) {
+        tabs += c == '\t' ? 1 : 0;
+    }
+    for (std::size_t n = 0; n <= tabs + 1; ++n) {
+        INFO("text size " << text.size() << ", n = " << n);
+        CHECK(simd_skip(text, n) == reference_skip(text, n));
+    }
+}
+
+constexpr std::string_view kFixed = "chr1\t100\t.\tA\tG\t50\tPASS\t.\tGT";
+
+std::string select(std::string_view line, std::vector<std::uint32_t> columns)
+{
+    const SampleSelector selector(9, columns);
+    auto arena = memory::ChunkArena::create();
+    return std::string(selector.copy(line, *arena));
+}
+
+} // namespace
+
+TEST_CASE("skip_tabs matches a scalar scan", "[domain][samples]") {
+    SECTION("n = 1, 16 and 17 around one block of tabs") {
+        for (std::size_t length : {15u, 16u, 17u, 31u, 32u, 33u}) {
+            const std::string text(length, '\t');
+            for (std::size_t n : {1u, 16u, 17u}) {
+                INFO("length " << length << ", n = " << n);
+                CHECK(simd_skip(text, n) == reference_skip(text, n));
+            }
+        }
+    }
+
+    SECTION("tabs on block boundaries") {
+        // Last byte of a block, first of the next, and the end of the buffer
+        for (std::size_t length : {16u, 32u, 48u, 49u}) {
+            std::string text(length, 'x');
+            for (std::size_t at : {0u, 14u, 15u, 16u, 31u, 32u, 47u}) {
+                if (at < length) {
+                    text[at] = '\t';
+                }
+            }
+            text.back() = '\t';
+            check_all_counts(text);
+        }
+    }
+
+    SECTION("no tabs, empty input and a tail shorter than a block") {
+        CHECK(simd_skip("", 0) == 0);
+        CHECK(simd_skip("", 1) == -1);
+        check_all_counts(std::string(40, 'x'));
+        check_all_counts("a\tb\tc");
+    }
+
+    SECTION("random lines") {
+        std::mt19937 rng(7);
+        for (int round = 0; round < 200; ++round) {
+            std::string text(rng() % 100, 'x');
+            const auto density = 1 + rng() % 8;  // About one byte in `density` is a tab
+            for (char& c : text) {
+                if (rng() % density == 0) {
+                    c = '\t';
+                }
+            }
+            check_all_counts(text);
+        }
+    }
+}
+
+TEST_CASE("SampleSelector copies the fixed columns and the selected samples", "[domain][samples]") {
+    const std::string line = std::string(kFixed) + "\t0/0\t0/1\t1/1\t./.";
+
+    CHECK(select(line, {0, 2}) == std::string(kFixed) + "\t0/0\t1/1");
+    CHECK(select(line, {3}) == std::string(kFixed) + "\t./.");
+    CHECK(select(line, {0, 1, 2, 3}) == line);
+}
+
+TEST_CASE("SampleSelector fills the samples a short line lacks with '.'", "[domain][samples]") {
+    const std::string line = std::string(kFixed) + "\t0/0\t0/1";
+
+    CHECK(select(line, {1, 3}) == std::string(kFixed) + "\t0/1\t.");
+    CHECK(select(line, {2, 3}) == std::string(kFixed) + "\t.\t.");
+    CHECK(select(line, {0, 1, 2}) == std::string(kFixed) + "\t0/0\t0/1\t.");
+    // FORMAT with no sample column at all
+    CHECK(select(kFixed, {0}) == kFixed);
+}
+
+TEST_CASE("SampleSelector with an empty selection keeps the fixed columns only", "[domain][samples]") {
+    const std::string line = std::string(kFixed) + "\t0/0\t0/1";
+
+    CHECK(select(line, {}) == kFixed);
+    CHECK(select(std::string(kFixed) + "\t", {}) == kFixed);
+
+    // Sites-only lines (no FORMAT) are copied as they are
+    const std::string sites = "chr1\t100\t.\tA\tG\t50\tPASS\tDP=3";
+    CHECK(select(sites, {}) == sites);
+    CHECK(select(sites, {0, 1}) == sites);
+}
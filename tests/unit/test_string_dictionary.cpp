@@ -0,0 +1,117 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "header/StringDictionary.h"
+
+using namespace vcf_tool::domain;
+using header::StringDictionary;
+
+namespace {
+
+std::string key(std::size_t i)
+{
+    return "key" + std::to_string(i);
+}
+
+} // namespace
+
+TEST_CASE("StringDictionary assigns dense IDs in insertion order", "[domain][dictionary]") {
+    StringDictionary dictionary;
+
+    CHECK(dictionary.intern("chr1") == 0);
+    CHECK(dictionary.intern("chr2") == 1);
+    CHECK(dictionary.intern("") == 2);
+    CHECK(dictionary.intern("chr1") == 0);
+    CHECK(dictionary.size() == 3);
+
+    CHECK(dictionary.find("chr2") == std::optional<StringId>(1));
+    CHECK(dictionary.find("") == std::optional<StringId>(2));
+    CHECK_FALSE(dictionary.find("chr3").has_value());
+    CHECK(dictionary.size() == 3);
+
+    CHECK(dictionary.resolve(0) == "chr1");
+    CHECK(dictionary.resolve(2).empty());
+
+    SECTION("the dictionary owns its copy of each string") {
+        std::string text = "PASS";
+        const auto id = dictionary.intern(text);
+        text = "q10!";
+        CHECK(dictionary.resolve(id) == "PASS");
+    }
+}
+
+TEST_CASE("StringDictionary keeps IDs and views across growth", "[domain][dictionary]") {
+    StringDictionary dictionary(1);
+
+    // Past several table doublings and more than one ID block
+    constexpr std::size_t kCount = 3 * StringDictionary::kBlockSize + 7;
+    std::vector<std::string_view> views;
+    for (std::size_t i = 0; i < kCount; ++i) {
+        REQUIRE(dictionary.intern(key(i)) == i);
+        views.push_back(dictionary.resolve(static_cast<StringId>(i)));
+    }
+    CHECK(dictionary.size() == kCount);
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+        const auto id = static_cast<StringId>(i);
+        REQUIRE(dictionary.find(key(i)) == std::optional<StringId>(id));
+        REQUIRE(dictionary.intern(key(i)) == id);
+        // Same bytes, not just an equal string: views handed out earlier stay valid
+        REQUIRE(dictionary.resolve(id).data() == views[i].data());
+        REQUIRE(views[i] == key(i));
+    }
+    CHECK_FALSE(dictionary.find(key(kCount)).has_value());
+}
+
+TEST_CASE("StringDictionary interns concurrently without duplicate IDs", "[domain][dictionary]") {
+    StringDictionary dictionary;
+    constexpr std::size_t kThreads = 8;
+    constexpr std::size_t kKeys = 5000;
+
+    // Every thread interns every key, each in its own order, while growth happens
+    std::vector<std::vector<StringId>> ids(kThreads, std::vector<StringId>(kKeys));
+    std::atomic<bool> mismatch{false};
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&, t] {
+                std::vector<std::size_t> order(kKeys);
+                for (std::size_t i = 0; i < kKeys; ++i) {
+                    order[i] = i;
+                }
+                std::shuffle(order.begin(), order.end(), std::mt19937(static_cast<unsigned>(t)));
+                for (std::size_t i : order) {
+                    const auto id = dictionary.intern(key(i));
+                    ids[t][i] = id;
+                    // Readers resolve their own IDs while other threads insert
+                    if (dictionary.resolve(id) != key(i)) {
+                        mismatch = true;
+                    }
+                }
+            });
+        }
+    }
+
+    CHECK_FALSE(mismatch);
+    CHECK(dictionary.size() == kKeys);
+    for (std::size_t t = 1; t < kThreads; ++t) {
+        REQUIRE(ids[t] == ids[0]);
+    }
+
+    // IDs are exactly 0 .. kKeys - 1
+    auto sorted = ids[0];
+    std::sort(sorted.begin(), sorted.end());
+    for (std::size_t i = 0; i < kKeys; ++i) {
+        REQUIRE(sorted[i] == i);
+        REQUIRE(dictionary.resolve(ids[0][i]) == key(i));
+    }
+}